@@ -0,0 +1,118 @@
+/*
+ * arena.c
+ *
+ * Contains functions to interface with a bump arena, which hands out the memory
+ * of a single file from large blocks.
+ * Nothing in the arena is freed on its own. Instead, all of it is taken back at
+ * once when the file is done, and the blocks are kept for the next files, so
+ * that compiling many files stops allocating memory after the first ones.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "arena.h"
+
+#include <stdlib.h> /* free. */
+
+#include "globals.h" /* Constants and typedefs. */
+#include "utils.h"   /* Allocating memory. */
+
+void initArena(Arena *arena) {
+    /* The arena starts with no blocks at all. */
+    arena->first = NULL;
+    arena->current = NULL;
+}
+
+void *allocateFromArena(Arena *arena, size_t size) {
+    ArenaBlock *next; /* The block to move on to. */
+    char *pointer;    /* The pointer to the allocated memory. */
+
+    /* Keep the memory after this one aligned as well. */
+    size = alignSize(size);
+
+    /* Check if the current block does not have room for the memory. */
+    if (arena->current == NULL ||
+        arena->current->used + size > arena->current->capacity) {
+        /* Try moving on to the next kept block. */
+        next = arena->current == NULL ? arena->first : arena->current->next;
+
+        /* Add a new block if there is no kept block with enough room. */
+        if (next == NULL || next->capacity < size) {
+            next = addArenaBlock(arena, size);
+        }
+
+        /* Start handing out the next block from its beginning. */
+        next->used = EMPTY;
+        arena->current = next;
+    }
+
+    /* Hand out the memory right after what has been handed out so far. */
+    pointer = getBlockBytes(arena->current) + arena->current->used;
+    arena->current->used += size;
+
+    /* Return the pointer to the allocated memory. */
+    return pointer;
+}
+
+ArenaBlock *addArenaBlock(Arena *arena, size_t size) {
+    ArenaBlock *newBlock; /* The new block. */
+    size_t capacity;      /* The number of bytes the new block can hand out. */
+
+    /* Use the default size, unless the memory does not fit in it. */
+    capacity = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+
+    /* Allocate enough memory for the header and the bytes together. */
+    newBlock = allocate(alignSize(sizeof(ArenaBlock)) + capacity);
+    newBlock->capacity = capacity;
+    newBlock->used = EMPTY;
+
+    /* Link the new block right after the current one, keeping the rest. */
+    if (arena->current == NULL) {
+        newBlock->next = arena->first;
+        arena->first = newBlock;
+    } else {
+        newBlock->next = arena->current->next;
+        arena->current->next = newBlock;
+    }
+
+    return newBlock;
+}
+
+char *getBlockBytes(ArenaBlock *block) {
+    /* The bytes start at the first aligned address after the header. */
+    return (char *)block + alignSize(sizeof(ArenaBlock));
+}
+
+size_t alignSize(size_t size) {
+    /* Round up to the next multiple of the strictest alignment. */
+    return (size + sizeof(MaxAlignment) - LAST_INDEX_DIFF) /
+           sizeof(MaxAlignment) * sizeof(MaxAlignment);
+}
+
+void resetArena(Arena *arena) {
+    /* Start handing out the first block again (the rest are reset later). */
+    arena->current = arena->first;
+    if (arena->first != NULL) {
+        arena->first->used = EMPTY;
+    }
+}
+
+void freeArena(Arena *arena) {
+    ArenaBlock *next; /* The next block. */
+
+    /* Loop over the blocks and free each one. */
+    while (arena->first != NULL) {
+        /* Store the next block. */
+        next = arena->first->next;
+        /* Free the current block. */
+        free(arena->first);
+        /* Move on to the next block. */
+        arena->first = next;
+    }
+
+    /* Leave the arena empty. */
+    initArena(arena);
+}
@@ -0,0 +1,96 @@
+/*
+ * arena.h
+ *
+ * Contains the function prototypes for the functions in arena.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Initializes the given arena to be empty.
+ * Does not allocate any memory until the first allocation.
+ *
+ * Assumes that the given arena pointer is not NULL.
+ *
+ * @param arena The arena to initialize.
+ */
+void initArena(Arena *arena);
+
+/**
+ * Hands out the given number of bytes from the given arena, aligned for any
+ * type.
+ * Only allocates a new block if none of the kept blocks has room for them.
+ * IMPORTANT: The memory must not be freed on its own. It is taken back when the
+ * arena is reset or freed.
+ *
+ * Assumes that the given arena pointer is not NULL.
+ *
+ * @param arena The arena to allocate from.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory.
+ */
+void *allocateFromArena(Arena *arena, size_t size);
+
+/**
+ * Allocates a new block that can hand out at least the given number of bytes,
+ * and links it right after the current block of the given arena (or first, if
+ * the arena has no blocks).
+ *
+ * Assumes that the given arena pointer is not NULL.
+ *
+ * @param arena The arena to add the block to.
+ * @param size The number of bytes the block must be able to hand out.
+ * @return The new block.
+ */
+ArenaBlock *addArenaBlock(Arena *arena, size_t size);
+
+/**
+ * Returns the first byte that the given block can hand out, which comes right
+ * after the block's header.
+ *
+ * Assumes that the given block pointer is not NULL.
+ *
+ * @param block The block.
+ * @return The first byte of the block.
+ */
+char *getBlockBytes(ArenaBlock *block);
+
+/**
+ * Rounds the given number of bytes up, so that memory handed out right after
+ * them is aligned for any type.
+ *
+ * @param size The number of bytes to round up.
+ * @return The rounded number of bytes.
+ */
+size_t alignSize(size_t size);
+
+/**
+ * Takes back all the memory handed out by the given arena at once, without
+ * freeing its blocks, so that the next allocations reuse them.
+ * Takes the same time no matter how much memory has been handed out.
+ *
+ * Assumes that the given arena pointer is not NULL.
+ *
+ * @param arena The arena to reset.
+ */
+void resetArena(Arena *arena);
+
+/**
+ * Frees all the blocks of the given arena.
+ * Leaves the given arena empty, so that it can be used again.
+ *
+ * Assumes that the given arena pointer is not NULL.
+ *
+ * @param arena The arena to free.
+ */
+void freeArena(Arena *arena);
+
+#endif
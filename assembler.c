@@ -11,11 +11,17 @@
 
 #include "errorHandling.h" /* Getting the error status. */
 #include "fileHandling.h" /* Handling the files in the command line arguments. */
-#include "globals.h"      /* Constants. */
+#include "globals.h"      /* Constants and typedefs. */
+#include "optionHandling.h" /* Reading the options before the file names. */
 
 /**
  * The main function which executes the program.
- * Expects file names to be given as command line arguments.
+ * Expects file names to be given as command line arguments, optionally after
+ * the -j <number of jobs> option, to compile that many files at the same time,
+ * the --no-am option, to skip writing the macro-expanded .am files, the
+ * --time-report option, to print how long each phase of each file took to
+ * stderr, and the --cache <directory> option, to restore the outputs of
+ * unchanged files from the given directory.
  * Uses these names to read the .as source files.
  * Compiles them and generates the following files (if successful):
  * - .ob: Contains the words that need to be loaded into memory in octal
@@ -30,10 +36,17 @@
  * @return The exit status of the program (0 - successful, 1 - failed).
  */
 int main(int argc, char *argv[]) {
+    Options options; /* The options given before the file names. */
+    int optionCount; /* The number of arguments read as options. */
+
+    /* Read the options, which come before the file names. */
+    optionCount = handleOptions(argv + ARGS_DIFF, argc - ARGS_DIFF, &options);
+
     /* Check the possibility of no files being provided. */
-    handleNoFiles(argc - ARGS_DIFF);
+    handleNoFiles(argc - ARGS_DIFF - optionCount);
     /* Start the compilation process of every file provided. */
-    compileAllFiles(argv + ARGS_DIFF, argc - ARGS_DIFF);
+    compileAllFiles(argv + ARGS_DIFF + optionCount,
+                    argc - ARGS_DIFF - optionCount, &options);
 
     /* Return 1 if any errors occurred, otherwise 0. */
     return getErrorStatus() ? ERROR : SUCCESS;
@@ -0,0 +1,374 @@
+/*
+ * chunkedReading.c
+ *
+ * Contains functions to parse the expanded lines of a single large file on
+ * several threads at the same time.
+ * The lines are split into ranges, and each range is parsed as if it were a
+ * file of its own, so its words, addresses and line numbers start from 0.
+ * Once every range is parsed, the words before each range are summed up, and
+ * its words, labels and messages are moved after the ranges before it.
+ * A range depends on the ranges before it only through the labels they define
+ * and declare and through the number of words, so whenever these could have
+ * changed how a range was parsed, the file is simply read again in one pass.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "chunkedReading.h"
+
+#include <pthread.h> /* pthread_create, pthread_join. */
+#include <stdlib.h>  /* free. */
+#include <string.h>  /* memchr, memcpy. */
+
+#include "arena.h"         /* Preparing and freeing the arena of each range. */
+#include "errorHandling.h" /* Keeping the messages of each range aside. */
+#include "fileReading.h"   /* Parsing the lines of each range. */
+#include "freeingLogic.h"  /* Registering the memory of each thread. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "symbolTable.h"   /* Finding labels that are in more than one range. */
+#include "utils.h"         /* Allocating the ranges. */
+#include "wordImage.h"     /* Starting both parts of each range with no words. */
+
+Boolean readFileInChunks(char fileName[], TextBuffer *expanded,
+                         MacroTable *macros, WordImage *code, WordImage *data,
+                         Label **entryLabels, Label **externLabels,
+                         UsedLabel **usedLabels, FoundLabel **foundLabels,
+                         WordCount *instructionCount, WordCount *dataCount,
+                         unsigned int jobCount, ChunkedReading *chunked) {
+    unsigned int index;   /* The index of the current range. */
+    unsigned int started; /* The number of threads that have been started. */
+
+    /* Give each thread at least a minimal share of the text. */
+    chunked->chunks = NULL;
+    chunked->count = expanded->length / CHUNK_MIN_SIZE < jobCount
+                         ? (unsigned int)(expanded->length / CHUNK_MIN_SIZE)
+                         : jobCount;
+
+    /* Read the text on this thread if it is too small to split. */
+    if (chunked->count <= DEFAULT_JOB_COUNT) {
+        chunked->count = EMPTY;
+        return readFile(fileName, expanded, macros, code, data, entryLabels,
+                        externLabels, usedLabels, foundLabels,
+                        instructionCount, dataCount);
+    }
+
+    /* Split the lines into ranges. */
+    chunked->chunks = allocate(sizeof(ParsingChunk) * chunked->count);
+    splitIntoChunks(expanded, chunked, fileName, macros);
+
+    /* Start a thread for each range, while the system allows it. */
+    for (started = INITIAL_VALUE; started < chunked->count; started++) {
+        if (pthread_create(&chunked->chunks[started].thread, NULL,
+                           runParsingChunk,
+                           &chunked->chunks[started]) != SUCCESS) {
+            break;
+        }
+    }
+
+    /* Wait for all the threads that have been started. */
+    for (index = INITIAL_VALUE; index < started; index++) {
+        pthread_join(chunked->chunks[index].thread, NULL);
+    }
+
+    /* Check if every range has been parsed the way one pass would parse it. */
+    if (started == chunked->count && canMergeChunks(chunked)) {
+        mergeChunks(chunked, code, data, entryLabels, externLabels,
+                    usedLabels, foundLabels, instructionCount, dataCount);
+
+        /* Only the first range may have found errors. */
+        return chunked->chunks[FIRST_INDEX].isSuccessful;
+    }
+
+    /* Read the text again in one pass, without the messages of the ranges. */
+    discardChunkMessages(chunked);
+    return readFile(fileName, expanded, macros, code, data, entryLabels,
+                    externLabels, usedLabels, foundLabels, instructionCount,
+                    dataCount);
+}
+
+void splitIntoChunks(TextBuffer *expanded, ChunkedReading *chunked,
+                     char fileName[], MacroTable *macros) {
+    ParsingChunk *chunk; /* The current range. */
+    unsigned int index;  /* The index of the current range. */
+    size_t start;        /* The offset of the range's first character. */
+    size_t end;          /* The offset after the range's last character. */
+    LineNumber lines;    /* The number of lines before the current range. */
+    char *newline;       /* The newline character that ends the range. */
+
+    start = INITIAL_VALUE;
+    lines = INITIAL_VALUE;
+
+    for (index = INITIAL_VALUE; index < chunked->count; index++) {
+        chunk = &chunked->chunks[index];
+
+        /* End the range at the end of the line that its share ends in. */
+        end = expanded->length / chunked->count * (index + SINGLE_ENTRY);
+        if (end < start) {
+            end = start;
+        }
+        newline = index == chunked->count - LAST_INDEX_DIFF
+                      ? NULL
+                      : memchr(&expanded->text[end], '\n',
+                               expanded->length - end);
+        end = newline == NULL ? expanded->length
+                              : (size_t)(newline - expanded->text) +
+                                    SINGLE_ENTRY;
+
+        /* The range reads its lines straight out of the expanded text. */
+        chunk->text.text = &expanded->text[start];
+        chunk->text.length = end - start;
+        chunk->text.capacity = end - start;
+        chunk->text.position = INITIAL_VALUE;
+        chunk->firstLine = lines;
+
+        /* Start the range with no words, no labels and no messages. */
+        chunk->fileName = fileName;
+        chunk->macros = macros;
+        initWordImage(&chunk->code);
+        initWordImage(&chunk->data);
+        chunk->entryLabels = NULL;
+        chunk->externLabels = NULL;
+        chunk->usedLabels = NULL;
+        chunk->foundLabels = NULL;
+        chunk->instructionCount = INITIAL_VALUE;
+        chunk->dataCount = INITIAL_VALUE;
+        chunk->isSuccessful = FALSE;
+        chunk->messages.first = NULL;
+        chunk->messages.last = NULL;
+        initArena(&chunk->toFree.arena);
+
+        /* Count the lines of the range, for the ranges after it. */
+        while (start < end) {
+            newline = memchr(&expanded->text[start], '\n', end - start);
+            start = newline == NULL ? end
+                                    : (size_t)(newline - expanded->text) +
+                                          SINGLE_ENTRY;
+            lines++;
+        }
+    }
+}
+
+void *runParsingChunk(void *parsingChunk) {
+    ParsingChunk *chunk; /* The range of this thread. */
+
+    chunk = parsingChunk;
+
+    /* Keep a separate arena, as the lists belong to this thread. */
+    registerToFree(&chunk->toFree);
+    /* Store the messages, as they are printed in the order of the ranges. */
+    queueMessages(&chunk->messages);
+
+    /* Parse the lines of the range. */
+    chunk->isSuccessful = readLines(
+        chunk->fileName, &chunk->text, NULL, chunk->macros, &chunk->code,
+        &chunk->data, &chunk->entryLabels, &chunk->externLabels,
+        &chunk->usedLabels, &chunk->foundLabels, &chunk->instructionCount,
+        &chunk->dataCount);
+
+    return NULL;
+}
+
+Boolean canMergeChunks(ChunkedReading *chunked) {
+    SymbolTable definitions; /* The names of the found labels so far. */
+    SymbolTable entries;     /* The names of the entry labels so far. */
+    SymbolTable externs;     /* The names of the extern labels so far. */
+    unsigned long total;     /* The number of words in all the ranges. */
+    ParsingChunk *chunk;     /* The current range. */
+    unsigned int index;      /* The index of the current range. */
+
+    /* Check if the words fit in memory, so that no line overflowed it. */
+    total = EMPTY;
+    for (index = INITIAL_VALUE; index < chunked->count; index++) {
+        total += chunked->chunks[index].instructionCount;
+        total += chunked->chunks[index].dataCount;
+    }
+    if (total > TOTAL_MEMORY_CELLS - STARTING_MEMORY_ADDRESS) {
+        return FALSE;
+    }
+
+    initSymbolTable(&definitions);
+    initSymbolTable(&entries);
+    initSymbolTable(&externs);
+
+    for (index = INITIAL_VALUE; index < chunked->count; index++) {
+        chunk = &chunked->chunks[index];
+
+        /* An error after the first range might depend on the ranges before. */
+        if (index != FIRST_INDEX && !chunk->isSuccessful) {
+            return FALSE;
+        }
+
+        /* Check if a label already appeared in the ranges before. */
+        if (!addFoundLabelNames(&definitions, chunk->foundLabels) ||
+            !addLabelNames(&entries, chunk->entryLabels) ||
+            !addLabelNames(&externs, chunk->externLabels)) {
+            return FALSE;
+        }
+    }
+
+    /* Every range has been parsed exactly as in one pass. */
+    return TRUE;
+}
+
+Boolean addLabelNames(SymbolTable *names, Label *labels) {
+    /* Add the name of each label, unless it is already there. */
+    for (; labels != NULL; labels = labels->next) {
+        if (getSymbol(names, labels->name) != NULL) {
+            return FALSE;
+        }
+
+        addSymbol(names, labels->name);
+    }
+
+    return TRUE;
+}
+
+Boolean addFoundLabelNames(SymbolTable *names, FoundLabel *labels) {
+    /* Add the name of each found label, unless it is already there. */
+    for (; labels != NULL; labels = labels->next) {
+        if (getSymbol(names, labels->name) != NULL) {
+            return FALSE;
+        }
+
+        addSymbol(names, labels->name);
+    }
+
+    return TRUE;
+}
+
+void mergeChunks(ChunkedReading *chunked, WordImage *code, WordImage *data,
+                 Label **entryLabels, Label **externLabels,
+                 UsedLabel **usedLabels, FoundLabel **foundLabels,
+                 WordCount *instructionCount, WordCount *dataCount) {
+    ParsingChunk *chunk; /* The current range. */
+    unsigned int index;  /* The index of the current range. */
+
+    for (index = INITIAL_VALUE; index < chunked->count; index++) {
+        chunk = &chunked->chunks[index];
+
+        /* Copy the words of the range after the words before it. */
+        memcpy(&code->words[code->count], chunk->code.words,
+               sizeof(Word) * chunk->code.count);
+        memcpy(&data->words[data->count], chunk->data.words,
+               sizeof(Word) * chunk->data.count);
+        code->count += chunk->code.count;
+        data->count += chunk->data.count;
+
+        /* Move the labels after the words and the lines before the range. */
+        *entryLabels =
+            rebaseLabels(chunk->entryLabels, chunk->firstLine, *entryLabels);
+        *externLabels =
+            rebaseLabels(chunk->externLabels, chunk->firstLine, *externLabels);
+        *usedLabels = rebaseUsedLabels(chunk->usedLabels, *instructionCount,
+                                       chunk->firstLine, *usedLabels);
+        *foundLabels = rebaseFoundLabels(chunk->foundLabels, *instructionCount,
+                                         *dataCount, *foundLabels);
+
+        /* Add the words of the range to the counts. */
+        *instructionCount += chunk->instructionCount;
+        *dataCount += chunk->dataCount;
+
+        /* Print the messages of the range, at their lines in the file. */
+        shiftMessageLines(&chunk->messages, chunk->firstLine);
+        flushMessages(&chunk->messages);
+    }
+}
+
+Label *rebaseLabels(Label *labels, LineNumber lineCount, Label *earlier) {
+    Label *label; /* The current label. */
+
+    /* Check if the range has no labels. */
+    if (labels == NULL) {
+        return earlier;
+    }
+
+    /* Move each label, up to the last one. */
+    for (label = labels;; label = label->next) {
+        label->lineNumber += lineCount;
+
+        /* Stop at the last label. */
+        if (label->next == NULL) {
+            break;
+        }
+    }
+
+    /* The earlier labels come after the range's (lists are newest first). */
+    label->next = earlier;
+    return labels;
+}
+
+UsedLabel *rebaseUsedLabels(UsedLabel *labels, WordCount codeCount,
+                            LineNumber lineCount, UsedLabel *earlier) {
+    UsedLabel *label; /* The current used label. */
+
+    /* Check if the range has no used labels. */
+    if (labels == NULL) {
+        return earlier;
+    }
+
+    /* Move each used label, up to the last one. */
+    for (label = labels;; label = label->next) {
+        label->address += codeCount;
+        label->wordIndex += codeCount;
+        label->lineNumber += lineCount;
+
+        /* Stop at the last used label. */
+        if (label->next == NULL) {
+            break;
+        }
+    }
+
+    /* The earlier used labels come after the range's. */
+    label->next = earlier;
+    return labels;
+}
+
+FoundLabel *rebaseFoundLabels(FoundLabel *labels, WordCount codeCount,
+                              WordCount dataCount, FoundLabel *earlier) {
+    FoundLabel *label; /* The current found label. */
+
+    /* Check if the range has no found labels. */
+    if (labels == NULL) {
+        return earlier;
+    }
+
+    /* Move each found label in its own part, up to the last one. */
+    for (label = labels;; label = label->next) {
+        label->address += label->isData ? dataCount : codeCount;
+
+        /* Stop at the last found label. */
+        if (label->next == NULL) {
+            break;
+        }
+    }
+
+    /* The earlier found labels come after the range's. */
+    label->next = earlier;
+    return labels;
+}
+
+void discardChunkMessages(ChunkedReading *chunked) {
+    unsigned int index; /* The index of the current range. */
+
+    /* Throw away the messages of each range. */
+    for (index = INITIAL_VALUE; index < chunked->count; index++) {
+        discardMessages(&chunked->chunks[index].messages);
+    }
+}
+
+void releaseChunks(ChunkedReading *chunked) {
+    unsigned int index; /* The index of the current range. */
+
+    /* Free the arena of each range, and then the ranges. */
+    for (index = INITIAL_VALUE; index < chunked->count; index++) {
+        freeArena(&chunked->chunks[index].toFree.arena);
+    }
+    free(chunked->chunks);
+
+    /* No ranges are left. */
+    chunked->chunks = NULL;
+    chunked->count = EMPTY;
+}
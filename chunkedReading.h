@@ -0,0 +1,196 @@
+/*
+ * chunkedReading.h
+ *
+ * Contains the function prototypes for the functions in chunkedReading.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef CHUNKED_READING_H
+#define CHUNKED_READING_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Reads the macro-expanded text the same way readFile does, but splits a large
+ * text into ranges of lines that are parsed on several threads at the same
+ * time, and then moves the words, addresses and line numbers of each range
+ * after the ranges before it.
+ * Reads the text on the calling thread instead if it is too small for more
+ * than one range, if a thread could not be started, or if a range could have
+ * been affected by the ranges before it (a label defined or declared in more
+ * than one range, an error after the first range, or too many words).
+ * The messages and the results are the same either way.
+ *
+ * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that all the pointers given as arguments are not NULL.
+ *
+ * @param fileName The name of the file to read.
+ * @param expanded The macro-expanded text of the file.
+ * @param macros The macro table.
+ * @param code The code image.
+ * @param data The data image.
+ * @param entryLabels The list of entry labels.
+ * @param externLabels The list of extern labels.
+ * @param usedLabels The list of used labels.
+ * @param foundLabels The list of found labels.
+ * @param instructionCount The current instruction count to modify.
+ * @param dataCount The current data count to modify.
+ * @param jobCount The number of threads that may parse the text.
+ * @param chunked The ranges to fill (freed once the file is done).
+ * @return TRUE if no errors occurred, FALSE otherwise.
+ */
+Boolean readFileInChunks(char fileName[], TextBuffer *expanded,
+                         MacroTable *macros, WordImage *code, WordImage *data,
+                         Label **entryLabels, Label **externLabels,
+                         UsedLabel **usedLabels, FoundLabel **foundLabels,
+                         WordCount *instructionCount, WordCount *dataCount,
+                         unsigned int jobCount, ChunkedReading *chunked);
+
+/**
+ * Splits the given expanded text into the given ranges, each ending right
+ * after a newline character (except the last one), with about the same number
+ * of characters in each.
+ * Prepares each range to be parsed from the start.
+ *
+ * Assumes that the given pointers are not NULL, and that the given ranges have
+ * room for their count.
+ *
+ * @param expanded The macro-expanded text of the file.
+ * @param chunked The ranges to fill.
+ * @param fileName The name of the file.
+ * @param macros The macro table.
+ */
+void splitIntoChunks(TextBuffer *expanded, ChunkedReading *chunked,
+                     char fileName[], MacroTable *macros);
+
+/**
+ * The function that the thread of each range runs.
+ * Parses the lines of the range with an arena and a message queue of its own.
+ *
+ * Assumes that the given argument points to a prepared range.
+ *
+ * @param parsingChunk The range (ParsingChunk *).
+ * @return NULL.
+ */
+void *runParsingChunk(void *parsingChunk);
+
+/**
+ * Checks if the ranges were parsed exactly the way a single pass would have
+ * parsed them: the words fit in memory, no range after the first found errors,
+ * and no label is defined, declared as entry or declared as extern in more
+ * than one range.
+ *
+ * Assumes that the given ranges have all been parsed.
+ *
+ * @param chunked The ranges.
+ * @return Whether the ranges can be merged.
+ */
+Boolean canMergeChunks(ChunkedReading *chunked);
+
+/**
+ * Adds the names of the given labels to the given names.
+ *
+ * Assumes that the given names pointer is not NULL.
+ *
+ * @param names The names found so far.
+ * @param labels The labels list.
+ * @return Whether none of the names had been added before.
+ */
+Boolean addLabelNames(SymbolTable *names, Label *labels);
+
+/**
+ * Adds the names of the given found labels to the given names.
+ *
+ * Assumes that the given names pointer is not NULL.
+ *
+ * @param names The names found so far.
+ * @param labels The found labels list.
+ * @return Whether none of the names had been added before.
+ */
+Boolean addFoundLabelNames(SymbolTable *names, FoundLabel *labels);
+
+/**
+ * Merges the parsed ranges into the given images and lists, in order.
+ * The words of each range are copied after the words of the ranges before it,
+ * and its addresses and line numbers are moved forward by the words and the
+ * lines before it. Its messages are then printed.
+ *
+ * Assumes that the given ranges can be merged, and that all the pointers given
+ * as arguments are not NULL.
+ *
+ * @param chunked The ranges.
+ * @param code The code image.
+ * @param data The data image.
+ * @param entryLabels The list of entry labels.
+ * @param externLabels The list of extern labels.
+ * @param usedLabels The list of used labels.
+ * @param foundLabels The list of found labels.
+ * @param instructionCount The instruction count to set.
+ * @param dataCount The data count to set.
+ */
+void mergeChunks(ChunkedReading *chunked, WordImage *code, WordImage *data,
+                 Label **entryLabels, Label **externLabels,
+                 UsedLabel **usedLabels, FoundLabel **foundLabels,
+                 WordCount *instructionCount, WordCount *dataCount);
+
+/**
+ * Moves the given labels forward by the given number of lines and puts the
+ * given earlier labels after them (the lists are newest first).
+ *
+ * @param labels The labels of a range.
+ * @param lineCount The number of lines before the range.
+ * @param earlier The labels of the ranges before it.
+ * @return The head of the combined list.
+ */
+Label *rebaseLabels(Label *labels, LineNumber lineCount, Label *earlier);
+
+/**
+ * Moves the given used labels forward by the given number of code words and
+ * lines, and puts the given earlier used labels after them.
+ *
+ * @param labels The used labels of a range.
+ * @param codeCount The number of code words before the range.
+ * @param lineCount The number of lines before the range.
+ * @param earlier The used labels of the ranges before it.
+ * @return The head of the combined list.
+ */
+UsedLabel *rebaseUsedLabels(UsedLabel *labels, WordCount codeCount,
+                            LineNumber lineCount, UsedLabel *earlier);
+
+/**
+ * Moves the addresses of the given found labels forward by the given number of
+ * code words or data words (depending on their part), and puts the given
+ * earlier found labels after them.
+ *
+ * @param labels The found labels of a range.
+ * @param codeCount The number of code words before the range.
+ * @param dataCount The number of data words before the range.
+ * @param earlier The found labels of the ranges before it.
+ * @return The head of the combined list.
+ */
+FoundLabel *rebaseFoundLabels(FoundLabel *labels, WordCount codeCount,
+                              WordCount dataCount, FoundLabel *earlier);
+
+/**
+ * Throws away the messages of all the given ranges.
+ *
+ * Assumes that the given ranges pointer is not NULL.
+ *
+ * @param chunked The ranges.
+ */
+void discardChunkMessages(ChunkedReading *chunked);
+
+/**
+ * Frees the memory of all the given ranges, and the ranges themselves.
+ *
+ * Assumes that the given ranges pointer is not NULL.
+ *
+ * @param chunked The ranges to free (none, if there are none).
+ */
+void releaseChunks(ChunkedReading *chunked);
+
+#endif
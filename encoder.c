@@ -3,6 +3,8 @@
  *
  * Contains functions to encode the different types of data into the memory
  * cells.
+ * The first word of every instruction is taken from a table of templates, and
+ * the other values are shifted into place, so that no word is built bit by bit.
  *
  * Name: Ariel Keren
  * Course: C Lab, 20465
@@ -12,46 +14,70 @@
 
 #include "encoder.h"
 
-#include <stdlib.h> /* free, atoi. */
+#include <pthread.h> /* pthread_once. */
 
 #include "globals.h"                /* Constants and typedefs. */
 #include "instructionInformation.h" /* Information about the different instructions. */
 #include "utils.h"                  /* Parsing lines. */
-#include "wordList.h"               /* Adding new words to the data list. */
+#include "wordImage.h"              /* Adding new words to the data image. */
 
-void toggleBit(Word *word, Position bitPosition) {
-    Position adjustedPosition; /* Used when the bit is in the data2 property. */
-
-    /* Check if the bit is in the data1 property. */
-    if (bitPosition < (sizeof(word->data1) * BITS_PER_BYTE)) {
-        /* Toggle the bit in the data1 property. */
-        word->data1 |= (SINGLE_BIT << bitPosition);
-        return;
-    }
+/* The first words of all the instructions (operation, source, destination). */
+static Word firstWordTemplates[OPERATION_COUNT][OPERAND_TYPE_COUNT]
+                              [OPERAND_TYPE_COUNT];
+/* Makes sure that the templates are built only once. */
+static pthread_once_t templatesOnce = PTHREAD_ONCE_INIT;
 
-    /* Adjust the position according to the data1's size in bits. */
-    adjustedPosition = bitPosition - (sizeof(word->data1) * BITS_PER_BYTE);
-    /* Toggle the bit in the data2 property. */
-    word->data2 |= (SINGLE_BIT << adjustedPosition);
+void toggleBit(Word *word, Position bitPosition) {
+    /* Toggle the bit in the word. */
+    *word |= (Word)(SINGLE_BIT << bitPosition);
 }
 
 void applyMask(Word *word, Mask mask, Position from) {
-    /* Constantly shift the mask and toggle each 1 bit. Limit the position. */
-    while (mask != EMPTY && from < BITS_PER_MEMORY_CELL) {
-        /* Check if the bit is a 1. */
-        if (mask & SINGLE_BIT) {
-            /* Toggle the bit. */
-            toggleBit(word, from);
-        }
+    /* Shift the mask into place and drop the bits that do not fit the word. */
+    *word |= (Word)(((unsigned long)mask << from) & MEMORY_CELL_MASK);
+}
 
-        /* Shift the mask. */
-        mask >>= SINGLE_BIT;
-        /* Increment the position. */
-        from++;
+void buildFirstWordTemplates() {
+    Index operation;         /* The index of the current operation. */
+    OperandType source;      /* The current source operand's type. */
+    OperandType destination; /* The current destination operand's type. */
+    Word *template;          /* The current template. */
+
+    /* Build a template for every combination of operation and operands. */
+    for (operation = INITIAL_VALUE; operation < OPERATION_COUNT; operation++) {
+        for (source = IMMEDIATE; source < OPERAND_TYPE_COUNT; source++) {
+            for (destination = IMMEDIATE; destination < OPERAND_TYPE_COUNT;
+                 destination++) {
+                template = &firstWordTemplates[operation][source][destination];
+
+                /* Start from the operation and the A metadata. */
+                *template = getOperationTemplate(operation);
+
+                /* Encode the addressing mode of an existing source operand. */
+                if (source != ABSENT_OPERAND) {
+                    toggleBit(template,
+                              (Position)source + STARTING_SOURCE_OPERAND_BIT);
+                }
+
+                /* Encode the addressing mode of an existing destination. */
+                if (destination != ABSENT_OPERAND) {
+                    toggleBit(template, (Position)destination +
+                                            STARTING_DESTINATION_OPERAND_BIT);
+                }
+            }
+        }
     }
 }
 
-void encodeString(Word **data, char string[], WordCount *dataCount) {
+void encodeFirstWord(Word *word, Index operation, OperandType source,
+                     OperandType destination) {
+    /* Make sure the templates exist before using them. */
+    pthread_once(&templatesOnce, buildFirstWordTemplates);
+    /* Encode the whole first word at once. */
+    *word |= firstWordTemplates[operation][source][destination];
+}
+
+void encodeString(WordImage *data, char string[], WordCount *dataCount) {
     Length length; /* The length of the string. */
 
     /* Compute the .string line's length. */
@@ -63,10 +89,9 @@ void encodeString(Word **data, char string[], WordCount *dataCount) {
     while (length > EMPTY) {
         /* Increment the data count. */
         (*dataCount)++;
-        /* Add another word to the data part. */
-        *data = addWord(*data);
-        /* Encode the character's ASCII value into the new word. */
-        encodeData(*data, (short)*string);
+        /* Add another word to the data part and encode the character's ASCII
+         * value into it. */
+        encodeData(addWord(data), (short)*string);
 
         /* Move on to the next character. */
         string++;
@@ -76,30 +101,20 @@ void encodeString(Word **data, char string[], WordCount *dataCount) {
     /* Increment the data count for the null character. */
     (*dataCount)++;
     /* Add an empty word, representing the null character. */
-    *data = addWord(*data);
+    addWord(data);
 }
 
-void encodeNumberList(Word **data, char numberList[], WordCount *dataCount) {
-    char *token; /* The current token. */
+void encodeNumberList(WordImage *data, short numbers[], Index numberCount,
+                      WordCount *dataCount) {
+    Index index; /* The index of the current number. */
 
     /* Encode every number in the number list. */
-    while (*numberList != '\0') {
-        /* Get the next token. */
-        token = getNextToken(numberList);
-        /* Remove the possible comma. */
-        removeEnding(token, ',');
+    for (index = INITIAL_VALUE; index < numberCount; index++) {
         /* Increment the data count. */
         (*dataCount)++;
-        /* Add another word to the data part. */
-        *data = addWord(*data);
-        /* Encode the number's 2's complement representation. */
-        encodeData(*data, (short)atoi(token));
-
-        /* The current token is no longer used. */
-        free(token);
-        /* Move on to the next token. */
-        numberList = skipCharacters(numberList);
-        numberList = skipWhitespace(numberList);
+        /* Add another word to the data part and encode the number's 2's
+         * complement representation into it. */
+        encodeData(addWord(data), numbers[index]);
     }
 }
 
@@ -124,25 +139,19 @@ void encodeMetadata(Word *word, char metadata) {
     }
 }
 
-void encodeExtraWord(Word *word, char operand[], Boolean isSource) {
+void encodeExtraWord(Word *word, ParsedOperand *operand, Boolean isSource) {
     /* Determine the addressing mode of the operand before encoding it. */
-    switch (getOperandType(operand)) {
+    switch (operand->type) {
         case DIRECT_REGISTER:
-            /* Encode a direct register. */
-            encodeMetadata(word, 'A');
-            encodeRegister(word, convertDigitToNumber(operand[SECOND_INDEX]),
-                           isSource);
-            break;
         case INDIRECT_REGISTER:
-            /* Encode an indirect register. */
+            /* Encode a direct or an indirect register. */
             encodeMetadata(word, 'A');
-            encodeRegister(word, convertDigitToNumber(operand[THIRD_INDEX]),
-                           isSource);
+            encodeRegister(word, (unsigned char)operand->value, isSource);
             break;
         case IMMEDIATE:
             /* Encode an immediate value. */
             encodeMetadata(word, 'A');
-            encodeImmediate(word, (short)atoi(&operand[SECOND_INDEX]));
+            encodeImmediate(word, operand->value);
             break;
         default:
             /* Direct operands (labels) will be encoded later. */
@@ -150,20 +159,6 @@ void encodeExtraWord(Word *word, char operand[], Boolean isSource) {
     }
 }
 
-void encodeOperand(Word *word, char operand[], Boolean isSource) {
-    /* Encode the operand differently if it is the source or the destination. */
-    if (isSource) {
-        /* Encode the addressing mode of a source operand. */
-        toggleBit(word, (Position)getOperandType(operand) +
-                            STARTING_SOURCE_OPERAND_BIT);
-        return;
-    }
-
-    /* Encode the addressing mode of a destination operand. */
-    toggleBit(word, (Position)getOperandType(operand) +
-                        STARTING_DESTINATION_OPERAND_BIT);
-}
-
 void encodeRegister(Word *word, unsigned char registerNumber,
                     Boolean isSource) {
     /* Encode the register's number into the given word. */
@@ -172,11 +167,6 @@ void encodeRegister(Word *word, unsigned char registerNumber,
                        : STARTING_DESTINATION_REGISTER_BIT);
 }
 
-void encodeOperation(Word *word, char operation[]) {
-    /* Encode the operation's unique identifier number into the given word. */
-    applyMask(word, (Mask)getOperationIndex(operation), STARTING_OPERATION_BIT);
-}
-
 void encodeImmediate(Word *word, short immediate) {
     /* Encode the immediate value's 2's complement representation. */
     applyMask(word, (Mask)immediate, STARTING_IMMEDIATE_BIT);
@@ -28,6 +28,8 @@ void toggleBit(Word *word, Position bitPosition);
 /**
  * Applies the given mask to given word from the given position (continuing to
  * the MSB).
+ * Shifts the whole mask into place at once, and drops the bits of the mask that
+ * do not fit in the word.
  *
  * Assumes that the given word is not NULL.
  * Assumes that the given position is between 0 and 14, inclusive.
@@ -39,9 +41,38 @@ void toggleBit(Word *word, Position bitPosition);
  */
 void applyMask(Word *word, Mask mask, Position from);
 
+/**
+ * Builds the templates of the first words of all the instructions, one for
+ * every operation and every combination of source and destination types.
+ * Each template has the A metadata, the operation's number and the addressing
+ * modes of the operands that exist.
+ *
+ * Assumes that this function is called only once (through pthread_once).
+ */
+void buildFirstWordTemplates();
+
+/**
+ * Encodes the first word of an instruction into the given word, using the
+ * template of the given operation and operand types.
+ * Builds the templates the first time it is called.
+ *
+ * Assumes that the given word is not NULL.
+ * Assumes that the given operation index is between 0 and 15, inclusive.
+ * Assumes that the given source type is ABSENT_OPERAND if the instruction has
+ * less than 2 operands, and that the given destination type is ABSENT_OPERAND
+ * if the instruction has no operands.
+ *
+ * @param word The word to encode the first word in.
+ * @param operation The index of the instruction's operation.
+ * @param source The source operand's type.
+ * @param destination The destination operand's type.
+ */
+void encodeFirstWord(Word *word, Index operation, OperandType source,
+                     OperandType destination);
+
 /**
  * Encodes the given string into words, that will be added in order to the data
- * word list.
+ * image.
  * Increments the data count by the number of words that have been added.
  * Adds the ASCII values of the characters of the string to separate words.
  * Finally, adds another word with all zeros to represent the null terminator of
@@ -51,28 +82,30 @@ void applyMask(Word *word, Mask mask, Position from);
  * Assumes that the given string is not NULL and is null-terminated.
  * Assumes that the given pointer to the data count is not NULL.
  *
- * @param data The data word list to add the words to.
+ * @param data The data image to add the words to.
  * @param string The string to encode.
  * @param dataCount The data count to increment.
  */
-void encodeString(Word **data, char string[], WordCount *dataCount);
+void encodeString(WordImage *data, char string[], WordCount *dataCount);
 
 /**
- * Encodes the given number list string into words, that will be added in order
- * to the data word list.
+ * Encodes the numbers of a .data line, which were kept while validating it,
+ * into words, that will be added in order to the data image.
  * Increments the data count by the number of words that have been added.
  * Adds the 2's complement binary representation of the numbers in the number
  * list to separate words.
  *
  * Assumes that the given data is not NULL.
- * Assumes that the given number list string is not NULL and is null-terminated.
+ * Assumes that the given numbers array contains numberCount numbers.
  * Assumes that the given pointer to the data count is not NULL.
  *
- * @param data The data word list to add the words to.
- * @param numberList The number list string, separated by commas, to encode.
+ * @param data The data image to add the words to.
+ * @param numbers The numbers of the .data line.
+ * @param numberCount The number of numbers.
  * @param dataCount The data count to increment.
  */
-void encodeNumberList(Word **data, char numberList[], WordCount *dataCount);
+void encodeNumberList(WordImage *data, short numbers[], Index numberCount,
+                      WordCount *dataCount);
 
 /**
  * Encodes the given metadata character into the given word.
@@ -101,29 +134,15 @@ void encodeMetadata(Word *word, char metadata);
  * Does not encode anything if the operand is of type direct.
  *
  * Assumes that the given word is not NULL.
- * Assumes that the given operand string is not NULL and is null-terminated.
+ * Assumes that the given operand pointer is not NULL and that the operand was
+ * kept while validating it.
  *
  * @param word The word to encode the operand in.
  * @param operand The operand to encode.
  * @param isSource Whether the operand is the source or the destination of the
  * instruction.
  */
-void encodeExtraWord(Word *word, char operand[], Boolean isSource);
-
-/**
- * Encodes the given operand into the given instruction word.
- * Encodes according to the type of the given operand and according to whether
- * it is the source or the destination.
- *
- * Assumes that the given word is not NULL.
- * Assumes that the given operand string is not NULL and is null-terminated.
- *
- * @param word The word to encode the operand in.
- * @param operand The operand to encode.
- * @param isSource Whether the operand is the source or the destination of the
- * instruction.
- */
-void encodeOperand(Word *word, char operand[], Boolean isSource);
+void encodeExtraWord(Word *word, ParsedOperand *operand, Boolean isSource);
 
 /**
  * Encodes the given register number into the given word.
@@ -139,18 +158,6 @@ void encodeOperand(Word *word, char operand[], Boolean isSource);
  */
 void encodeRegister(Word *word, unsigned char registerNumber, Boolean isSource);
 
-/**
- * Encodes the given operation into the given word.
- * Encodes the number of the operation.
- *
- * Assumes that the given word is not NULL.
- * Assumes that the given operation string is not NULL and is null-terminated.
- *
- * @param word The word to encode the operation in.
- * @param operation The operation to encode.
- */
-void encodeOperation(Word *word, char operation[]);
-
 /**
  * Encodes the given immediate value into the given word.
  * Encodes the 2's complement binary representation of the immediate value.
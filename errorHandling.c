@@ -12,12 +12,21 @@
 
 #include "errorHandling.h"
 
-#include <stdio.h> /* printf. */
+#include <pthread.h> /* pthread_key_t, pthread_once. */
+#include <stdio.h>   /* printf, fprintf, stderr. */
+#include <stdlib.h>  /* free. */
 
 #include "globals.h" /* Constants and typedefs. */
+#include "utils.h"   /* Allocating memory. */
 
 static Boolean error = FALSE;
 
+/* The key of the queue that the current thread stores its messages in. */
+static pthread_key_t queueKey;
+/* Makes sure that the key is created only once. */
+static pthread_once_t queueKeyOnce = PTHREAD_ONCE_INIT;
+
+
 Boolean getErrorStatus() {
     /* Return the error status. */
     return error;
@@ -44,6 +53,11 @@ void printMessage(char message[], char fileName[], LineNumber lineNumber,
 }
 
 void printError(char message[], char fileName[], LineNumber lineNumber) {
+    /* Store the error instead, if the current thread has a queue. */
+    if (storeMessage(ERROR_MESSAGE, message, fileName, lineNumber, FALSE)) {
+        return;
+    }
+
     error = TRUE;
 
     /* Print an error that was found in the .am file. */
@@ -51,6 +65,12 @@ void printError(char message[], char fileName[], LineNumber lineNumber) {
 }
 
 void printMacroError(char message[], char fileName[], LineNumber lineNumber) {
+    /* Store the error instead, if the current thread has a queue. */
+    if (storeMessage(MACRO_ERROR_MESSAGE, message, fileName, lineNumber,
+                     TRUE)) {
+        return;
+    }
+
     error = TRUE;
 
     /* Print an error that was found in the .as file. */
@@ -58,6 +78,11 @@ void printMacroError(char message[], char fileName[], LineNumber lineNumber) {
 }
 
 void printWarning(char message[], char fileName[], LineNumber lineNumber) {
+    /* Store the warning instead, if the current thread has a queue. */
+    if (storeMessage(WARNING_MESSAGE, message, fileName, lineNumber, FALSE)) {
+        return;
+    }
+
     /* Print a warning that was found in the .am file. */
     printMessage(message, fileName, lineNumber, FALSE, FALSE);
 }
@@ -66,6 +91,12 @@ void printNameError(char message[], char fileName[], LineNumber lineNumber,
                     Boolean isMacro) {
     static unsigned long nameErrorCount = INITIAL_VALUE; /* Errors so far. */
 
+    /* Store the error instead, if the current thread has a queue. */
+    if (storeMessage(NAME_ERROR_MESSAGE, message, fileName, lineNumber,
+                     isMacro)) {
+        return;
+    }
+
     error = TRUE;
 
     /* Specify the type of the message. */
@@ -79,6 +110,12 @@ void printNameError(char message[], char fileName[], LineNumber lineNumber,
 }
 
 void printFileError(char fileName[]) {
+    /* Store the error instead, if the current thread has a queue. */
+    if (storeMessage(FILE_ERROR_MESSAGE, fileName, NULL, INITIAL_VALUE,
+                     FALSE)) {
+        return;
+    }
+
     error = TRUE;
 
     printf("\n--- File Error ---\n");
@@ -96,6 +133,141 @@ void printAllocationError() {
     printf("Exiting the program...\n");
 }
 
+void printOptionError(char option[]) {
+    printf("\n--- Option Error ---\n");
+    printf("Invalid option: %s\n", option);
+    printf("Use -j <number of jobs> (between 1 and %d), --no-am, "
+           "--time-report or --cache <directory> before the files.\n",
+           MAX_JOB_COUNT);
+    printf("Exiting the program...\n");
+}
+
+void createQueueKey() {
+    /* Every thread starts without a queue (NULL). */
+    pthread_key_create(&queueKey, NULL);
+}
+
+void queueMessages(MessageQueue *messages) {
+    /* Make sure the key exists before using it. */
+    pthread_once(&queueKeyOnce, createQueueKey);
+    /* Set the queue of the current thread. */
+    pthread_setspecific(queueKey, messages);
+}
+
+MessageQueue *getMessageQueue() {
+    /* Make sure the key exists before using it. */
+    pthread_once(&queueKeyOnce, createQueueKey);
+    /* Return the queue of the current thread. */
+    return pthread_getspecific(queueKey);
+}
+
+Boolean storeMessage(MessageKind kind, char text[], char fileName[],
+                     LineNumber lineNumber, Boolean isMacro) {
+    MessageQueue *messages; /* The queue of the current thread. */
+    Message *newMessage;    /* The new message. */
+
+    /* Get the queue of the current thread. */
+    pthread_once(&queueKeyOnce, createQueueKey);
+    messages = pthread_getspecific(queueKey);
+
+    /* Check if the message should be printed right away. */
+    if (messages == NULL) {
+        return FALSE;
+    }
+
+    /* Allocate enough memory for the new message. */
+    newMessage = allocate(sizeof(Message));
+
+    /* Set the new message's properties. */
+    newMessage->kind = kind;
+    newMessage->text = copyString(text);
+    newMessage->fileName = fileName;
+    newMessage->lineNumber = lineNumber;
+    newMessage->isMacro = isMacro;
+    newMessage->next = NULL;
+
+    /* Add the new message to the end of the queue, to keep the order. */
+    if (messages->last == NULL) {
+        messages->first = newMessage;
+    } else {
+        messages->last->next = newMessage;
+    }
+    messages->last = newMessage;
+
+    return TRUE;
+}
+
+void flushMessages(MessageQueue *messages) {
+    Message *next; /* The next message in the queue. */
+
+    /* Print each message in the queue and free it. */
+    while (messages->first != NULL) {
+        /* Print the message the same way it would have been printed. */
+        switch (messages->first->kind) {
+            case ERROR_MESSAGE:
+                printError(messages->first->text, messages->first->fileName,
+                           messages->first->lineNumber);
+                break;
+            case MACRO_ERROR_MESSAGE:
+                printMacroError(messages->first->text,
+                                messages->first->fileName,
+                                messages->first->lineNumber);
+                break;
+            case WARNING_MESSAGE:
+                printWarning(messages->first->text, messages->first->fileName,
+                             messages->first->lineNumber);
+                break;
+            case NAME_ERROR_MESSAGE:
+                printNameError(messages->first->text,
+                               messages->first->fileName,
+                               messages->first->lineNumber,
+                               messages->first->isMacro);
+                break;
+            case FILE_ERROR_MESSAGE:
+                printFileError(messages->first->text);
+                break;
+            default:
+                /* Should not happen. */
+                break;
+        }
+
+        /* Store the next message. */
+        next = messages->first->next;
+        /* Free the current message. */
+        free(messages->first->text);
+        free(messages->first);
+        /* Move on to the next message. */
+        messages->first = next;
+    }
+
+    /* The queue is now empty. */
+    messages->last = NULL;
+}
+
+void discardMessages(MessageQueue *messages) {
+    Message *next; /* The next message in the queue. */
+
+    /* Free each message in the queue. */
+    while (messages->first != NULL) {
+        next = messages->first->next;
+        free(messages->first->text);
+        free(messages->first);
+        messages->first = next;
+    }
+
+    /* The queue is now empty. */
+    messages->last = NULL;
+}
+
+void shiftMessageLines(MessageQueue *messages, LineNumber lineCount) {
+    Message *message; /* The current message. */
+
+    /* Move the line number of each message. */
+    for (message = messages->first; message != NULL; message = message->next) {
+        message->lineNumber += lineCount;
+    }
+}
+
 void printNoFilesError() {
     printf("\n--- No Files Error ---\n");
     printf("No files provided to compile.\n");
@@ -104,3 +276,10 @@ void printNoFilesError() {
         "command line arguments.\n");
     printf("Exiting the program...\n");
 }
+
+void printCacheError(char reason[], char path[]) {
+    /* The outputs are the same without the cache, so only stderr is used. */
+    fprintf(stderr, "\n--- Cache Error ---\n");
+    fprintf(stderr, "%s: %s\n", reason, path);
+    fprintf(stderr, "Compiling the files without the cache...\n");
+}
@@ -111,6 +111,94 @@ void printFileError(char fileName[]);
  */
 void printAllocationError();
 
+/**
+ * Prints an option error to stdout with the given option.
+ * An option error can occur if some command line option is unknown or is
+ * missing a valid value.
+ *
+ * Assumes that the given option is not NULL and is null-terminated.
+ *
+ * @param option The invalid option.
+ */
+void printOptionError(char option[]);
+
+/**
+ * Creates the key of the queue that each thread stores its messages in.
+ *
+ * Assumes that this function is called only once (through pthread_once).
+ */
+void createQueueKey();
+
+/**
+ * Makes the calling thread store its messages in the given queue instead of
+ * printing them, until this function is called again with NULL.
+ * Allocation errors are never stored, as they exit the program.
+ *
+ * @param messages The queue to store the messages in, or NULL to print them.
+ */
+void queueMessages(MessageQueue *messages);
+
+/**
+ * Returns the queue that the calling thread stores its messages in.
+ *
+ * @return The queue of the calling thread, or NULL if it prints them.
+ */
+MessageQueue *getMessageQueue();
+
+/**
+ * Stores a message in the calling thread's queue, if it has one.
+ * Returns whether or not the message has been stored.
+ *
+ * Assumes that the given text is not NULL and is null-terminated.
+ * Assumes that the given file name is NULL or is null-terminated.
+ *
+ * @param kind The kind of the message.
+ * @param text The text of the message (or the file's name, for file errors).
+ * @param fileName The name of the file in which the message occurred.
+ * @param lineNumber The line number in the file in which the message
+ * occurred.
+ * @param isMacro Whether the name is of a macro or of a label (for name
+ * errors).
+ * @return TRUE if the message has been stored, FALSE if it should be printed.
+ */
+Boolean storeMessage(MessageKind kind, char text[], char fileName[],
+                     LineNumber lineNumber, Boolean isMacro);
+
+/**
+ * Prints all the messages in the given queue in order and empties it.
+ * Updates the error status and the message counters as if the messages were
+ * printed when they occurred.
+ *
+ * If the calling thread stores its messages in a queue, they move to that
+ * queue instead.
+ *
+ * Assumes that the given queue is not NULL.
+ *
+ * @param messages The queue to print.
+ */
+void flushMessages(MessageQueue *messages);
+
+/**
+ * Frees all the messages in the given queue without printing them, and
+ * empties it.
+ *
+ * Assumes that the given queue is not NULL.
+ *
+ * @param messages The queue to empty.
+ */
+void discardMessages(MessageQueue *messages);
+
+/**
+ * Moves the line number of every message in the given queue forward by the
+ * given number of lines.
+ *
+ * Assumes that the given queue is not NULL.
+ *
+ * @param messages The queue of the messages.
+ * @param lineCount The number of lines to move forward by.
+ */
+void shiftMessageLines(MessageQueue *messages, LineNumber lineCount);
+
 /**
  * Prints a no files error to stdout.
  * A no files error can occur if no files have been provided as command line
@@ -118,4 +206,17 @@ void printAllocationError();
  */
 void printNoFilesError();
 
+/**
+ * Prints a cache error to stderr with the given reason and path.
+ * A cache error can occur if the cache directory could not be created or the
+ * running assembler could not be read, in which case the files are compiled
+ * without the cache.
+ *
+ * Assumes that the given reason and path are not NULL and are null-terminated.
+ *
+ * @param reason The reason the cache cannot be used.
+ * @param path The path of the directory or file that could not be used.
+ */
+void printCacheError(char reason[], char path[]);
+
 #endif
@@ -2,6 +2,8 @@
  * fileGeneration.c
  *
  * Contains functions to generate the .ob, .ent and .ext files.
+ * The contents of every file are formatted in memory, without any format
+ * strings, and then written to the file at once.
  *
  * Name: Ariel Keren
  * Course: C Lab, 20465
@@ -11,19 +13,20 @@
 
 #include "fileGeneration.h"
 
-#include <stdio.h>  /* fprintf, fclose. */
-#include <string.h> /* strcmp. */
+#include <stdio.h>  /* FILE, fclose. */
+#include <string.h> /* strlen. */
 
-#include "errorHandling.h"  /* Printing errors. */
-#include "foundLabelList.h" /* Searching through the found label list. */
-#include "globals.h"        /* Constants and typedefs. */
-#include "labelList.h" /* Getting the longest label's length in each label list. */
-#include "usedLabelList.h" /* Searching through the used label list. */
+#include "errorHandling.h" /* Printing errors. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "outputCache.h"   /* Recording the files' contents in the cache. */
+#include "symbolTable.h"   /* Searching for the symbols of the labels. */
+#include "textBuffer.h"    /* Formatting the files' contents in memory. */
 #include "utils.h"         /* Creating the output files. */
 
-void generateObFile(char fileName[], Word *code, Word *data,
+void generateObFile(char fileName[], WordImage *code, WordImage *data,
                     WordCount instructionCount, WordCount dataCount) {
-    FILE *file; /* The .ob file to write to. */
+    FILE *file;        /* The .ob file to write to. */
+    TextBuffer output; /* The contents of the .ob file. */
 
     /* Open the .ob file. */
     file = openFile(fileName, "ob", "w");
@@ -34,36 +37,43 @@ void generateObFile(char fileName[], Word *code, Word *data,
         return;
     }
 
-    /* Write the instruction and data count to the file. */
-    fprintf(file, "%hu %hu", instructionCount, dataCount);
+    /* Write the instruction and data count. */
+    initTextBuffer(&output);
+    appendDecimal(&output, instructionCount, NO_PADDING);
+    appendChars(&output, " ", SINGLE_ENTRY);
+    appendDecimal(&output, dataCount, NO_PADDING);
 
-    /* Start at address 100 and write the code part to the file. */
-    insertWords(file, code, STARTING_MEMORY_ADDRESS);
+    /* Start at address 100 and write the code part. */
+    insertWords(&output, code, STARTING_MEMORY_ADDRESS);
     /* Write at the end of the code part and write the data part. */
-    insertWords(file, data,
+    insertWords(&output, data,
                 (Address)instructionCount + STARTING_MEMORY_ADDRESS);
 
-    /* Close the no longer used file. */
+    /* Write the contents at once and close the no longer used file. */
+    writeTextBuffer(&output, file);
     fclose(file);
+    recordOutput("ob", &output);
 }
 
 Boolean generateEntFile(char fileName[], Label *entryLabels,
-                        FoundLabel *foundLabels, WordCount instructionCount,
+                        SymbolTable *symbols, WordCount instructionCount,
                         Boolean shouldGenerate) {
     FoundLabel *matchingFoundLabel; /* The entry label's possible defintion. */
     FILE *file;                     /* The .ent file. */
+    TextBuffer output;              /* The contents of the .ent file. */
     Length longest;                 /* The longest label's length. */
     Boolean isFirst; /* Whether this is the first label inserted. */
 
     /* Initialize the necessary variables. */
     isFirst = TRUE;
     file = NULL;
-    longest = getLongestLabel(fileName, entryLabels, FALSE, NULL);
+    initTextBuffer(&output);
+    longest = getLongestLabel(fileName, entryLabels, FALSE, symbols);
 
     /* Loop over the entry labels. */
     while (entryLabels != NULL) {
         /* Get the entry label's possible definition. */
-        matchingFoundLabel = getFoundLabel(foundLabels, entryLabels->name);
+        matchingFoundLabel = getSymbol(symbols, entryLabels->name)->definition;
 
         /* Check if there is no defintion. */
         if (matchingFoundLabel == NULL) {
@@ -97,7 +107,7 @@ Boolean generateEntFile(char fileName[], Label *entryLabels,
         }
 
         /* Insert the label's name and definition into the .ent file. */
-        insertLabelDefinition(file, entryLabels->name, matchingFoundLabel,
+        insertLabelDefinition(&output, entryLabels->name, matchingFoundLabel,
                               instructionCount, longest, isFirst);
 
         /* The first label has already been inserted. */
@@ -108,8 +118,10 @@ Boolean generateEntFile(char fileName[], Label *entryLabels,
 
     /* Check if a file was opened. */
     if (file != NULL) {
-        /* Close the file, as it is no longer needed. */
+        /* Write the contents at once and close the file. */
+        writeTextBuffer(&output, file);
         fclose(file);
+        recordOutput("ent", &output);
     }
 
     /* Return if the files after this one should be generated. */
@@ -117,20 +129,26 @@ Boolean generateEntFile(char fileName[], Label *entryLabels,
 }
 
 Boolean generateExtFile(char fileName[], Label *externLabels,
-                        UsedLabel *usedLabels, FoundLabel *foundLabels,
-                        Boolean shouldGenerate) {
-    FILE *file;      /* The .ext file. */
-    Length longest;  /* The length of the longest label. */
-    Boolean isFirst; /* Whether this is the first line inserted. */
+                        SymbolTable *symbols, Boolean shouldGenerate) {
+    FILE *file;        /* The .ext file. */
+    TextBuffer output; /* The contents of the .ext file. */
+    Length longest;    /* The length of the longest label. */
+    Boolean isFirst;   /* Whether this is the first line inserted. */
+    Symbol *symbol;    /* The current extern label's symbol. */
 
     /* Initialize the necessary variables. */
     file = NULL;
-    longest = getLongestLabel(fileName, externLabels, TRUE, usedLabels);
+    initTextBuffer(&output);
+    isFirst = TRUE;
+    longest = getLongestLabel(fileName, externLabels, TRUE, symbols);
 
     /* Loop over the extern labels. */
     while (externLabels != NULL) {
+        /* Get the symbol, which holds the definition and the uses. */
+        symbol = getSymbol(symbols, externLabels->name);
+
         /* Check if there is a definition of the current extern label. */
-        if (getFoundLabel(foundLabels, externLabels->name) != NULL) {
+        if (symbol->definition != NULL) {
             /* It is invalid for an extern label to have a definition. */
             printError("Label marked as .extern, but also defined.", fileName,
                        externLabels->lineNumber);
@@ -149,8 +167,8 @@ Boolean generateExtFile(char fileName[], Label *externLabels,
         }
 
         /* Insert all of the label's uses throughout the code. */
-        if (!insertUses(&file, fileName, externLabels, usedLabels, longest,
-                        &isFirst)) {
+        if (!insertUses(&file, &output, fileName, externLabels,
+                        symbol->firstUse, longest, &isFirst)) {
             /* There was a problem opening the .ext file. */
             return FALSE;
         }
@@ -161,74 +179,71 @@ Boolean generateExtFile(char fileName[], Label *externLabels,
 
     /* Check if the file was opened. */
     if (file != NULL) {
-        /* Close the file, as it is no longer used. */
+        /* Write the contents at once and close the file. */
+        writeTextBuffer(&output, file);
         fclose(file);
+        recordOutput("ext", &output);
     }
 
     /* Return if the files after this one should be generated. */
     return shouldGenerate;
 }
 
-void insertWords(FILE *file, Word *words, Address startingAddress) {
-    unsigned short shiftedData2; /* The shifted data2 of the current word. */
-
-    /* Loop over the list of words. */
-    while (words != NULL) {
-        /* Data2 needs to be shifted, as it represents the last 7 bits. */
-        shiftedData2 = (unsigned short)words->data2
-                       << (sizeof(words->data1) * BITS_PER_BYTE);
+void insertWords(TextBuffer *output, WordImage *words,
+                 Address startingAddress) {
+    WordCount index; /* The index of the current word. */
 
-        /* Insert the word, along with its address, into the file. */
-        fprintf(file, "\n%04hu %05o", startingAddress,
-                (unsigned short)words->data1 + shiftedData2);
+    /* Loop over the words in the image. */
+    for (index = INITIAL_VALUE; index < words->count; index++) {
+        /* Insert the word, along with its address, on a new line. */
+        appendChars(output, "\n", NEWLINE_BYTE);
+        appendDecimal(output, startingAddress, ADDRESS_DIGITS);
+        appendChars(output, " ", SINGLE_ENTRY);
+        appendOctal(output, words->words[index], WORD_DIGITS);
 
         /* Increment the address. */
         startingAddress++;
-        /* Move on to the next word. */
-        words = words->next;
     }
 }
 
-Boolean insertUses(FILE **file, char fileName[], Label *externLabel,
-                   UsedLabel *usedLabels, Length longest, Boolean *isFirst) {
-    /* Loop over the list of used labels. */
-    while (usedLabels != NULL) {
-        /* Compare the names to check if this is a use of the label. */
-        if (strcmp(externLabel->name, usedLabels->name) == EQUAL_STRINGS) {
-            /* Check if the .ext file has not been opened yet. */
+Boolean insertUses(FILE **file, TextBuffer *output, char fileName[],
+                   Label *externLabel, UsedLabel *uses, Length longest,
+                   Boolean *isFirst) {
+    /* Loop over the uses of the label. */
+    while (uses != NULL) {
+        /* Check if the .ext file has not been opened yet. */
+        if (*file == NULL) {
+            /* Try opening the .ext file. */
+            *file = openFile(fileName, "ext", "w");
+
+            /* Check if there was a problem opening the file. */
             if (*file == NULL) {
-                /* Try opening the .ext file. */
-                *file = openFile(fileName, "ext", "w");
-
-                /* Check if there was a problem opening the file. */
-                if (*file == NULL) {
-                    /* An error occurred. */
-                    return FALSE;
-                }
+                /* An error occurred. */
+                return FALSE;
             }
-
-            /* Insert the label, along with the address of its use. */
-            insertLabel(*file, externLabel->name, usedLabels->address, longest,
-                        *isFirst);
-            /* The first line has already been inserted. */
-            *isFirst = FALSE;
         }
 
-        /* Move on to the next label. */
-        usedLabels = usedLabels->next;
+        /* Insert the label, along with the address of its use. */
+        insertLabel(output, externLabel->name, uses->address, longest,
+                    *isFirst);
+        /* The first line has already been inserted. */
+        *isFirst = FALSE;
+
+        /* Move on to the next use. */
+        uses = uses->nextUse;
     }
 
     /* There have not been any errors. */
     return TRUE;
 }
 
-void insertLabelDefinition(FILE *file, char labelName[], FoundLabel *definition,
-                           WordCount instructionCount, Length longest,
-                           Boolean isFirst) {
+void insertLabelDefinition(TextBuffer *output, char labelName[],
+                           FoundLabel *definition, WordCount instructionCount,
+                           Length longest, Boolean isFirst) {
     /* Check if this is a data label. */
     if (definition->isData) {
         /* Insert the label, along with its address after the code part. */
-        insertLabel(file, labelName,
+        insertLabel(output, labelName,
                     definition->address + (Address)instructionCount +
                         STARTING_MEMORY_ADDRESS,
                     longest, isFirst);
@@ -236,19 +251,26 @@ void insertLabelDefinition(FILE *file, char labelName[], FoundLabel *definition,
     }
 
     /* Insert the label, along with its address. */
-    insertLabel(file, labelName, definition->address + STARTING_MEMORY_ADDRESS,
-                longest, isFirst);
+    insertLabel(output, labelName,
+                definition->address + STARTING_MEMORY_ADDRESS, longest,
+                isFirst);
 }
 
-void insertLabel(FILE *file, char labelName[], Address address, Length longest,
-                 Boolean isFirst) {
-    /* Insert the label, along with its address. Add newlines accordingly. */
-    fprintf(file, "%s%-*s %04hu", isFirst ? "" : "\n", longest, labelName,
-            address);
+void insertLabel(TextBuffer *output, char labelName[], Address address,
+                 Length longest, Boolean isFirst) {
+    /* Start a new line, unless this is the first label. */
+    if (!isFirst) {
+        appendChars(output, "\n", NEWLINE_BYTE);
+    }
+
+    /* Insert the label, along with its address. */
+    appendPadded(output, labelName, longest);
+    appendChars(output, " ", SINGLE_ENTRY);
+    appendDecimal(output, address, ADDRESS_DIGITS);
 }
 
 Length getLongestLabel(char fileName[], Label *labels, Boolean isExtern,
-                       UsedLabel *usedLabels) {
+                       SymbolTable *symbols) {
     Length longest;       /* The length of the longest label so far. */
     Length currentLength; /* The length of the current label. */
 
@@ -258,7 +280,7 @@ Length getLongestLabel(char fileName[], Label *labels, Boolean isExtern,
     /* Loop over the labels and check each one's length. */
     while (labels != NULL) {
         /* Check if this is an extern label that is unused. */
-        if (isExtern && !containsUsedLabel(usedLabels, labels->name)) {
+        if (isExtern && getSymbol(symbols, labels->name)->firstUse == NULL) {
             /* Print a warning. */
             printWarning("Unused extern label.", fileName, labels->lineNumber);
 
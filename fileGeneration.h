@@ -23,11 +23,11 @@
  * NOTE: The .ob file does not include a title before each part.
  *
  * <Instruction count> <Data count>
- * --- Code Part --- (Taken from the code list)
+ * --- Code Part --- (Taken from the code image)
  * <Address> <Word>
  * <Address> <Word>
  * ...
- * --- Data Part --- (Taken from the data list)
+ * --- Data Part --- (Taken from the data image)
  * <Address> <Word>
  * <Address> <Word>
  * ...
@@ -35,12 +35,12 @@
  * Assumes that the given file name is not NULL and is null-terminated.
  *
  * @param fileName The name of the .ob file to generate.
- * @param code List that represents the words in the code part.
- * @param data List that represents the words in the data part.
+ * @param code Image that holds the words in the code part.
+ * @param data Image that holds the words in the data part.
  * @param instructionCount The number of words in the code part.
  * @param dataCount The number of words in the data part.
  */
-void generateObFile(char fileName[], Word *code, Word *data,
+void generateObFile(char fileName[], WordImage *code, WordImage *data,
                     WordCount instructionCount, WordCount dataCount);
 
 /**
@@ -59,17 +59,18 @@ void generateObFile(char fileName[], Word *code, Word *data,
  * ...
  *
  * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that the given symbol table has been built from the label lists.
  *
  * @param fileName The name of the .ent file to generate.
  * @param entryLabels The list of labels marked as entry.
- * @param foundLabels The list of found labels to check for missing definitions.
+ * @param symbols The symbol table to check for missing definitions.
  * @param instructionCount The number of words in the code part.
  * @param shouldGenerate Whether the .ent file should be generated. If not, only
  * checks for missing definitions.
  * @return Whether or not more files should be generated after the .ent file.
  */
 Boolean generateEntFile(char fileName[], Label *entryLabels,
-                        FoundLabel *foundLabels, WordCount instructionCount,
+                        SymbolTable *symbols, WordCount instructionCount,
                         Boolean shouldGenerate);
 
 /**
@@ -85,113 +86,121 @@ Boolean generateEntFile(char fileName[], Label *entryLabels,
  * ...
  *
  * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that the given symbol table has been built from the label lists.
  *
  * @param fileName The name of the .ext file to generate.
  * @param externLabels The list of labels marked as extern.
- * @param usedLabels The list of used labels to check for every instance of the
- * labels.
- * @param foundLabels The list of found labels to check for labels that are
- * extern and also defined (invalid).
+ * @param symbols The symbol table to check for every use of the labels, and
+ * for labels that are extern and also defined (invalid).
  * @param shouldGenerate Whether the .ext file should be generated. If not, only
  * checks for errors.
  * @return Whether or not more files should be generated after the .ext file.
  */
 Boolean generateExtFile(char fileName[], Label *externLabels,
-                        UsedLabel *usedLabels, FoundLabel *foundLabels,
-                        Boolean shouldGenerate);
+                        SymbolTable *symbols, Boolean shouldGenerate);
 
 /**
- * Inserts the given list of words into the given file.
+ * Inserts the words of the given image into the given output contents.
  * The address of the first word will be the given starting address.
  * The following addresses will be automatically incremented by one each
  * time.
  *
- * Assumes that the given file pointer is not NULL.
+ * Assumes that the given output pointer is not NULL.
  * Assumes that the starting address is valid, so that all the words will
  * fit in the made-up memory until address 4095.
  *
- * @param file The file to insert the words into.
- * @param words The list of words to insert.
- * @param startingAddress The address of the first word in the list.
+ * @param output The contents of the file to insert the words into.
+ * @param words The image of the words to insert.
+ * @param startingAddress The address of the first word in the image.
  */
-void insertWords(FILE *file, Word *words, Address startingAddress);
+void insertWords(TextBuffer *output, WordImage *words,
+                 Address startingAddress);
 
 /**
- * Inserts all the uses of the given extern label into the given file.
+ * Inserts all the uses of the given extern label into the given output
+ * contents.
+ * Opens the .ext file before inserting the first use, if it has not been opened
+ * yet.
+ * Returns FALSE if there was a problem opening the file, TRUE otherwise.
  *
  * Assumes that the given pointer to the file pointer is not NULL.
+ * Assumes that the given output pointer is not NULL.
  * Assumes that the given file name is not NULL and is null-terminated.
  * Assumes that the given label name string is not NULL and is null-terminated.
  * Assumes that the given isFirst boolean pointer is not NULL.
  *
- * @param file The file to insert the uses into.
+ * @param file The .ext file (NULL if it has not been opened yet).
+ * @param output The contents of the .ext file to insert the uses into.
  * @param fileName The name of the file to insert the uses into.
  * @param externLabel The extern label to insert.
- * @param usedLabels The list of used labels to scan.
+ * @param uses The first use of the label (the next ones are chained to it).
  * @param longest The number of characters in the longest label.
  * @param isFirst Whether this is the first label inserted.
+ * @return TRUE if there were no problems opening the file, FALSE otherwise.
  */
-Boolean insertUses(FILE **file, char fileName[], Label *externLabel,
-                   UsedLabel *usedLabels, Length longest, Boolean *isFirst);
+Boolean insertUses(FILE **file, TextBuffer *output, char fileName[],
+                   Label *externLabel, UsedLabel *uses, Length longest,
+                   Boolean *isFirst);
 
 /**
- * Inserts the given label definition into the given file.
+ * Inserts the given label definition into the given output contents.
  *
- * Assumes that the given file pointer is not NULL.
+ * Assumes that the given output pointer is not NULL.
  * Assumes that the given label name string is not NULL and is null-terminated.
  * Assumes that the given found label is not NULL.
  *
- * @param file The file to insert the label definition into.
+ * @param output The contents of the file to insert the label definition into.
  * @param labelName The name of the label to insert.
  * @param definition The found label that defines the target label.
  * @param instructionCount The final instruction count.
  * @param longest The number of characters in the longest label.
  * @param isFirst Whether this is the first label inserted.
  */
-void insertLabelDefinition(FILE *file, char labelName[], FoundLabel *definition,
-                           WordCount instructionCount, Length longest,
-                           Boolean isFirst);
+void insertLabelDefinition(TextBuffer *output, char labelName[],
+                           FoundLabel *definition, WordCount instructionCount,
+                           Length longest, Boolean isFirst);
 
 /**
- * Inserts the given label into the given file, along with an address.
+ * Inserts the given label into the given output contents, along with an
+ * address.
  * Pads the label with spaces to the right using the longest label's length, so
  * that all the labels line up properly.
  * Pads the address with zeros to the left, so that every address is 4 digits
  * long.
  *
- * Assumes that the given file pointer is not NULL.
+ * Assumes that the given output pointer is not NULL.
  * Assumes that the given label name string is not NULL and is
  * null-terminated. Assumes that the given address is between 100 and 4095,
  * inclusive (to fit in the made-up memory). Assumes that the given longest
  * label's length is the number of characters in the longest label.
  *
- * @param file The file to insert the label into.
+ * @param output The contents of the file to insert the label into.
  * @param labelName The name of the label to insert.
  * @param address The address associated with the label.
  * @param longest The number of characters in the longest label.
  * @param isFirst Whether this is the first label to be inserted into some
  * file.
  */
-void insertLabel(FILE *file, char labelName[], Address address, Length longest,
-                 Boolean isFirst);
+void insertLabel(TextBuffer *output, char labelName[], Address address,
+                 Length longest, Boolean isFirst);
 
 /**
  * Computes and returns the length of the longest label in the given label list.
  * If the labels are extern, the calculation does not include the extern labels
  * that are unused.
- * Uses the given list of used labels to check for unused extern labels.
+ * Uses the given symbol table to check for unused extern labels.
  * If an extern label is unused, prints a warning to stdout.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that the given symbol table has been built from the label lists.
  *
  * @param fileName The name of the current file (for warnings).
  * @param labels The label list to compute the length of the longest label in.
  * @param isExtern Whether the labels are extern or not (entry).
- * @param usedLabels The list of used labels to use to check for unused extern
- * labels.
+ * @param symbols The symbol table to use to check for unused extern labels.
  * @return The length of the longest label in the given label list.
  */
 Length getLongestLabel(char fileName[], Label *labels, Boolean isExtern,
-                       UsedLabel *usedLabels);
+                       SymbolTable *symbols);
 
 #endif
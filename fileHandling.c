@@ -11,20 +11,25 @@
 
 #include "fileHandling.h"
 
-#include <stdlib.h> /* exit. */
+#include <stdlib.h> /* exit, free. */
 
+#include "arena.h" /* Taking back the memory of each file and freeing it at the end. */
+#include "chunkedReading.h" /* Parsing the lines of a large file at the same time. */
 #include "errorHandling.h" /* Printing an error if no files have been provided. */
 #include "fileGeneration.h" /* Generating the .ob, .ent and .ext files. */
-#include "fileReading.h"    /* Reading the .am file. */
-#include "foundLabelList.h" /* Freeing the found label list. */
-#include "freeingLogic.h" /* Setting the pointers to each linked list in case of an allocation failure. */
-#include "globals.h"      /* Constants and typedefs. */
+#include "freeingLogic.h"   /* Getting the arena of the current thread. */
+#include "globals.h"        /* Constants and typedefs. */
 #include "labelLinking.h" /* Linking all the used labels with their definitions. */
-#include "labelList.h"    /* Freeing the 2 label lists. */
-#include "macroExpansion.h" /* Expanding the macros in the .as file to generate the .am file. */
-#include "macroTable.h"    /* Freeing the macro table. */
-#include "usedLabelList.h" /* Freeing the used label list. */
-#include "wordList.h" /* Creating dummy nodes and freeing the 2 word lists. */
+#include "macroExpansion.h" /* Expanding the macros in the .as file to generate the expanded text. */
+#include "macroTable.h"  /* Emptying the macro table. */
+#include "outputCache.h" /* Restoring unchanged files from the cache. */
+#include "pipeline.h"    /* Parsing large files while they are expanded. */
+#include "symbolTable.h" /* Building the symbol table. */
+#include "textBuffer.h"  /* Emptying the expanded text. */
+#include "timeReport.h"  /* Timing the phases of each file. */
+#include "utils.h"       /* Allocating memory. */
+#include "wordImage.h"   /* Emptying the 2 word images. */
+#include "workerPool.h" /* Compiling the files on a pool of worker threads. */
 
 void handleNoFiles(int fileCount) {
     if (fileCount == NO_FILES) {
@@ -33,103 +38,205 @@ void handleNoFiles(int fileCount) {
     }
 }
 
-void compileAllFiles(char *fileNames[], int fileCount) {
-    Word *code = NULL; /* The words in the code part. */
-    Word *data = NULL; /* The words in the data part. */
+void compileAllFiles(char *fileNames[], int fileCount, Options *options) {
+    FileReport *reports; /* The time report of each file (NULL if none). */
+    double startTime;    /* The time at which the compilation started. */
 
-    Macro *macros = NULL;           /* The macro table. */
+    /* Check if the time of each phase should be reported. */
+    reports = NULL;
+    startTime = EMPTY;
+    if (options->shouldReportTime) {
+        reports = allocate(sizeof(FileReport) * fileCount);
+        startTime = getMonotonicTime();
+    }
+
+    /* Create the cache directory, if the outputs are cached. */
+    openCache(options);
+
+    /* A single file gets all the jobs, to parse its lines at the same time. */
+    options->parseJobCount =
+        fileCount == SINGLE_FILE ? options->jobCount : DEFAULT_JOB_COUNT;
+
+    /* Check if more than one file should be compiled at the same time. */
+    if (options->jobCount > DEFAULT_JOB_COUNT && fileCount > SINGLE_FILE) {
+        compileFilesInParallel(fileNames, fileCount, options, reports);
+    } else {
+        /* Compile the files one after another. */
+        compileFiles(fileNames, fileCount, options, reports);
+    }
+
+    /* The blocks kept for the next files are no longer needed. */
+    freeArena(getFileArena());
+
+    /* Check if the time of each phase should be reported. */
+    if (reports != NULL) {
+        printTimeReport(reports, fileCount, getMonotonicTime() - startTime);
+        free(reports);
+    }
+
+    /* Check if the outputs were cached. */
+    if (options->cacheDirectory != NULL) {
+        printCacheStatistics();
+    }
+}
+
+void compileFiles(char *fileNames[], int fileCount, Options *options,
+                  FileReport reports[]) {
+    WordImage code;                 /* The words in the code part. */
+    WordImage data;                 /* The words in the data part. */
+    MacroTable macros;              /* The macro table. */
+    TextBuffer expanded;            /* The macro-expanded text. */
     Label *entryLabels = NULL;      /* The entry labels list. */
     Label *externLabels = NULL;     /* The extern labels list. */
     UsedLabel *usedLabels = NULL;   /* The used labels list. */
     FoundLabel *foundLabels = NULL; /* The found labels list. */
-
-    /* In case of an allocation failure, make it possible to free the lists. */
-    setToFree(&code, &data, &macros, &entryLabels, &externLabels, &usedLabels,
-              &foundLabels);
+    SymbolTable symbols;            /* The symbol table. */
+    CacheEntry entry;               /* The cache entry of the current file. */
 
     /* Compile each file separately. */
     while (fileCount > NO_FILES) {
-        /* Create dummy nodes, so that the words will be ordered. */
-        code = createWord();
-        data = createWord();
-
-        /* Order does not matter, so set the other lists to NULL. */
-        macros = NULL;
+        /* Start both parts with no words. */
+        initWordImage(&code);
+        initWordImage(&data);
+
+        /* Order does not matter, so empty the table and the other lists. */
+        initMacroTable(&macros);
+        initTextBuffer(&expanded);
+        initSymbolTable(&symbols);
         entryLabels = NULL;
         externLabels = NULL;
         usedLabels = NULL;
         foundLabels = NULL;
 
-        /* Start compiling the current file. */
-        compileFile(*fileNames, code, data, macros, entryLabels, externLabels,
-                    usedLabels, foundLabels);
-
-        /* Move on to the next file. */
+        /* Restore the outputs of an unchanged file from the cache instead. */
+        if (!restoreCachedFile(*fileNames, options, &entry, reports)) {
+            /* Start compiling the current file, recording it for the cache. */
+            startCacheEntry(&entry);
+            compileFile(*fileNames, options, &code, &data, &macros, &expanded,
+                        entryLabels, externLabels, usedLabels, foundLabels,
+                        &symbols, reports);
+            finishCacheEntry(&entry);
+        }
+
+        /* Move on to the next file (and its report, if there is one). */
         fileCount--;
         fileNames++;
+        if (reports != NULL) {
+            reports++;
+        }
     }
 }
 
-void compileFile(char fileName[], Word *code, Word *data, Macro *macros,
-                 Label *entryLabels, Label *externLabels, UsedLabel *usedLabels,
-                 FoundLabel *foundLabels) {
+void compileFile(char fileName[], Options *options, WordImage *code,
+                 WordImage *data, MacroTable *macros, TextBuffer *expanded,
+                 Label *entryLabels, Label *externLabels,
+                 UsedLabel *usedLabels, FoundLabel *foundLabels,
+                 SymbolTable *symbols, FileReport *report) {
     WordCount instructionCount;  /* The number of words in the code part. */
     WordCount dataCount;         /* The number of words in the data part. */
     Boolean shouldGenerateFiles; /* Whether or not to generate output files. */
+    double phaseStart;           /* The time the current phase started. */
+    ParsingStage stage;          /* The parsing while the file is expanded. */
+    Boolean hasStage;            /* Whether the parsing stage has started. */
+    Boolean isExpanded;          /* Whether the macro expansion succeeded. */
+    ChunkedReading chunked;      /* The ranges of lines parsed at once. */
 
     /* Initialize the word counts. */
     instructionCount = INITIAL_VALUE;
     dataCount = INITIAL_VALUE;
 
+    /* Start timing the phases, if the time is reported. */
+    initFileReport(report, fileName);
+    phaseStart = startPhase(report);
+
+    /* Start with no ranges of lines. */
+    chunked.chunks = NULL;
+    chunked.count = EMPTY;
+
+    /* Start parsing a large file on another thread while it is expanded,
+     * unless it has jobs to parse its ranges of lines at the same time. */
+    hasStage = options->parseJobCount == DEFAULT_JOB_COUNT &&
+               isLargeSource(fileName) && startParsingStage(&stage, fileName);
+
     /* Try expanding the macros in the .as file. */
-    if (!expandMacros(fileName, &macros)) {
-        /* Move on to the next file. */
-        freeMacroTable(macros);
+    isExpanded = expandMacros(fileName, macros, expanded, options,
+                              hasStage ? &stage.ring : NULL);
+    phaseStart = endPhase(report, EXPANSION_PHASE, phaseStart);
+
+    /* Wait for the parsing thread, and check if its results can be kept. */
+    if (hasStage && finishParsingStage(&stage, isExpanded, macros)) {
+        /* Take everything the parsing thread has put in its lists. */
+        *code = stage.code;
+        *data = stage.data;
+        entryLabels = stage.entryLabels;
+        externLabels = stage.externLabels;
+        usedLabels = stage.usedLabels;
+        foundLabels = stage.foundLabels;
+        instructionCount = stage.instructionCount;
+        dataCount = stage.dataCount;
+        shouldGenerateFiles = stage.isSuccessful;
+    } else if (isExpanded) {
+        /* Read the expanded lines (in ranges, per the jobs) into the lists. */
+        shouldGenerateFiles = readFileInChunks(
+            fileName, expanded, macros, code, data, &entryLabels, &externLabels,
+            &usedLabels, &foundLabels, &instructionCount, &dataCount,
+            options->parseJobCount, &chunked);
+    } else {
+        recordCounts(report, expanded, EMPTY, macros, symbols);
+        /* Take back the file's memory and move on to the next file. */
+        releaseFileMemory(hasStage ? &stage : NULL, &chunked);
         return;
     }
+    phaseStart = endPhase(report, READING_PHASE, phaseStart);
 
-    /* Read the .am file and put everything in the lists. */
-    shouldGenerateFiles =
-        readFile(fileName, macros, code, data, &entryLabels, &externLabels,
-                 &usedLabels, &foundLabels, &instructionCount, &dataCount);
-
-    /* The macro table is no longer needed. */
-    freeMacroTable(macros);
+    /* Gather everything that is known about each label in one place. */
+    buildSymbolTable(symbols, entryLabels, externLabels, usedLabels,
+                     foundLabels);
 
     /* Try linking all the used labels with their definitions. */
-    if (!linkLabels(fileName, externLabels, usedLabels, foundLabels,
-                    instructionCount)) {
+    if (!linkLabels(fileName, code, symbols, usedLabels, instructionCount)) {
         shouldGenerateFiles = FALSE;
     }
+    phaseStart = endPhase(report, LINKING_PHASE, phaseStart);
 
     /* Try generating the .ent file. */
-    if (!generateEntFile(fileName, entryLabels, foundLabels, instructionCount,
+    if (!generateEntFile(fileName, entryLabels, symbols, instructionCount,
                          shouldGenerateFiles)) {
         shouldGenerateFiles = FALSE;
     }
-
-    /* The entry labels are no longer needed. */
-    freeLabelList(entryLabels);
+    phaseStart = endPhase(report, ENT_PHASE, phaseStart);
 
     /* Try generating the .ext file. */
-    if (!generateExtFile(fileName, externLabels, usedLabels, foundLabels,
+    if (!generateExtFile(fileName, externLabels, symbols,
                          shouldGenerateFiles)) {
         shouldGenerateFiles = FALSE;
     }
-
-    /* The extern, used and found labels are no longer needed. */
-    freeLabelList(externLabels);
-    freeUsedLabelList(usedLabels);
-    freeFoundLabelList(foundLabels);
+    phaseStart = endPhase(report, EXT_PHASE, phaseStart);
 
     /* Check if the .ob file should be generated. */
     if (shouldGenerateFiles) {
-        /* Generate the .ob file (skip the dummy nodes). */
-        generateObFile(fileName, code->next, data->next, instructionCount,
-                       dataCount);
+        /* Generate the .ob file. */
+        generateObFile(fileName, code, data, instructionCount, dataCount);
+    }
+    endPhase(report, OB_PHASE, phaseStart);
+
+    /* Count what the phases went through, before it is taken back. */
+    recordCounts(report, expanded, instructionCount + dataCount, macros,
+                 symbols);
+
+    /* Take back all the file's memory at once, keeping it for the next file. */
+    releaseFileMemory(hasStage ? &stage : NULL, &chunked);
+}
+
+void releaseFileMemory(ParsingStage *stage, ChunkedReading *chunked) {
+    /* Take back the memory of the file, keeping it for the next file. */
+    resetArena(getFileArena());
+
+    /* Free the memory of the parsing thread, if the file had one. */
+    if (stage != NULL) {
+        freeArena(&stage->toFree.arena);
     }
 
-    /* The word lists are no longer needed. */
-    freeWordList(code);
-    freeWordList(data);
+    /* Free the memory of the ranges of lines, if there were any. */
+    releaseChunks(chunked);
 }
@@ -28,32 +28,85 @@ void handleNoFiles(int fileCount);
 /**
  * Starts the compilation process of the provided files.
  * Compiles each file separately.
+ * If more than one job is requested, compiles the files on a pool of worker
+ * threads. Otherwise, compiles them one after another.
+ * Frees the calling thread's arena once all the files are done.
+ * If --time-report is given, prints how long each phase of each file took to
+ * stderr once all the files are done.
+ * If --cache is given, prints how many files were restored from the cache and
+ * how many were compiled to stderr once all the files are done.
  *
  * Assumes that the given file names array is not NULL and contains only
  * non-NULL and null-terminated file names.
  * Assumes that the given file count is the number of file names to try to
  * compile from the given file names array.
+ * Assumes that the given options pointer is not NULL.
  *
  * @param fileNames The names of the files to compile.
  * @param fileCount The number of files to compile.
+ * @param options The options given as command line arguments.
  */
-void compileAllFiles(char *fileNames[], int fileCount);
+void compileAllFiles(char *fileNames[], int fileCount, Options *options);
+
+/**
+ * Compiles the provided files one after another, on the calling thread.
+ * Compiles each file separately, reusing the calling thread's arena.
+ * A file whose outputs are in the cache is restored instead, and any other
+ * file is recorded in the cache as it is compiled (if --cache is given).
+ *
+ * Assumes that the given file names array is not NULL and contains only
+ * non-NULL and null-terminated file names.
+ * Assumes that the given file count is the number of file names to try to
+ * compile from the given file names array.
+ * Assumes that the given options pointer is not NULL.
+ *
+ * @param fileNames The names of the files to compile.
+ * @param fileCount The number of files to compile.
+ * @param options The options given as command line arguments.
+ * @param reports The time report of each file, in the same order (NULL if the
+ * time is not reported).
+ */
+void compileFiles(char *fileNames[], int fileCount, Options *options,
+                  FileReport reports[]);
 
 /**
  * Compiles the given file.
  * Uses the given lists to store the current compilation state.
+ * Large files are parsed on another thread while their macros are expanded,
+ * or in ranges of lines on several threads if the file has several jobs.
+ * Takes back everything allocated from the calling thread's arena once the file
+ * is done, so the lists must not be used afterwards.
  *
  * @param fileName The name of the file to compile.
+ * @param options The options given as command line arguments.
  * @param code The words in the code part.
  * @param data The words in the data part.
  * @param macros The macro table.
+ * @param expanded The macro-expanded text.
  * @param entryLabels The entry labels list.
  * @param externLabels The extern labels list.
  * @param usedLabels The used labels list.
  * @param foundLabels The found labels list.
+ * @param symbols The symbol table.
+ * @param report The time report of the file (NULL if the time is not
+ * reported).
+ */
+void compileFile(char fileName[], Options *options, WordImage *code,
+                 WordImage *data, MacroTable *macros, TextBuffer *expanded,
+                 Label *entryLabels, Label *externLabels,
+                 UsedLabel *usedLabels, FoundLabel *foundLabels,
+                 SymbolTable *symbols, FileReport *report);
+
+/**
+ * Takes back the memory of the file that has just been compiled, from the
+ * calling thread's arena, from the arena of its parsing thread (if it had
+ * one) and from the arenas of its ranges of lines (if it had any).
+ *
+ * Assumes that the given ranges pointer is not NULL.
+ *
+ * @param stage The parsing stage of the file, or NULL if it had none.
+ * @param chunked The ranges of lines of the file.
  */
-void compileFile(char fileName[], Word *code, Word *data, Macro *macros,
-                 Label *entryLabels, Label *externLabels, UsedLabel *usedLabels,
-                 FoundLabel *foundLabels);
+void releaseFileMemory(ParsingStage *stage, ChunkedReading *chunked);
 
 #endif
@@ -1,8 +1,8 @@
 /*
  * fileReading.c
  *
- * Contains functions to read the .am file, which was generated by the macro
- * expansion stage.
+ * Contains functions to read the macro-expanded lines, which were generated in
+ * memory by the macro expansion stage.
  * Gets everything ready to link the labels and then to generate the necessary
  * files.
  *
@@ -14,80 +14,94 @@
 
 #include "fileReading.h"
 
-#include <stdlib.h> /* free. */
-#include <string.h> /* strcmp. */
-
 #include "encoder.h"        /* Encoding into words. */
 #include "errorHandling.h"  /* Printing errors and warnings. */
-#include "foundLabelList.h" /* Searching through the found label list. */
+#include "foundLabelList.h" /* Adding labels that are defined. */
 #include "globals.h"        /* Constants and typedefs. */
 #include "instructionInformation.h" /* Information about the different instructions. */
-#include "labelList.h" /* Searching through the entry and extern label lists. */
+#include "labelList.h" /* Adding entry and extern labels. */
+#include "lexer.h"     /* Splitting each line into tokens. */
 #include "lineValidation.h" /* Validating lines before adding new words. */
 #include "macroTable.h"     /* Searching through the macro table. */
+#include "pipeline.h"       /* Taking the lines that are still expanded. */
+#include "symbolTable.h"    /* Looking up the labels defined so far. */
+#include "textBuffer.h"     /* Reading the expanded lines one by one. */
 #include "usedLabelList.h"  /* Adding labels that are used as operands. */
-#include "utils.h"          /* Opening the .am file and parsing lines. */
-#include "wordList.h"       /* Adding new words. */
-
-Boolean readFile(char fileName[], Macro *macros, Word *code, Word *data,
-                 Label **entryLabels, Label **externLabels,
-                 UsedLabel **usedLabels, FoundLabel **foundLabels,
-                 WordCount *instructionCount, WordCount *dataCount) {
-    Boolean isSuccessful; /* Whether no errors were found. */
-    FILE *file;           /* The file to read. */
-
-    /* Open the .am file. */
-    file = openFile(fileName, "am", "r");
-
-    /* Check if there was a problem opening the file. */
-    if (file == NULL) {
-        return FALSE;
-    }
-
-    /* Read the lines of the .am file. */
-    isSuccessful =
-        readLines(fileName, file, macros, code, data, entryLabels, externLabels,
-                  usedLabels, foundLabels, instructionCount, dataCount);
-
-    /* Close the .am file. */
-    fclose(file);
-    /* Return whether no errors were found. */
-    return isSuccessful;
+#include "utils.h"          /* Copying names that are kept. */
+#include "wordImage.h"      /* Adding new words. */
+
+Boolean readFile(char fileName[], TextBuffer *expanded, MacroTable *macros,
+                 WordImage *code, WordImage *data, Label **entryLabels,
+                 Label **externLabels, UsedLabel **usedLabels,
+                 FoundLabel **foundLabels, WordCount *instructionCount,
+                 WordCount *dataCount) {
+    /* Read the expanded lines from the start. */
+    expanded->position = INITIAL_VALUE;
+
+    /* Read the lines and return whether no errors were found. */
+    return readLines(fileName, expanded, NULL, macros, code, data, entryLabels,
+                     externLabels, usedLabels, foundLabels, instructionCount,
+                     dataCount);
 }
 
-Boolean readLines(char fileName[], FILE *file, Macro *macros, Word *code,
-                  Word *data, Label **entryLabels, Label **externLabels,
+Boolean readLines(char fileName[], TextBuffer *expanded, LineRing *ring,
+                  MacroTable *macros, WordImage *code, WordImage *data,
+                  Label **entryLabels, Label **externLabels,
                   UsedLabel **usedLabels, FoundLabel **foundLabels,
                   WordCount *instructionCount, WordCount *dataCount) {
     Boolean isSuccessful; /* Whether no errors were found. */
+    TokenLine tokens;     /* The tokens of the current line. */
+    ParsedLine parsed;    /* What has been found while validating the line. */
     char line[MAX_LINE_LENGTH + NEWLINE_BYTE + NULL_BYTE]; /* Current line. */
     LineNumber lineNumber;                                 /* Line number. */
+    SymbolTable symbols;  /* The labels defined or declared so far. */
+    FoundLabel *found;    /* The current label that is already defined. */
+    Label *declared;      /* The current label that is already declared. */
 
     /* Initialize the necessary variables. */
     isSuccessful = TRUE;
     lineNumber = INITIAL_VALUE;
 
-    /* Read each line of the .am file. */
-    while (fgets(line, sizeof(line), file) != NULL) {
+    /* Look up the labels that are already defined or declared in a table,
+     * not in the lists. */
+    initSymbolTable(&symbols);
+    for (found = *foundLabels; found != NULL; found = found->next) {
+        addSymbol(&symbols, found->name)->definition = found;
+    }
+    for (declared = *entryLabels; declared != NULL; declared = declared->next) {
+        addSymbol(&symbols, declared->name)->isEntry = TRUE;
+    }
+    for (declared = *externLabels; declared != NULL;
+         declared = declared->next) {
+        addSymbol(&symbols, declared->name)->isExtern = TRUE;
+    }
+
+    /* Read each line of the expanded text (or of the ring, as it arrives). */
+    while (readNextLine(line, expanded, ring)) {
         /* Update the line number. */
         lineNumber++;
 
+        /* Split the line into tokens, once for all the stages. */
+        lexLine(line, &tokens);
+
         /* Check if the line is invalid before encoding it into words. */
-        if (!validateLine(line, fileName, lineNumber)) {
+        if (!validateLine(&tokens, &parsed, fileName, lineNumber)) {
             /* Do not generate output files. */
             isSuccessful = FALSE;
             /* Still check for a label for better error handling. */
-            handleLabel(fileName, skipWhitespace(line), lineNumber, macros,
+            handleLabel(fileName, &tokens, lineNumber, macros, &symbols,
                         foundLabels, *instructionCount, *dataCount);
             /* Move on to the next line. */
             continue;
         }
 
         /* Handle the current line. */
-        isSuccessful = handleLine(fileName, line, lineNumber, macros, &code,
-                                  &data, entryLabels, externLabels, usedLabels,
-                                  foundLabels, instructionCount, dataCount) &&
-                       isSuccessful;
+        isSuccessful =
+            handleLine(fileName, &tokens, &parsed, lineNumber, macros, code,
+                       data, entryLabels, externLabels, usedLabels,
+                       &symbols, foundLabels, instructionCount,
+                       dataCount) &&
+            isSuccessful;
 
         /* Check if memory overflow has occurred. */
         if (*instructionCount + *dataCount >
@@ -103,154 +117,153 @@ Boolean readLines(char fileName[], FILE *file, Macro *macros, Word *code,
     return isSuccessful;
 }
 
-Boolean handleLine(char fileName[], char line[], LineNumber lineNumber,
-                   Macro *macros, Word **code, Word **data, Label **entryLabels,
-                   Label **externLabels, UsedLabel **usedLabels,
+Boolean readNextLine(char line[], TextBuffer *expanded, LineRing *ring) {
+    /* Check if the lines arrive in a ring while they are expanded. */
+    if (ring != NULL) {
+        return takeExpandedLine(ring, line);
+    }
+
+    /* Read the next line of the whole expanded text. */
+    return readTextLine(line, RING_SLOT_SIZE, expanded) != NULL;
+}
+
+Boolean handleLine(char fileName[], TokenLine *tokens, ParsedLine *parsed,
+                   LineNumber lineNumber, MacroTable *macros, WordImage *code,
+                   WordImage *data, Label **entryLabels, Label **externLabels,
+                   UsedLabel **usedLabels, SymbolTable *symbols,
                    FoundLabel **foundLabels, WordCount *instructionCount,
                    WordCount *dataCount) {
     Boolean isSuccessful; /* Whether no errors were found. */
+    Index index;          /* The index of the current token. */
     char *token;          /* The current token. */
     char *nextToken;      /* The next token. */
+    Symbol *symbol;       /* The symbol of the declared label. */
 
     /* Skip comment lines. */
-    if (*line == ';') {
+    if (*tokens->line == ';') {
         return TRUE;
     }
 
-    /* Skip the whitespace. */
-    line = skipWhitespace(line);
+    /* Find the first word. */
+    index = findNextWord(tokens, FIRST_INDEX);
 
     /* Skip empty lines. */
-    if (*line == '\0') {
+    if (index == tokens->count) {
         return TRUE;
     }
 
     /* Handle a possible label attached to the line. */
-    isSuccessful = handleLabel(fileName, line, lineNumber, macros, foundLabels,
-                               *instructionCount, *dataCount);
-    /* Get the first token. */
-    token = getNextToken(line);
-    /* Get the second token. */
-    nextToken = getNextToken(skipWhitespace(skipCharacters(line)));
+    isSuccessful =
+        handleLabel(fileName, tokens, lineNumber, macros, symbols,
+                    foundLabels, *instructionCount, *dataCount);
 
     /* Skip the possible label. */
-    if (checkIfLabel(token)) {
-        /* Make the first token the second. */
-        free(token);
-        token = nextToken;
-
-        /* Make the second token the third. */
-        line = skipCharacters(line);
-        line = skipWhitespace(line);
-        nextToken = getNextToken(skipWhitespace(skipCharacters(line)));
+    if (tokens->tokens[index].kind == LABEL_TOKEN) {
+        index = findNextWord(tokens, index + SINGLE_ENTRY);
     }
 
-    /* Handle every type of line. */
-    if (strcmp(token, ".entry") == EQUAL_STRINGS) {
+    /* Get the first token after the label and the token after it. */
+    token = getTokenText(tokens, index);
+    nextToken =
+        getTokenText(tokens, findNextWord(tokens, index + SINGLE_ENTRY));
+
+    /* Handle every type of line (its keyword was found by the lexer). */
+    if (tokens->keyword == ENTRY_KEYWORD) {
         /* Check for name collisions with macros. */
         if (getMacroContent(macros, token) != NULL) {
-            free(token);
-            free(nextToken);
             printError("Label's name already taken by a macro.", fileName,
                        lineNumber);
             return FALSE;
         }
 
         /* Check for duplicate .entry declarations. */
-        if (containsLabel(*entryLabels, nextToken)) {
+        symbol = getSymbol(symbols, nextToken);
+        if (symbol != NULL && symbol->isEntry) {
             /* THIS IS ONLY A WARNING. */
-            free(token);
-            free(nextToken);
             printWarning("Label already declared as entry.", fileName,
                          lineNumber);
             return isSuccessful;
         }
 
-        /* Add the label to the list of entry labels. */
-        addLabel(entryLabels, nextToken, lineNumber);
-    } else if (strcmp(token, ".extern") == EQUAL_STRINGS) {
+        /* Add a copy of the label to the list of entry labels, and mark it in
+         * the table. */
+        addLabel(entryLabels, copyStringForFile(nextToken), lineNumber);
+        addSymbol(symbols, (*entryLabels)->name)->isEntry = TRUE;
+    } else if (tokens->keyword == EXTERN_KEYWORD) {
         /* Check for name collisions with macros. */
         if (getMacroContent(macros, token) != NULL) {
-            free(token);
-            free(nextToken);
             printError("Label's name already taken by a macro.", fileName,
                        lineNumber);
             return FALSE;
         }
 
         /* Check for duplicate .extern declarations. */
-        if (containsLabel(*externLabels, nextToken)) {
+        symbol = getSymbol(symbols, nextToken);
+        if (symbol != NULL && symbol->isExtern) {
             /* THIS IS ONLY A WARNING. */
-            free(token);
-            free(nextToken);
             printWarning("Label already declared as extern.", fileName,
                          lineNumber);
             return isSuccessful;
         }
 
-        /* Add the label to the list of extern labels. */
-        addLabel(externLabels, nextToken, lineNumber);
-    } else if (strcmp(token, ".data") == EQUAL_STRINGS) {
-        /* Encode the .data number list into words. */
-        free(nextToken);
-        encodeNumberList(data, skipWhitespace(skipCharacters(line)), dataCount);
-    } else if (strcmp(token, ".string") == EQUAL_STRINGS) {
+        /* Add a copy of the label to the list of extern labels, and mark it in
+         * the table. */
+        addLabel(externLabels, copyStringForFile(nextToken), lineNumber);
+        addSymbol(symbols, (*externLabels)->name)->isExtern = TRUE;
+    } else if (tokens->keyword == DATA_KEYWORD) {
+        /* Encode the .data numbers (kept while validating) into words. */
+        encodeNumberList(data, parsed->numbers, parsed->numberCount,
+                         dataCount);
+    } else if (tokens->keyword == STRING_KEYWORD) {
         /* Encode the .string characters into words. */
-        free(nextToken);
-        encodeString(data, skipWhitespace(skipCharacters(line)), dataCount);
+        encodeString(data,
+                     getRestOfLine(tokens,
+                                   findNextWord(tokens, index + SINGLE_ENTRY)),
+                     dataCount);
     } else {
         /* Encode actual operations into words. */
-        free(nextToken);
-        handleOperation(line, lineNumber, code, usedLabels, instructionCount);
+        handleOperation(tokens->keyword, parsed, lineNumber, code, usedLabels,
+                        instructionCount);
     }
 
-    /* Do not free the next token because it might be used as a label's name. */
-    free(token);
     /* Return whether no errors were found. */
     return isSuccessful;
 }
 
-Boolean handleLabel(char fileName[], char line[], LineNumber lineNumber,
-                    Macro *macros, FoundLabel **foundLabels,
-                    WordCount instructionCount, WordCount dataCount) {
-    char *token;     /* The current token. */
-    char *nextToken; /* The next token. */
+Boolean handleLabel(char fileName[], TokenLine *tokens, LineNumber lineNumber,
+                    MacroTable *macros, SymbolTable *symbols,
+                    FoundLabel **foundLabels, WordCount instructionCount,
+                    WordCount dataCount) {
+    Index index;    /* The index of the current token. */
+    char *token;    /* The current token. */
+    Symbol *symbol; /* The symbol of the label. */
 
-    /* Get the first token. */
-    token = getNextToken(line);
+    /* Find the first word. */
+    index = findNextWord(tokens, FIRST_INDEX);
 
     /* Check if there is no label. */
-    if (!checkIfLabel(token)) {
-        free(token);
+    if (index == tokens->count || tokens->tokens[index].kind != LABEL_TOKEN) {
         return TRUE;
     }
 
-    /* Get the second token. */
-    line = skipCharacters(line);
-    line = skipWhitespace(line);
-    nextToken = getNextToken(line);
+    /* Get the label (without its colon). */
+    token = getTokenText(tokens, index);
 
-    if (nextToken == NULL) {
-        free(token);
+    /* Check if there is no second token. */
+    if (findNextWord(tokens, index + SINGLE_ENTRY) == tokens->count) {
         return FALSE;
     }
 
-    /* Skip .entry and .extern lines. */
-    if (strcmp(nextToken, ".entry") == EQUAL_STRINGS ||
-        strcmp(nextToken, ".extern") == EQUAL_STRINGS) {
-        free(token);
-        free(nextToken);
+    /* Skip .entry and .extern lines (the keyword is the second token's). */
+    if (tokens->keyword == ENTRY_KEYWORD ||
+        tokens->keyword == EXTERN_KEYWORD) {
         return TRUE;
     }
 
-    /* Remove the colon at the end of the label. */
-    removeEnding(token, ':');
-
-    /* Check if the label is already defined. */
-    if (getFoundLabel(*foundLabels, token) != NULL) {
+    /* Check if the label is already defined (not only declared). */
+    symbol = getSymbol(symbols, token);
+    if (symbol != NULL && symbol->definition != NULL) {
         printError("Label already defined.", fileName, lineNumber);
-        free(token);
-        free(nextToken);
         return FALSE;
     }
 
@@ -258,17 +271,17 @@ Boolean handleLabel(char fileName[], char line[], LineNumber lineNumber,
     if (getMacroContent(macros, token) != NULL) {
         printError("Label's name already taken by a macro.", fileName,
                    lineNumber);
-        free(token);
-        free(nextToken);
         return FALSE;
     }
 
-    /* Add the label to the list of found labels. */
-    addFoundLabel(foundLabels, token);
+    /* Add a copy of the label to the list of found labels, and to the table
+     * of the labels defined so far. */
+    addFoundLabel(foundLabels, copyStringForFile(token));
+    addSymbol(symbols, (*foundLabels)->name)->definition = *foundLabels;
 
     /* Set the label's properties based on if it is data or not. */
-    if (strcmp(nextToken, ".data") == EQUAL_STRINGS ||
-        strcmp(nextToken, ".string") == EQUAL_STRINGS) {
+    if (tokens->keyword == DATA_KEYWORD ||
+        tokens->keyword == STRING_KEYWORD) {
         /* When linking the labels, the instruction count will be added. */
         markAsData(*foundLabels);
         setAddress(*foundLabels, dataCount);
@@ -276,133 +289,73 @@ Boolean handleLabel(char fileName[], char line[], LineNumber lineNumber,
         setAddress(*foundLabels, instructionCount);
     }
 
-    /* Do not free the first token because it is used for the label's name. */
-    free(nextToken);
     return TRUE;
 }
 
-void handleOperation(char line[], LineNumber lineNumber, Word **code,
-                     UsedLabel **usedLabels, WordCount *instructionCount) {
-    char *operation;               /* The operation. */
-    OperandCount operands;         /* The number of expected operands. */
-    char *firstOperand;            /* The first operand. */
-    char *secondOperand;           /* The second operand. */
-    OperandType firstOperandType;  /* The first operand's addressing mode */
-    OperandType secondOperandType; /* The second operand's addressing mode. */
+void handleOperation(Index operation, ParsedLine *parsed, LineNumber lineNumber,
+                     WordImage *code, UsedLabel **usedLabels,
+                     WordCount *instructionCount) {
+    Word *word;                 /* The shared word of 2 registers. */
+    ParsedOperand *source;      /* The source operand. */
+    ParsedOperand *destination; /* The destination operand. */
 
-    /* Get the operation. */
-    operation = getNextToken(line);
+    /* Get the operands (absent ones were marked while validating). */
+    source = &parsed->source;
+    destination = &parsed->destination;
 
     /* Update the instruction count. */
     (*instructionCount)++;
-    /* Add the operation word. */
-    *code = addWord(*code);
-    encodeMetadata(*code, 'A');
-    encodeOperation(*code, operation);
-
-    /* Get the number of expected operands. */
-    operands = getOperandCount(operation);
-    /* The operation is no longer needed. */
-    free(operation);
+    /* Add the operation word and encode it with the addressing modes. */
+    encodeFirstWord(addWord(code), operation, source->type, destination->type);
 
     /* End here if the operation expects no operands. */
-    if (operands == NO_OPERANDS) {
+    if (destination->type == ABSENT_OPERAND) {
         return;
     }
 
-    /* Get the first operand. */
-    line = skipCharacters(line);
-    line = skipWhitespace(line);
-    firstOperand = getNextToken(line);
-
-    /* If the operand is the only one, it is destination, otherwise source. */
-    encodeOperand(*code, firstOperand, operands != ONE_OPERAND);
-    /* Get the first operand's addressing mode. */
-    firstOperandType = getOperandType(firstOperand);
-
-    /* Handle the possibility of a single operand. */
-    if (operands == ONE_OPERAND) {
-        /* Add the operand word. */
-        *code = addWord(*code);
-        /* Encode the operand as destination. */
-        encodeExtraWord(*code, firstOperand, FALSE);
-
-        /* If label, add it to the list of used labels. */
-        if (firstOperandType == DIRECT) {
-            /* Point the label to the operation word. */
-            addUsedLabel(usedLabels, firstOperand,
-                         *instructionCount + STARTING_MEMORY_ADDRESS,
-                         lineNumber, *code);
-        } else {
-            /* Free the operand only if it is not used as a label name. */
-            free(firstOperand);
-        }
-
-        /* Update the instruction count. */
-        (*instructionCount)++;
-        /* End here, as there are no more tokens. */
-        return;
-    }
-
-    /* Get the second operand. */
-    line = skipCharacters(line);
-    line = skipWhitespace(line);
-    secondOperand = getNextToken(line);
-
-    /* Encode the second operand as destination. */
-    encodeOperand(*code, secondOperand, FALSE);
-    /* Get the second operand's addressing mode. */
-    secondOperandType = getOperandType(secondOperand);
-
     /* Check if the operands should share the same word (2 registers). */
-    if ((firstOperandType == DIRECT_REGISTER ||
-         firstOperandType == INDIRECT_REGISTER) &&
-        (secondOperandType == DIRECT_REGISTER ||
-         secondOperandType == INDIRECT_REGISTER)) {
+    if ((source->type == DIRECT_REGISTER ||
+         source->type == INDIRECT_REGISTER) &&
+        (destination->type == DIRECT_REGISTER ||
+         destination->type == INDIRECT_REGISTER)) {
         /* Update the instruction count. */
         (*instructionCount)++;
         /* Add the shared word. */
-        *code = addWord(*code);
+        word = addWord(code);
         /* Encode both the operands in the word. */
-        encodeExtraWord(*code, firstOperand, TRUE);
-        encodeExtraWord(*code, secondOperand, FALSE);
+        encodeExtraWord(word, source, TRUE);
+        encodeExtraWord(word, destination, FALSE);
 
         /* End here. */
-        free(firstOperand);
-        free(secondOperand);
         return;
     }
 
-    /* Add the first operand word. */
-    *code = addWord(*code);
-    /* Encode the first operand as source. */
-    encodeExtraWord(*code, firstOperand, TRUE);
-
-    /* If label, add it to the list of used labels. */
-    if (firstOperandType == DIRECT) {
-        addUsedLabel(usedLabels, firstOperand,
-                     *instructionCount + STARTING_MEMORY_ADDRESS, lineNumber,
-                     *code);
-    } else {
-        /* Free the operand only if it is not used as a label name. */
-        free(firstOperand);
+    /* Encode the source operand, if there is one. */
+    if (source->type != ABSENT_OPERAND) {
+        handleOperand(source, TRUE, lineNumber, code, usedLabels,
+                      instructionCount);
     }
 
-    /* Update the instruction count. */
-    (*instructionCount)++;
-    /* Add the second operand word. */
-    *code = addWord(*code);
-    /* Encode the second operand as destination. */
-    encodeExtraWord(*code, secondOperand, FALSE);
-
-    /* If label, add it to the list of used labels. */
-    if (secondOperandType == DIRECT) {
-        addUsedLabel(usedLabels, secondOperand,
+    /* Encode the destination operand. */
+    handleOperand(destination, FALSE, lineNumber, code, usedLabels,
+                  instructionCount);
+}
+
+void handleOperand(ParsedOperand *operand, Boolean isSource,
+                   LineNumber lineNumber, WordImage *code,
+                   UsedLabel **usedLabels, WordCount *instructionCount) {
+    Word *word; /* The operand's word. */
+
+    /* Add the operand word and encode the operand into it. */
+    word = addWord(code);
+    encodeExtraWord(word, operand, isSource);
+
+    /* If label, add a copy of it to the list of used labels. */
+    if (operand->type == DIRECT) {
+        /* Point the label to the operand's word. */
+        addUsedLabel(usedLabels, copyStringForFile(operand->label),
                      *instructionCount + STARTING_MEMORY_ADDRESS, lineNumber,
-                     *code);
-    } else {
-        /* Free the operand only if it is not used as a label name. */
-        free(secondOperand);
+                     getWordIndex(code, word));
     }
 
     /* Update the instruction count. */
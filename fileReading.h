@@ -12,14 +12,12 @@
 #ifndef FILE_READING_H
 #define FILE_READING_H
 
-#include <stdio.h> /* FILE. */
-
 #include "globals.h" /* Typedefs. */
 
 /**
- * Opens the .am file and starts reading it line by line.
- * Modifies the given arguments to contain the information read from the .am
- * file.
+ * Starts reading the macro-expanded text line by line, from its start.
+ * Modifies the given arguments to contain the information read from the
+ * expanded text.
  * Returns whether or not no errors occurred.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
@@ -27,38 +25,46 @@
  * NULL.
  *
  * @param fileName The name of the file to read.
+ * @param expanded The macro-expanded text of the file.
  * @param macros The macro table.
- * @param code The code word list.
- * @param data The data word list.
+ * @param code The code image.
+ * @param data The data image.
  * @param entryLabels The list of entry labels.
  * @param externLabels The list of extern labels.
  * @param usedLabels The list of used labels.
  * @param foundLabels The list of found labels.
  * @param instructionCount The current instruction count to modify.
  * @param dataCount The current data count to modify.
- * @return TRUE if no errors occurred, FALSE otherwise or if the file could not
- * be opened.
+ * @return TRUE if no errors occurred, FALSE otherwise.
  */
-Boolean readFile(char fileName[], Macro *macros, Word *code, Word *data,
-                 Label **entryLabels, Label **externLabels,
-                 UsedLabel **usedLabels, FoundLabel **foundLabels,
-                 WordCount *instructionCount, WordCount *dataCount);
+Boolean readFile(char fileName[], TextBuffer *expanded, MacroTable *macros,
+                 WordImage *code, WordImage *data, Label **entryLabels,
+                 Label **externLabels, UsedLabel **usedLabels,
+                 FoundLabel **foundLabels, WordCount *instructionCount,
+                 WordCount *dataCount);
 
 /**
- * Reads the lines of the .am file line by line.
- * Modifies the given arguments to contain the information read from the .am
- * file.
+ * Reads the lines of the macro-expanded text line by line, the same way they
+ * would be read from the .am file.
+ * If a ring is given, the lines are taken from it as they are expanded
+ * instead.
+ * Modifies the given arguments to contain the information read from the
+ * expanded text.
  * Returns whether or not no errors occurred.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
- * Assumes that all the pointers given as arguments, except macros, are not
- * NULL.
+ * Assumes that all the pointers given as arguments, except the expanded text,
+ * the ring and macros, are not NULL, and that either the expanded text or the
+ * ring is not NULL.
  *
  * @param fileName The name of the file to read.
- * @param file The file to read.
+ * @param expanded The macro-expanded text of the file (NULL if a ring is
+ * given).
+ * @param ring The ring that the expanded lines arrive in, or NULL to read the
+ * expanded text.
  * @param macros The macro table.
- * @param code The code word list.
- * @param data The data word list.
+ * @param code The code image.
+ * @param data The data image.
  * @param entryLabels The list of entry labels.
  * @param externLabels The list of extern labels.
  * @param usedLabels The list of used labels.
@@ -67,11 +73,26 @@ Boolean readFile(char fileName[], Macro *macros, Word *code, Word *data,
  * @param dataCount The current data count to modify.
  * @return TRUE if no errors occurred, FALSE otherwise.
  */
-Boolean readLines(char fileName[], FILE *file, Macro *macros, Word *code,
-                  Word *data, Label **entryLabels, Label **externLabels,
+Boolean readLines(char fileName[], TextBuffer *expanded, LineRing *ring,
+                  MacroTable *macros, WordImage *code, WordImage *data,
+                  Label **entryLabels, Label **externLabels,
                   UsedLabel **usedLabels, FoundLabel **foundLabels,
                   WordCount *instructionCount, WordCount *dataCount);
 
+/**
+ * Copies the next expanded line into the given buffer, from the given ring if
+ * there is one, and from the expanded text otherwise.
+ *
+ * Assumes that the given buffer has room for 82 characters.
+ * Assumes that either the expanded text or the ring is not NULL.
+ *
+ * @param line The buffer to copy the line to.
+ * @param expanded The macro-expanded text of the file.
+ * @param ring The ring that the expanded lines arrive in, or NULL.
+ * @return Whether a line has been copied (FALSE if there are no more lines).
+ */
+Boolean readNextLine(char line[], TextBuffer *expanded, LineRing *ring);
+
 /**
  * Handles a line of the .am file.
  * Modifies the given arguments to contain the information read from the current
@@ -79,51 +100,103 @@ Boolean readLines(char fileName[], FILE *file, Macro *macros, Word *code,
  * Returns whether or not no errors occurred.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
- * Assumes that the given line is not NULL and is null-terminated.
+ * Assumes that the given token line pointer is not NULL and that the line has
+ * been split into tokens.
+ * Assumes that the given parsed line has been filled by validating the line,
+ * and that the line is valid.
  * Assumes that all the pointers given as arguments, except macros, are not
  * NULL.
  *
  * @param fileName The name of the file to read.
- * @param line The line that has been extracted from the .am file.
+ * @param tokens The tokens of the line that has been extracted from the .am
+ * file.
+ * @param parsed What has been found while validating the line.
  * @param lineNumber The current line's line number.
  * @param macros The macro table.
- * @param code The code word list.
- * @param data The data word list.
+ * @param code The code image.
+ * @param data The data image.
  * @param entryLabels The list of entry labels.
  * @param externLabels The list of extern labels.
  * @param usedLabels The list of used labels.
+ * @param symbols The table of the labels defined or declared so far (updated
+ * with a new declaration).
  * @param foundLabels The list of found labels.
  * @param instructionCount The current instruction count to modify.
  * @param dataCount The current data count to modify.
  * @return TRUE if no errors occurred, FALSE otherwise.
  */
-Boolean handleLine(char fileName[], char line[], LineNumber lineNumber,
-                   Macro *macros, Word **code, Word **data, Label **entryLabels,
-                   Label **externLabels, UsedLabel **usedLabels,
+Boolean handleLine(char fileName[], TokenLine *tokens, ParsedLine *parsed,
+                   LineNumber lineNumber, MacroTable *macros, WordImage *code,
+                   WordImage *data, Label **entryLabels, Label **externLabels,
+                   UsedLabel **usedLabels, SymbolTable *symbols,
                    FoundLabel **foundLabels, WordCount *instructionCount,
                    WordCount *dataCount);
-Boolean handleLabel(char fileName[], char line[], LineNumber lineNumber,
-                    Macro *macros, FoundLabel **foundLabels,
-                    WordCount instructionCount, WordCount dataCount);
 
 /**
  * Handles a potential label in the current line of the .am file.
  * Modifies the given arguments to contain the new information.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
- * Assumes that the given line is not NULL and is null-terminated.
- * Assumes that the given pointer to the found labels is not NULL.
+ * Assumes that the given token line pointer is not NULL and that the line has
+ * been split into tokens.
+ * Assumes that the given pointers to the table of the labels defined or
+ * declared so far and to the found labels are not NULL, and that the table
+ * holds every found label.
  *
  * @param fileName The name of the file to read.
- * @param line The current line.
+ * @param tokens The tokens of the current line.
  * @param lineNumber The current line's line number.
  * @param macros The macro table.
+ * @param symbols The table of the labels defined or declared so far (updated
+ * with the new label).
  * @param foundLabels The list of found labels.
  * @param instructionCount The current instruction count.
  * @param dataCount The current data count.
  * @return TRUE if no errors occurred, FALSE otherwise.
  */
-void handleOperation(char line[], LineNumber lineNumber, Word **code,
-                     UsedLabel **usedLabels, WordCount *instructionCount);
+Boolean handleLabel(char fileName[], TokenLine *tokens, LineNumber lineNumber,
+                    MacroTable *macros, SymbolTable *symbols,
+                    FoundLabel **foundLabels, WordCount instructionCount,
+                    WordCount dataCount);
+
+/**
+ * Encodes an instruction line into words, from the operands that have been
+ * kept while validating it (without parsing them again).
+ * Adds the labels that are used as operands to the list of used labels.
+ *
+ * Assumes that the given index is the index of an actual operation.
+ * Assumes that the given parsed line has been filled by validating the
+ * instruction line, and that the line is valid.
+ * Assumes that all the pointers given as arguments are not NULL.
+ *
+ * @param operation The index of the operation.
+ * @param parsed What has been found while validating the line.
+ * @param lineNumber The current line's line number.
+ * @param code The code image.
+ * @param usedLabels The list of used labels.
+ * @param instructionCount The current instruction count to modify.
+ */
+void handleOperation(Index operation, ParsedLine *parsed, LineNumber lineNumber,
+                     WordImage *code, UsedLabel **usedLabels,
+                     WordCount *instructionCount);
+
+/**
+ * Adds the word of a single operand, and encodes the operand into it.
+ * Adds the operand to the list of used labels if it is a label.
+ *
+ * Assumes that the given operand has been kept while validating it.
+ * Assumes that all the pointers given as arguments are not NULL.
+ *
+ * @param operand The operand to encode.
+ * @param isSource Whether the operand is the source or the destination of the
+ * instruction.
+ * @param lineNumber The current line's line number.
+ * @param code The code image.
+ * @param usedLabels The list of used labels.
+ * @param instructionCount The current instruction count to modify.
+ */
+void handleOperand(ParsedOperand *operand, Boolean isSource,
+                   LineNumber lineNumber, WordImage *code,
+                   UsedLabel **usedLabels, WordCount *instructionCount);
 
 #endif
@@ -1,8 +1,7 @@
 /*
  * foundLabelList.c
  *
- * Contains functions to interface with a found label list, to search through it
- * and finally to free it.
+ * Contains functions to interface with a found label list.
  * The found label list contains all the label definitions in the .am file.
  *
  * Name: Ariel Keren
@@ -13,17 +12,14 @@
 
 #include "foundLabelList.h"
 
-#include <stdlib.h> /* free. */
-#include <string.h> /* strcmp. */
-
 #include "globals.h" /* Constants and typedefs. */
-#include "utils.h"   /* Allocating memory. */
+#include "utils.h"   /* Allocating memory from the file's arena. */
 
 void addFoundLabel(FoundLabel **labels, char labelName[]) {
     FoundLabel *newLabel; /* The new found label. */
 
     /* Allocate enough memory for the new found label. */
-    newLabel = allocate(sizeof(FoundLabel));
+    newLabel = allocateForFile(sizeof(FoundLabel));
 
     /* Set the new found label's properties. */
     newLabel->name = labelName;
@@ -43,41 +39,3 @@ void setAddress(FoundLabel *label, Address newAddress) {
     /* Set the address property. */
     label->address = newAddress;
 }
-
-FoundLabel *getFoundLabel(FoundLabel *labels, char labelName[]) {
-    /* Loop over the labels to try to find the desired one. */
-    while (labels != NULL) {
-        /* Compare the names. */
-        if (strcmp(labels->name, labelName) == EQUAL_STRINGS) {
-            /* The label has been found. */
-            return labels;
-        }
-
-        /* Try checking the next label. */
-        labels = labels->next;
-    }
-
-    /* The label has not been found. */
-    return NULL;
-}
-
-void freeFoundLabelList(FoundLabel *labels) {
-    FoundLabel *next; /* The next label in the list. */
-
-    /* Loop over the labels in the list and free each one. */
-    while (labels != NULL) {
-        /* Store the next label. */
-        next = labels->next;
-        /* Free the current label. */
-        freeFoundLabel(labels);
-        /* Move on to the next label. */
-        labels = next;
-    }
-}
-
-void freeFoundLabel(FoundLabel *label) {
-    /* Free the name string. */
-    free(label->name);
-    /* Free the label. */
-    free(label);
-}
@@ -16,7 +16,8 @@
 
 /**
  * Adds a new found label to a list of found labels.
- * IMPORTANT: The caller must free the new found label.
+ * IMPORTANT: The new found label comes from the current file's arena, so it
+ * must not be freed.
  *
  * Assumes that the pointer to the labels is not NULL.
  * Assumes that the label name is not NULL and is null-terminated.
@@ -47,34 +48,4 @@ void markAsData(FoundLabel *label);
  */
 void setAddress(FoundLabel *label, Address newAddress);
 
-/**
- * Searches and returns a found label from a list of found labels with its name.
- * Returns NULL if no found label with the given name exists.
- *
- * Assumes that the given label name is not NULL and is null-terminated.
- *
- * @param labels The list of found labels.
- * @param labelName The name of the label to search for.
- * @return The found label with the given name or NULL if not found.
- */
-FoundLabel *getFoundLabel(FoundLabel *labels, char labelName[]);
-
-/**
- * Frees a list of found labels.
- *
- * Assumes that the given labels have not been freed yet.
- *
- * @param labels The list of found labels to free.
- */
-void freeFoundLabelList(FoundLabel *labels);
-
-/**
- * Frees a single found label.
- *
- * Assumes that the given label is not NULL and has not been freed yet.
- *
- * @param label The found label to free.
- */
-void freeFoundLabel(FoundLabel *label);
-
 #endif
@@ -3,8 +3,10 @@
  *
  * Contains functions to handle sudden freeing of the memory used by the
  * program.
- * Only executes when an allocation failure occurs. Needs to get the pointers to
- * each linked list in memory to free it, in case of an allocation failure.
+ * Only executes when an allocation failure occurs. All the lists, tables and
+ * buffers of a file come from a single arena, so freeing the arena frees them
+ * all at once.
+ * Each thread that compiles files has its own arena.
  *
  * Name: Ariel Keren
  * Course: C Lab, 20465
@@ -14,55 +16,46 @@
 
 #include "freeingLogic.h"
 
-#include "foundLabelList.h" /* Freeing the found label list. */
-#include "globals.h"        /* Constants and typedefs. */
-#include "labelList.h"      /* Freeing the 2 label lists. */
-#include "macroTable.h"     /* Freeing the macro table. */
-#include "usedLabelList.h"  /* Freeing the used label list. */
-#include "wordList.h"       /* Freeing the 2 word lists. */
+#include <pthread.h> /* pthread_key_t, pthread_once. */
+
+#include "arena.h"   /* Freeing the arena. */
+#include "globals.h" /* Constants and typedefs. */
+
+/* The key of the memory to free of the current thread. */
+static pthread_key_t toFreeKey;
+/* Makes sure that the key is created only once. */
+static pthread_once_t toFreeKeyOnce = PTHREAD_ONCE_INIT;
 
 void freeAll() {
-    /* Call the freeing logic to free the linked lists. */
-    freeingLogic(TRUE, NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+    /* Free the arena of the current thread, with everything in it. */
+    freeArena(getFileArena());
 }
 
-void setToFree(Word **code, Word **data, Macro **macros, Label **entryLabels,
-               Label **externLabels, UsedLabel **usedLabels,
-               FoundLabel **foundLabels) {
-    /* Pass all the pointers to the freeing logic. */
-    freeingLogic(FALSE, code, data, macros, entryLabels, externLabels,
-                 usedLabels, foundLabels);
+Arena *getFileArena() {
+    /* The arena lives in the current thread's struct. */
+    return &getToFree()->arena;
 }
 
-void freeingLogic(Boolean shouldFree, Word **code, Word **data, Macro **macros,
-                  Label **entryLabels, Label **externLabels,
-                  UsedLabel **usedLabels, FoundLabel **foundLabels) {
-    static ToFree toFree; /* The struct that holds all the pointers to free. */
-
-    /* Check whether to free or set the pointers. */
-    if (shouldFree) {
-        /* Free all the linked lists. */
-        freeLists(&toFree);
-        return;
-    }
+void createToFreeKey() {
+    /* Every thread starts without its own struct (NULL). */
+    pthread_key_create(&toFreeKey, NULL);
+}
 
-    /* Set all the pointers according to the arguments. */
-    toFree.code = code;
-    toFree.data = data;
-    toFree.macros = macros;
-    toFree.entryLabels = entryLabels;
-    toFree.externLabels = externLabels;
-    toFree.usedLabels = usedLabels;
-    toFree.foundLabels = foundLabels;
+void registerToFree(ToFree *toFree) {
+    /* Make sure the key exists before using it. */
+    pthread_once(&toFreeKeyOnce, createToFreeKey);
+    /* Set the struct of the current thread. */
+    pthread_setspecific(toFreeKey, toFree);
 }
 
-void freeLists(ToFree *toFree) {
-    /* Free all the linked lists in the given struct. */
-    freeWordList(*toFree->code);
-    freeWordList(*toFree->data);
-    freeMacroTable(*toFree->macros);
-    freeLabelList(*toFree->entryLabels);
-    freeLabelList(*toFree->externLabels);
-    freeUsedLabelList(*toFree->usedLabels);
-    freeFoundLabelList(*toFree->foundLabels);
+ToFree *getToFree() {
+    static ToFree mainToFree; /* The struct of the main thread (empty arena). */
+    ToFree *toFree;           /* The struct of the current thread. */
+
+    /* Get the struct of the current thread. */
+    pthread_once(&toFreeKeyOnce, createToFreeKey);
+    toFree = pthread_getspecific(toFreeKey);
+
+    /* Threads that have not registered a struct use the main one. */
+    return toFree == NULL ? &mainToFree : toFree;
 }
@@ -15,65 +15,49 @@
 #include "globals.h" /* Typedefs. */
 
 /**
- * Frees all the memory used by all the linked lists in the program.
+ * Frees all the memory used by the lists, tables and buffers of the calling
+ * thread, by freeing its arena.
  *
- * Assumes that this function is called only in case of an allocation failure.
- * Assumes that the pointers to all the linked lists in the program have been
- * set.
+ * Assumes that this function is called only in case of an allocation failure,
+ * or once the calling thread has no more files to compile.
  */
 void freeAll();
 
 /**
- * Sets the pointers to each linked list in memory to free it, in case of an
- * allocation failure.
+ * Returns the arena that the lists, tables and buffers of the file that the
+ * calling thread compiles are allocated from.
+ * The arena is kept from one file to the next.
  *
- * Assumes that all the arguments point to the linked lists that need to be
- * freed.
+ * @return The arena of the calling thread.
+ */
+Arena *getFileArena();
+
+/**
+ * Creates the key of the memory to free of each thread.
  *
- * @param code The code word list.
- * @param data The data word list.
- * @param macros The macro table.
- * @param entryLabels The list of entry labels.
- * @param externLabels The list of extern labels.
- * @param usedLabels The list of used labels.
- * @param foundLabels The list of found labels.
+ * Assumes that this function is called only once (through pthread_once).
  */
-void setToFree(Word **code, Word **data, Macro **macros, Label **entryLabels,
-               Label **externLabels, UsedLabel **usedLabels,
-               FoundLabel **foundLabels);
+void createToFreeKey();
 
 /**
- * Manages the logic for keeping pointers to the linked lists in the program.
- * Can free them all in case of an allocation failure.
+ * Makes the calling thread keep its memory to free in the given struct, instead
+ * of in the struct of the main thread.
+ * Needed by every thread that compiles files at the same time as others.
  *
- * Assumes that all the pointer arguments point to the linked lists that need to
- * be freed.
- * Assumes that this function is called with shouldFree = TRUE only in case of
- * an allocation failure.
- * Assumes that the pointers to all the linked lists in the program have been
- * set, if this function is called with shouldFree = TRUE.
+ * Assumes that the given struct lives as long as the calling thread uses it.
+ * Assumes that the arena in the given struct has been initialized.
  *
- * @param shouldFree Frees the lists if TRUE, otherwise sets them to the given
- * pointers.
- * @param code The code word list.
- * @param data The data word list.
- * @param macros The macro table.
- * @param entryLabels The list of entry labels.
- * @param externLabels The list of extern labels.
- * @param usedLabels The list of used labels.
- * @param foundLabels The list of found labels.
+ * @param toFree The struct to keep the memory to free in.
  */
-void freeingLogic(Boolean shouldFree, Word **code, Word **data, Macro **macros,
-                  Label **entryLabels, Label **externLabels,
-                  UsedLabel **usedLabels, FoundLabel **foundLabels);
+void registerToFree(ToFree *toFree);
 
 /**
- * Frees all the linked lists in the program.
- *
- * Assumes that the pointer received is not NULL.
+ * Returns the struct that holds the memory to free of the calling thread.
+ * If the calling thread has not registered a struct, returns the struct of the
+ * main thread.
  *
- * @param toFree The pointers to the linked lists to free.
+ * @return The struct that holds the memory to free of the calling thread.
  */
-void freeLists(ToFree *toFree);
+ToFree *getToFree();
 
 #endif
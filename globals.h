@@ -12,6 +12,10 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
+#include <pthread.h> /* pthread_mutex_t, pthread_cond_t. */
+#include <stddef.h>  /* size_t. */
+#include <stdio.h>   /* FILE. */
+
 /* Used for strings instead of size_t, as a line is 80 characters at most. */
 typedef unsigned char Length;
 
@@ -36,36 +40,127 @@ typedef unsigned long LineNumber;
 /* Booleans. */
 typedef enum { FALSE, TRUE } Boolean;
 
-/* Type (addressing mode) of an operand. */
+/*
+ * A token inside a line, which does not own its characters (they stay in the
+ * line, which is not null-terminated at the end of the token).
+ */
+typedef struct {
+    /* The first character of the token in the line. */
+    char *start;
+    /* The number of characters in the token (0 if there is no token). */
+    Length length;
+} TokenSlice;
+
+/*
+ * Type (addressing mode) of an operand.
+ * ABSENT_OPERAND stands for an operand that the instruction does not have.
+ */
 typedef enum {
     IMMEDIATE,
     DIRECT,
     INDIRECT_REGISTER,
-    DIRECT_REGISTER
+    DIRECT_REGISTER,
+    ABSENT_OPERAND
 } OperandType;
 
 /* Number of operands that should appear right after a specific operation. */
 typedef enum { NO_OPERANDS, ONE_OPERAND, TWO_OPERANDS } OperandCount;
 
-/* Macro linked list node. */
+/* Macro linked list node (also an entry in the macro table). */
 typedef struct MacroNode {
     /* The name of the macro (identifier). */
     char *name;
     /* The content of the macro (what the macro expands to). */
     char *content;
-    /* The next node in the list (NULL if this is the last one). */
+    /* The number of characters in the content. */
+    size_t length;
+    /* The number of characters the content can hold (0 if not allocated). */
+    size_t capacity;
+    /* The hash of the name, computed once when the macro is added. */
+    unsigned long hash;
+    /* The macro added before this one (NULL if this is the first one). */
     struct MacroNode *next;
 } Macro;
 
-/* Word linked list node. */
-typedef struct WordNode {
-    /* The first 8 bits in a word (bits 0-7). */
-    unsigned char data1;
-    /* The last 7 bits in a word (bits 8-14). The last bit is ignored. */
-    unsigned char data2;
-    /* The next node in the list (NULL if this is the last one). */
-    struct WordNode *next;
-} Word;
+/* Macro hash table (open addressing with linear probing). */
+typedef struct {
+    /* The slots of the table (NULL slots are empty). */
+    Macro **slots;
+    /* The number of slots in the table (0 or a power of 2). */
+    unsigned long capacity;
+    /* The number of macros in the table. */
+    unsigned long count;
+    /* The last macro added (its next pointers go through all the macros). */
+    Macro *latest;
+} MacroTable;
+
+/* Growable text buffer, read back line by line like a file. */
+typedef struct {
+    /* The characters in the buffer (NULL if nothing has been added yet). */
+    char *text;
+    /* The number of characters in the buffer. */
+    size_t length;
+    /* The number of characters the buffer can hold. */
+    size_t capacity;
+    /* The index of the next character to read. */
+    size_t position;
+} TextBuffer;
+
+/* A source file that is mapped into memory, with the offsets of its lines. */
+typedef struct {
+    /* The characters of the file (NULL if the file is empty). */
+    char *text;
+    /* The number of characters in the file. */
+    size_t size;
+    /* The offset of the first character of each line, followed by the size. */
+    size_t *lineStarts;
+    /* The number of lines in the file. */
+    LineNumber lineCount;
+} MappedFile;
+
+/* Arena block linked list node (followed in memory by the block's bytes). */
+typedef struct ArenaBlockNode {
+    /* The next block (NULL if this is the last one). */
+    struct ArenaBlockNode *next;
+    /* The number of bytes the block can hand out. */
+    size_t capacity;
+    /* The number of bytes handed out so far. */
+    size_t used;
+} ArenaBlock;
+
+/*
+ * Bump arena that hands out the memory of a single file, and takes it all back
+ * at once when the file is done. The blocks are kept for the next files.
+ */
+typedef struct {
+    /* The first block (NULL if nothing has been allocated yet). */
+    ArenaBlock *first;
+    /* The block that memory is currently handed out from. */
+    ArenaBlock *current;
+} Arena;
+
+/* The types with the strictest alignment, so that any type can be allocated. */
+typedef union {
+    long integer;
+    double real;
+    void *pointer;
+} MaxAlignment;
+
+/* A single word in memory (bits 0-14). The last bit is always 0. */
+typedef unsigned short Word;
+
+/* The description of a single operation in the instruction set. */
+typedef struct {
+    /* The number of operands the operation expects. */
+    OperandCount operandCount;
+    /* The addressing modes the source operand can have (a mask). */
+    Mask sourceModes;
+    /* The addressing modes the destination operand can have (a mask). */
+    Mask destinationModes;
+    /* The first word of the instruction before the addressing modes are added
+     * (the operation's identifier and the A metadata). */
+    Word template;
+} InstructionDescription;
 
 /* Label linked list node. */
 typedef struct LabelNode {
@@ -85,10 +180,12 @@ typedef struct UsedLabelNode {
     Address address;
     /* The line number of this specific used label instance (for errors). */
     LineNumber lineNumber;
-    /* A pointer to the word that needs to include the label's address. */
-    Word *wordPointer;
+    /* The index of the code word that needs to include the label's address. */
+    WordCount wordIndex;
     /* The next node in the list (NULL if this is the last one). */
     struct UsedLabelNode *next;
+    /* The next use of the same label in the list (set by the symbol table). */
+    struct UsedLabelNode *nextUse;
 } UsedLabel;
 
 /* Found label linked list node. */
@@ -103,27 +200,107 @@ typedef struct FoundLabelNode {
     struct FoundLabelNode *next;
 } FoundLabel;
 
+/* Everything that is known about a label (an entry in a symbol table). */
+typedef struct SymbolNode {
+    /* The name of the label (belongs to one of the label lists). */
+    char *name;
+    /* The hash of the name, computed once when the symbol is added. */
+    unsigned long hash;
+    /* The label's definition (NULL if the label is not defined). */
+    FoundLabel *definition;
+    /* Whether the label has been declared as extern. */
+    Boolean isExtern;
+    /* Whether the label has been declared as entry (known only while reading
+     * the lines). */
+    Boolean isEntry;
+    /* The first use of the label (NULL if the label is not used). */
+    UsedLabel *firstUse;
+    /* The last use of the label (NULL if the label is not used). */
+    UsedLabel *lastUse;
+    /* The symbol added before this one (NULL if this is the first one). */
+    struct SymbolNode *next;
+} Symbol;
+
+/* Symbol hash table (open addressing with linear probing). */
+typedef struct {
+    /* The slots of the table (NULL slots are empty). */
+    Symbol **slots;
+    /* The number of slots in the table (0 or a power of 2). */
+    unsigned long capacity;
+    /* The number of symbols in the table. */
+    unsigned long count;
+    /* The last symbol added (its next pointers go through all the symbols). */
+    Symbol *latest;
+} SymbolTable;
+
 /*
- * Struct that contains pointers to all the linked lists used in the program, in
- * case of an allocation failure.
+ * Struct that contains the memory of the files compiled by a thread, so that it
+ * can be freed in case of an allocation failure.
  */
 typedef struct {
-    /* Pointer to the code word list. */
-    Word **code;
-    /* Pointer to the data word list. */
-    Word **data;
-    /* Pointer to the macro table. */
-    Macro **macros;
-    /* Pointer to the list of entry labels. */
-    Label **entryLabels;
-    /* Pointer to the list of extern labels. */
-    Label **externLabels;
-    /* Pointer to the list of used labels. */
-    UsedLabel **usedLabels;
-    /* Pointer to the list of found labels. */
-    FoundLabel **foundLabels;
+    /* The arena that the lists, tables and buffers of each file come from. */
+    Arena arena;
 } ToFree;
 
+/* The different kinds of messages that can be printed to stdout. */
+typedef enum {
+    ERROR_MESSAGE,
+    MACRO_ERROR_MESSAGE,
+    WARNING_MESSAGE,
+    NAME_ERROR_MESSAGE,
+    FILE_ERROR_MESSAGE
+} MessageKind;
+
+/* Message linked list node (a message that has not been printed yet). */
+typedef struct MessageNode {
+    /* The kind of the message. */
+    MessageKind kind;
+    /* The text of the message (or the file's name, for file errors). */
+    char *text;
+    /* The name of the file in which the message occurred. */
+    char *fileName;
+    /* The line number in the file in which the message occurred. */
+    LineNumber lineNumber;
+    /* Whether the name is of a macro or of a label (for name errors). */
+    Boolean isMacro;
+    /* The next node in the list (NULL if this is the last one). */
+    struct MessageNode *next;
+} Message;
+
+/* Queue of messages that are printed only once the queue is flushed. */
+typedef struct {
+    /* The first message in the queue (NULL if the queue is empty). */
+    Message *first;
+    /* The last message in the queue (NULL if the queue is empty). */
+    Message *last;
+} MessageQueue;
+
+/* The options given as command line arguments, before the file names. */
+typedef struct {
+    /* The number of files to compile at the same time (-j). */
+    unsigned int jobCount;
+    /* Whether to write the macro-expanded .am file (--no-am turns it off). */
+    Boolean shouldWriteAm;
+    /* Whether to print how long each phase took (--time-report). */
+    Boolean shouldReportTime;
+    /* The number of threads that parse a single file (the jobs, when only one
+     * file is compiled). */
+    unsigned int parseJobCount;
+    /* The directory that the outputs of each file are cached in (--cache), or
+     * NULL if they are not cached. */
+    char *cacheDirectory;
+} Options;
+
+/* The timed phases of compiling a file, in order. */
+typedef enum {
+    EXPANSION_PHASE,
+    READING_PHASE,
+    LINKING_PHASE,
+    ENT_PHASE,
+    EXT_PHASE,
+    OB_PHASE
+} Phase;
+
 /* All the operations in the language. */
 enum {
     MOV,
@@ -165,6 +342,152 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
  * Used to check if no files have been provided in the command line arguments.
  */
 #define NO_FILES 0
+/* Used to compile a single file out of the command line arguments. */
+#define SINGLE_FILE 1
+
+/* --- Options. --- */
+
+/* The default number of files to compile at the same time. */
+#define DEFAULT_JOB_COUNT 1
+/* The maximum number of files to compile at the same time. */
+#define MAX_JOB_COUNT 256
+
+/* --- Time report. --- */
+
+/* The number of timed phases of compiling a file. */
+#define PHASE_COUNT 6
+/* The number of milliseconds in a second. */
+#define MILLISECONDS_PER_SECOND 1000.0
+/* The number of nanoseconds in a second. */
+#define NANOSECONDS_PER_SECOND 1000000000.0
+/* The width of the name column (longer names push the rest of the row). */
+#define NAME_COLUMN_WIDTH 16
+/* The width of each count column. */
+#define COUNT_COLUMN_WIDTH 8
+/* The width of each time column. */
+#define TIME_COLUMN_WIDTH 10
+/* The number of digits after the point of each time (in milliseconds). */
+#define TIME_PRECISION 3
+
+/* --- Hash tables. --- */
+
+/* The number of slots in a hash table when the first entry is added. */
+#define INITIAL_TABLE_CAPACITY 16
+/* A hash table grows once more than 1 out of this many slots are taken. */
+#define TABLE_LOAD_DIVISOR 2
+/* The number of times a hash table grows each time it is full. */
+#define TABLE_GROWTH_FACTOR 2
+/* The initial value of an FNV-1a hash. */
+#define HASH_OFFSET_BASIS 2166136261UL
+/* The multiplier of an FNV-1a hash. */
+#define HASH_PRIME 16777619UL
+
+/* --- Growable buffers. --- */
+
+/* The number of characters a buffer can hold when it is first allocated. */
+#define INITIAL_BUFFER_CAPACITY 128
+/* The number of times a buffer grows each time it is full. */
+#define BUFFER_GROWTH_FACTOR 2
+
+/* --- Arenas. --- */
+
+/* The number of bytes in each block of an arena (unless more are needed). */
+#define ARENA_BLOCK_SIZE 65536
+
+/* --- Input files. --- */
+
+/* Return value of a system call (open, fstat) that failed. */
+#define SYSTEM_CALL_FAILED (-1)
+
+/* --- Pipeline. --- */
+
+/* The smallest .as file (in bytes) that is parsed while it is expanded. */
+#define PIPELINE_MIN_SOURCE_SIZE 65536
+/* The number of lines the ring between the 2 stages can hold. */
+#define RING_SLOT_COUNT 1024
+/* The size of a line in the ring (80 characters, a newline and a null). */
+#define RING_SLOT_SIZE (MAX_LINE_LENGTH + NEWLINE_BYTE + NULL_BYTE)
+/* The number of lines that are written before they are handed over. */
+#define RING_BATCH_SIZE 64
+/* The smallest share of the expanded text (in bytes) that is parsed on a
+ * thread of its own, when a single file is given several jobs. */
+#define CHUNK_MIN_SIZE 32768
+
+/* --- Cache. --- */
+
+/* The first line of every cache entry (changed whenever its format does). */
+#define CACHE_FORMAT "assembler-cache-1"
+/* The file whose bytes identify the running assembler. */
+#define CACHE_TOOL_PATH "/proc/self/exe"
+/* The number of 32-bit hashes that make up the key of a cache entry. */
+#define CACHE_HASH_COUNT 2
+/* The slash between the cache directory and the name of an entry. */
+#define SLASH_BYTE 1
+/* The number of hexadecimal digits in the key of a cache entry. */
+#define CACHE_KEY_LENGTH 16
+/* The initial value of the second hash of a cache key. */
+#define CACHE_SECOND_OFFSET_BASIS 2654435769UL
+/* The multiplier of the second hash of a cache key. */
+#define CACHE_SECOND_PRIME 2246822519UL
+/* Keeps the lowest 32 bits of a hash. */
+#define CACHE_HASH_MASK 4294967295UL
+/* The number of bytes that are read from a file at once, to hash it. */
+#define CACHE_READ_SIZE 65536
+/* The size of the line that starts each record of a cache entry. */
+#define CACHE_RECORD_LINE_SIZE 64
+/* The size of an output file's extension (at most 3 letters and a null). */
+#define CACHE_EXTENSION_SIZE 4
+/* The hashes that make up the key of a cache entry, in order. */
+enum { FIRST_HASH, SECOND_HASH };
+/* The numbers after the name of an entry's temporary file (the process and
+ * the entry). */
+#define TEMPORARY_NUMBER_COUNT 2
+/* The number of fields after the type of an output record. */
+#define OUTPUT_RECORD_FIELDS 2
+/* The number of fields after the type of a message record. */
+#define MESSAGE_RECORD_FIELDS 4
+/* The permissions of a new cache directory (before the umask). */
+#define CACHE_DIRECTORY_MODE 0777
+/* The record of a cache entry that holds an output file. */
+#define OUTPUT_RECORD 'F'
+/* The record of a cache entry that holds a message. */
+#define MESSAGE_RECORD 'M'
+/* The record that ends a cache entry. */
+#define END_RECORD 'E'
+
+/* --- Character classes. --- */
+
+/* The number of different characters (a class for each). */
+#define CHARACTER_COUNT 256
+/* The class of a character that does not separate tokens. */
+#define OTHER_CLASS 0
+/* The class of a whitespace character (as isspace sees it). */
+#define WHITESPACE_CLASS 1
+/* The class of a comma. */
+#define COMMA_CLASS 2
+/* The class of the null character that ends a line. */
+#define TERMINATOR_CLASS 4
+/* The classes that are skipped between tokens. */
+#define SEPARATOR_CLASSES (WHITESPACE_CLASS | COMMA_CLASS)
+/* The classes that end a token. */
+#define TOKEN_END_CLASSES (WHITESPACE_CLASS | COMMA_CLASS | TERMINATOR_CLASS)
+
+/* --- Output files. --- */
+
+/* The number of decimal digits of an address (padded with zeros). */
+#define ADDRESS_DIGITS 4
+/* The number of octal digits of a word in the .ob file (padded with zeros). */
+#define WORD_DIGITS 5
+/* Used for numbers that are not padded. */
+#define NO_PADDING 0
+/* The maximum number of digits of a number (an unsigned long in octal). */
+#define MAX_DIGIT_COUNT 24
+/* The number of digits in each entry of the table of decimal digit pairs. */
+#define DIGITS_PER_PAIR 2
+/* The number of bits that each octal digit stands for. */
+#define BITS_PER_OCTAL_DIGIT 3
+/* The bits of a single octal digit. */
+#define OCTAL_DIGIT_MASK 7
 
 /* --- Made-up language and environment information. --- */
 
@@ -172,6 +495,13 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
 #define TOTAL_MEMORY_CELLS 4096
 /* The number of bits in each 15-bit cell. */
 #define BITS_PER_MEMORY_CELL 15
+/* The bits that are used in each 15-bit cell (bits 0-14). */
+#define MEMORY_CELL_MASK 0x7FFF
+/*
+ * The extra word at the end of a word image, which takes the words that do not
+ * fit (only after a memory overflow, when no output files are generated).
+ */
+#define SCRATCH_WORD 1
 /*
  * The starting memory address to load a word to (0-99 should not be used by the
  * program).
@@ -179,11 +509,18 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
 #define STARTING_MEMORY_ADDRESS 100
 /* The number of different operations in the language. */
 #define OPERATION_COUNT 16
+/* The number of operand types (4 addressing modes and an absent operand). */
+#define OPERAND_TYPE_COUNT 5
 /*
  * The maximum number of characters in a line (not including any newline and
  * null characters).
  */
 #define MAX_LINE_LENGTH 80
+/*
+ * The maximum number of tokens in a line (each token takes at least one
+ * character).
+ */
+#define MAX_TOKEN_COUNT (MAX_LINE_LENGTH + NEWLINE_BYTE)
 /*
  * The maximum number of characters in a label's or macro's name (they follow
  * the same rules).
@@ -229,6 +566,8 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
 #define STARTING_SOURCE_REGISTER_BIT 6
 /* The first bit of a destination register's number. */
 #define STARTING_DESTINATION_REGISTER_BIT 3
+/* The A metadata (bit 2) of a word, as a mask. */
+#define ABSOLUTE_MASK 4
 
 /* --- Basic general constants. --- */
 
@@ -242,6 +581,8 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
 #define EQUAL_STRINGS 0
 /* Used to acccess the last character in a string. */
 #define LAST_INDEX_DIFF 1
+/* Used to count or to skip a single entry. */
+#define SINGLE_ENTRY 1
 
 /* --- Invalid values that can be returned from some functions. --- */
 
@@ -255,24 +596,46 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
  * to numbers.
  */
 #define INVALID_DIGIT 0
-/*
- * Return value of strings that are not operation names, when trying to find
- * their corresponding operations' identifiers.
- */
-#define INVALID_OPERATION 16
 
-/*
- * --- Extra information that is only relevant because of the ordering of the
- * operations. ---
- */
+/* --- Keywords. --- */
+
+/* The number of keywords (the operations, the 4 directives, macr and
+ * endmacr). */
+#define KEYWORD_COUNT 22
+
+/* The keywords that are not operations, numbered right after the operations. */
+enum {
+    DATA_KEYWORD = OPERATION_COUNT,
+    STRING_KEYWORD,
+    ENTRY_KEYWORD,
+    EXTERN_KEYWORD,
+    MACRO_KEYWORD,
+    END_MACRO_KEYWORD,
+    /* Any word that is not a keyword. */
+    NOT_A_KEYWORD
+};
 
-/* The last operation that expects 2 operands in the defined order. */
-#define LAST_OPERATION_WITH_TWO_OPERANDS 4
 /*
- * The last operation that expects 1 operand (after the ones that expect 2) in
- * the defined order.
+ * --- The addressing modes an operand can have, as masks (the bit of each mode
+ * is its OperandType, which is also where it is encoded in the first word). ---
  */
-#define LAST_OPERATION_WITH_ONE_OPERAND 13
+
+/* No addressing mode (no operand). */
+#define NO_MODES 0
+/* Immediate values (#5). */
+#define IMMEDIATE_MODE 1
+/* Labels (LOOP). */
+#define DIRECT_MODE 2
+/* Indirect registers (*r1). */
+#define INDIRECT_REGISTER_MODE 4
+/* Direct registers (r1). */
+#define DIRECT_REGISTER_MODE 8
+/* Labels and indirect registers, which can be jumped to. */
+#define JUMP_MODES (DIRECT_MODE | INDIRECT_REGISTER_MODE)
+/* Every mode besides immediate values, which can be written to. */
+#define WRITABLE_MODES (JUMP_MODES | DIRECT_REGISTER_MODE)
+/* Every mode. */
+#define ALL_MODES (WRITABLE_MODES | IMMEDIATE_MODE)
 
 /*
  * --- Information relating to bits and bytes that is not affected by the
@@ -289,5 +652,275 @@ enum { FIRST_BIT, SECOND_BIT, THIRD_BIT };
 #define NEWLINE_BYTE 1
 /* The byte taken by a dot character. */
 #define DOT_BYTE 1
+/* The base of decimal numbers. */
+#define DECIMAL_BASE 10
+
+/* --- Types that are sized by the constants above. --- */
+
+/* The words of the code part or of the data part, stored one after another. */
+typedef struct {
+    /* The words, followed by a scratch word for the words that do not fit. */
+    Word words[TOTAL_MEMORY_CELLS + SCRATCH_WORD];
+    /* The number of words that have been added (not counting the scratch). */
+    WordCount count;
+} WordImage;
+
+/* Kind of a token in a line. */
+typedef enum {
+    /* Characters up to the next whitespace character or comma. */
+    WORD_TOKEN,
+    /* The first word in the line, when it ends with a colon. */
+    LABEL_TOKEN,
+    /* A single comma. */
+    COMMA_TOKEN
+} TokenKind;
+
+/* A token in a line, found by the lexer. */
+typedef struct {
+    /* The index of the token's first character in the line. */
+    Length offset;
+    /* The number of characters in the token (a label's colon included). */
+    Length length;
+    /* The kind of the token. */
+    TokenKind kind;
+} Token;
+
+/* A line that has been split into tokens, once for all the stages. */
+typedef struct {
+    /* The original line. */
+    char *line;
+    /* The number of characters in the original line. */
+    Length lineLength;
+    /*
+     * Copy of the line with a null character after each word (and instead of
+     * a label's colon), so that each word can be used as a string.
+     */
+    char text[MAX_LINE_LENGTH + NEWLINE_BYTE + NULL_BYTE];
+    /* The tokens in the line, in order. */
+    Token tokens[MAX_TOKEN_COUNT];
+    /* The number of tokens in the line. */
+    Index count;
+    /* The keyword of the first word after the label (if there is one), found
+     * once by the lexer, or NOT_A_KEYWORD. */
+    Index keyword;
+} TokenLine;
+
+/* An operand of an instruction, as found while validating it. */
+typedef struct {
+    /* The addressing mode of the operand (ABSENT_OPERAND if there is none). */
+    OperandType type;
+    /* The number of a register, or an immediate value. */
+    short value;
+    /* The label of a direct operand (it belongs to the token line). */
+    char *label;
+} ParsedOperand;
+
+/* A line as found while validating it, so that it is encoded without being
+ * parsed again. */
+typedef struct {
+    /* The source operand of an instruction line. */
+    ParsedOperand source;
+    /* The destination operand of an instruction line. */
+    ParsedOperand destination;
+    /* The numbers of a .data line. */
+    short numbers[MAX_TOKEN_COUNT];
+    /* The number of numbers in a .data line. */
+    Index numberCount;
+} ParsedLine;
+
+/* What has been measured while compiling a single file (--time-report). */
+typedef struct {
+    /* The name of the file. */
+    char *fileName;
+    /* The number of seconds each phase took (0 if it did not run). */
+    double phaseTimes[PHASE_COUNT];
+    /* The number of macro-expanded lines. */
+    unsigned long lineCount;
+    /* The number of words in the code and data parts. */
+    unsigned long wordCount;
+    /* The number of different labels (defined, declared or used). */
+    unsigned long labelCount;
+    /* The number of macros defined. */
+    unsigned long macroCount;
+} FileReport;
+
+/*
+ * Struct that is shared between all the worker threads that compile files at
+ * the same time.
+ */
+typedef struct {
+    /* The names of the files to compile. */
+    char **fileNames;
+    /* The number of files to compile. */
+    int fileCount;
+    /* The index of the next file that no worker has taken yet. */
+    int nextFile;
+    /* The messages of each file, printed in order once the file is done. */
+    MessageQueue *messages;
+    /* Whether each file has been compiled. */
+    Boolean *isDone;
+    /* The options given as command line arguments. */
+    Options *options;
+    /* The time report of each file (NULL if --time-report is not given). */
+    FileReport *reports;
+    /* Guards nextFile and isDone. */
+    pthread_mutex_t lock;
+    /* Signaled whenever a file is done. */
+    pthread_cond_t fileDone;
+} WorkQueue;
+
+/*
+ * Ring of expanded lines, written by the thread that expands the macros of a
+ * file and read by the thread that parses them (a single thread on each side).
+ * Each side works on its own lines without the lock, and takes it only to hand
+ * over a batch of lines or to wait.
+ */
+typedef struct {
+    /* The lines, RING_SLOT_SIZE characters for each slot. */
+    char *slots;
+    /* The number of lines written so far (only by the expanding thread). */
+    unsigned long written;
+    /* The written lines may go up to this count (only the expanding thread). */
+    unsigned long writeLimit;
+    /* The number of lines read so far (only by the parsing thread). */
+    unsigned long read;
+    /* The lines may be read up to this count (only the parsing thread). */
+    unsigned long readLimit;
+    /* The number of lines handed over to the parsing thread. */
+    unsigned long published;
+    /* The number of lines the parsing thread is done with (their slots are
+     * free again). */
+    unsigned long freed;
+    /* Whether no more lines will be written. */
+    Boolean isFinished;
+    /* Whether the expansion failed, so the rest of the lines are not needed. */
+    Boolean isCancelled;
+    /* Guards published, freed, isFinished and isCancelled. */
+    pthread_mutex_t lock;
+    /* Signaled whenever lines are handed over or the ring is finished. */
+    pthread_cond_t hasLines;
+    /* Signaled whenever slots are freed. */
+    pthread_cond_t hasRoom;
+} LineRing;
+
+/*
+ * The parsing of a file on its own thread, while its macros are expanded.
+ * The macros are not known yet, so the names of the labels are checked against
+ * them only after both stages are done.
+ */
+typedef struct {
+    /* The ring that the expanded lines arrive in. */
+    LineRing ring;
+    /* The thread that parses the lines. */
+    pthread_t thread;
+    /* The name of the file. */
+    char *fileName;
+    /* An empty macro table (no name is taken by a macro while parsing). */
+    MacroTable macros;
+    /* The words in the code part. */
+    WordImage code;
+    /* The words in the data part. */
+    WordImage data;
+    /* The entry labels list. */
+    Label *entryLabels;
+    /* The extern labels list. */
+    Label *externLabels;
+    /* The used labels list. */
+    UsedLabel *usedLabels;
+    /* The found labels list. */
+    FoundLabel *foundLabels;
+    /* The number of words in the code part. */
+    WordCount instructionCount;
+    /* The number of words in the data part. */
+    WordCount dataCount;
+    /* Whether no errors were found while parsing. */
+    Boolean isSuccessful;
+    /* The messages of the parsing, printed only if its results are kept. */
+    MessageQueue messages;
+    /* The memory of the parsing thread (kept until the file is done). */
+    ToFree toFree;
+} ParsingStage;
+
+/*
+ * A range of the expanded lines of a file, parsed on its own thread as if it
+ * were a file of its own: its words, addresses and line numbers all start from
+ * 0, and are moved after the ranges before it once all of them are parsed.
+ */
+typedef struct {
+    /* The thread that parses the range. */
+    pthread_t thread;
+    /* The name of the file. */
+    char *fileName;
+    /* The macro table of the whole file (only read while parsing). */
+    MacroTable *macros;
+    /* The lines of the range (pointing into the expanded text). */
+    TextBuffer text;
+    /* The number of lines before the range. */
+    LineNumber firstLine;
+    /* The words in the code part. */
+    WordImage code;
+    /* The words in the data part. */
+    WordImage data;
+    /* The entry labels list. */
+    Label *entryLabels;
+    /* The extern labels list. */
+    Label *externLabels;
+    /* The used labels list. */
+    UsedLabel *usedLabels;
+    /* The found labels list. */
+    FoundLabel *foundLabels;
+    /* The number of words in the code part. */
+    WordCount instructionCount;
+    /* The number of words in the data part. */
+    WordCount dataCount;
+    /* Whether no errors were found while parsing. */
+    Boolean isSuccessful;
+    /* The messages of the range, printed in the order of the ranges. */
+    MessageQueue messages;
+    /* The memory of the thread (kept until the file is done). */
+    ToFree toFree;
+} ParsingChunk;
+
+/* The ranges that the expanded lines of a single file are parsed in. */
+typedef struct {
+    /* The ranges, in the order of their lines (NULL if there are none). */
+    ParsingChunk *chunks;
+    /* The number of ranges. */
+    unsigned int count;
+} ChunkedReading;
+
+/* The cache entry of a single file, while it is looked up and recorded. */
+typedef struct {
+    /* The path of the entry in the cache directory (NULL if not cached). */
+    char *path;
+    /* The path the entry is written to before it is complete. */
+    char *temporaryPath;
+    /* The size of the .as file that the entry belongs to. */
+    unsigned long sourceSize;
+    /* The file the entry is written to (NULL if it is not recorded). */
+    FILE *file;
+    /* The messages of the file, kept to be recorded before they are printed. */
+    MessageQueue messages;
+    /* The queue the messages were stored in before (NULL if none). */
+    MessageQueue *previousMessages;
+} CacheEntry;
+
+/* A single record of a cache entry, as it is read back. */
+typedef struct {
+    /* The kind of the record (an output file, a message or the end). */
+    char type;
+    /* The extension of the output file (for output records). */
+    char extension[CACHE_EXTENSION_SIZE];
+    /* The kind of the message (for message records). */
+    MessageKind kind;
+    /* Whether the name is of a macro or of a label (for name errors). */
+    Boolean isMacro;
+    /* The line number of the message (for message records). */
+    LineNumber lineNumber;
+    /* The contents of the output file or the text of the message. */
+    char *text;
+    /* The number of characters in the text. */
+    size_t length;
+} CacheRecord;
 
 #endif
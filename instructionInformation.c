@@ -16,45 +16,131 @@
 
 #include "globals.h" /* Constants and typedefs. */
 
-Index getOperationIndex(char operation[]) {
-    /* The array defining the unique identifiers for each operation. */
-    static char *OPERATIONS[OPERATION_COUNT] = {
+/* The instruction set, in the order of the operations (by identifier). */
+static InstructionDescription INSTRUCTIONS[OPERATION_COUNT] = {
+    {TWO_OPERANDS, ALL_MODES, WRITABLE_MODES,
+     (MOV << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {TWO_OPERANDS, ALL_MODES, ALL_MODES,
+     (CMP << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {TWO_OPERANDS, ALL_MODES, WRITABLE_MODES,
+     (ADD << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {TWO_OPERANDS, ALL_MODES, WRITABLE_MODES,
+     (SUB << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {TWO_OPERANDS, DIRECT_MODE, WRITABLE_MODES,
+     (LEA << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, WRITABLE_MODES,
+     (CLR << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, WRITABLE_MODES,
+     (NOT << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, WRITABLE_MODES,
+     (INC << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, WRITABLE_MODES,
+     (DEC << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, JUMP_MODES,
+     (JMP << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, JUMP_MODES,
+     (BNE << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, WRITABLE_MODES,
+     (RED << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, ALL_MODES,
+     (PRN << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {ONE_OPERAND, NO_MODES, JUMP_MODES,
+     (JSR << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {NO_OPERANDS, NO_MODES, NO_MODES,
+     (RTS << STARTING_OPERATION_BIT) | ABSOLUTE_MASK},
+    {NO_OPERANDS, NO_MODES, NO_MODES,
+     (STOP << STARTING_OPERATION_BIT) | ABSOLUTE_MASK}};
+
+Index getKeywordIndex(char word[]) {
+    /* The array defining the unique identifiers for each keyword. */
+    static char *KEYWORDS[KEYWORD_COUNT] = {
         "mov", "cmp", "add", "sub", "lea", "clr", "not", "inc",
-        "dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop"};
-
-    Index index; /* The current index in the array. */
-
-    /* Loop over the array to search for the given operation. */
-    for (index = INITIAL_VALUE; index < OPERATION_COUNT; index++) {
-        /* Compare the names. */
-        if (strcmp(operation, OPERATIONS[index]) == EQUAL_STRINGS) {
-            /* The operation has been found. */
-            return index;
-        }
+        "dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop",
+        ".data", ".string", ".entry", ".extern", "macr", "endmacr"};
+
+    Index candidate; /* The only keyword the word can be. */
+
+    /*
+     * Narrow the word down to a single keyword by its first characters (no two
+     * keywords share both of them), so only one comparison is needed.
+     * The second and third characters exist, since the ones before them are
+     * not null characters.
+     */
+    switch (word[FIRST_INDEX]) {
+        case 'a':
+            candidate = ADD;
+            break;
+        case 'b':
+            candidate = BNE;
+            break;
+        case 'c':
+            candidate = word[SECOND_INDEX] == 'm' ? CMP : CLR;
+            break;
+        case 'd':
+            candidate = DEC;
+            break;
+        case 'e':
+            candidate = END_MACRO_KEYWORD;
+            break;
+        case 'i':
+            candidate = INC;
+            break;
+        case 'j':
+            candidate = word[SECOND_INDEX] == 'm' ? JMP : JSR;
+            break;
+        case 'l':
+            candidate = LEA;
+            break;
+        case 'm':
+            candidate = word[SECOND_INDEX] == 'o' ? MOV : MACRO_KEYWORD;
+            break;
+        case 'n':
+            candidate = NOT;
+            break;
+        case 'p':
+            candidate = PRN;
+            break;
+        case 'r':
+            candidate = word[SECOND_INDEX] == 'e' ? RED : RTS;
+            break;
+        case 's':
+            candidate = word[SECOND_INDEX] == 'u' ? SUB : STOP;
+            break;
+        case '.':
+            /* The directives differ by their second (or third) character. */
+            switch (word[SECOND_INDEX]) {
+                case 'd':
+                    candidate = DATA_KEYWORD;
+                    break;
+                case 's':
+                    candidate = STRING_KEYWORD;
+                    break;
+                case 'e':
+                    candidate = word[THIRD_INDEX] == 'n' ? ENTRY_KEYWORD
+                                                         : EXTERN_KEYWORD;
+                    break;
+                default:
+                    return NOT_A_KEYWORD;
+            }
+            break;
+        default:
+            /* No keyword starts with this character. */
+            return NOT_A_KEYWORD;
     }
 
-    /* The operation has not been found. */
-    return INVALID_OPERATION;
+    /* Compare the whole word to the only possible keyword. */
+    return strcmp(word, KEYWORDS[candidate]) == EQUAL_STRINGS ? candidate
+                                                              : NOT_A_KEYWORD;
 }
 
-OperandCount getOperandCount(char operation[]) {
-    Index operationIndex; /* The unique index of the given operation. */
-
-    /* Operations that expect the same number of operands are close together. */
-    operationIndex = getOperationIndex(operation);
-
-    /* The last operation that expects 2 operands is the 5th one. */
-    if (operationIndex <= LAST_OPERATION_WITH_TWO_OPERANDS) {
-        return TWO_OPERANDS;
-    }
-
-    /* The last operation that expects 1 operand is the 14th one. */
-    if (operationIndex <= LAST_OPERATION_WITH_ONE_OPERAND) {
-        return ONE_OPERAND;
-    }
+OperandCount getOperandCount(Index operationIndex) {
+    /* Take the number from the instruction set. */
+    return INSTRUCTIONS[operationIndex].operandCount;
+}
 
-    /* After that, all the operations expect no operands. */
-    return NO_OPERANDS;
+Word getOperationTemplate(Index operationIndex) {
+    /* Take the template from the instruction set. */
+    return INSTRUCTIONS[operationIndex].template;
 }
 
 OperandType getOperandType(char operand[]) {
@@ -79,75 +165,14 @@ OperandType getOperandType(char operand[]) {
     }
 }
 
-Boolean doesOperationAcceptOperand(char operation[], char operand[],
+Boolean doesOperationAcceptOperand(Index index, OperandType type,
                                    Boolean isSource) {
-    Index index;      /* The index of the given operation. */
-    OperandType type; /* The type of the given operand. */
-
-    /* Get the index and the addressing mode. */
-    index = getOperationIndex(operation);
-    type = getOperandType(operand);
-
-    /* These operations do not expect any operands. */
-    if (index == RTS || index == STOP) {
-        return FALSE;
-    }
-
-    /* Split the cases into 2 groups - source and destination. */
-    if (isSource) {
-        /* Split based on the addressing mode. */
-        switch (type) {
-            case IMMEDIATE:
-                /* Only the operations that appear are valid for the type. */
-                return index == MOV || index == CMP || index == ADD ||
-                       index == SUB;
-
-            case DIRECT:
-                return index == MOV || index == CMP || index == ADD ||
-                       index == SUB || index == LEA;
-
-            case INDIRECT_REGISTER:
-                return index == MOV || index == CMP || index == ADD ||
-                       index == SUB;
-
-            case DIRECT_REGISTER:
-                return index == MOV || index == CMP || index == ADD ||
-                       index == SUB;
-
-            default:
-                /* Should not happen. */
-                return FALSE;
-        }
-    }
-
-    /* Split based on the addressing mode. */
-    switch (type) {
-        case IMMEDIATE:
-            /* Only the operations that appear are valid for the type. */
-            return index == CMP || index == PRN;
-
-        case DIRECT:
-            return index == MOV || index == CMP || index == ADD ||
-                   index == SUB || index == LEA || index == CLR ||
-                   index == NOT || index == INC || index == DEC ||
-                   index == JMP || index == BNE || index == RED ||
-                   index == PRN || index == JSR;
+    Mask modes; /* The addressing modes the operand can have. */
 
-        case INDIRECT_REGISTER:
-            return index == MOV || index == CMP || index == ADD ||
-                   index == SUB || index == LEA || index == CLR ||
-                   index == NOT || index == INC || index == DEC ||
-                   index == JMP || index == BNE || index == RED ||
-                   index == PRN || index == JSR;
+    /* Get the modes of the operand's position. */
+    modes = isSource ? INSTRUCTIONS[index].sourceModes
+                     : INSTRUCTIONS[index].destinationModes;
 
-        case DIRECT_REGISTER:
-            return index == MOV || index == CMP || index == ADD ||
-                   index == SUB || index == LEA || index == CLR ||
-                   index == NOT || index == INC || index == DEC ||
-                   index == RED || index == PRN;
-
-        default:
-            /* Should not happen. */
-            return FALSE;
-    }
+    /* The bit of the operand's addressing mode must be in the modes. */
+    return (modes & (SINGLE_BIT << type)) != NO_MODES;
 }
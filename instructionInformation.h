@@ -16,29 +16,44 @@
 #include "globals.h" /* Typedefs. */
 
 /**
- * Computes and returns the unique index of the given operation from an array in
- * memory.
+ * Computes and returns the unique index of the given keyword (an operation, a
+ * directive, macr or endmacr).
+ * The operations' indices come first, in the order of the operations.
+ * The word is narrowed down to a single keyword by a switch on its first
+ * characters, so it is compared to at most one keyword.
  *
- * Assumes that the given operation is not NULL and is null-terminated.
+ * Assumes that the given word is not NULL and is null-terminated.
  *
- * @param operation The operation to get the index of.
- * @return The unique index of the given operation.
+ * @param word The word to get the index of.
+ * @return The unique index of the given keyword, or NOT_A_KEYWORD if the word
+ * is not a keyword.
  */
-Index getOperationIndex(char operation[]);
+Index getKeywordIndex(char word[]);
 
 /**
  * Computes and returns the number of operands the given operation expects to
  * get.
  * Can be either 0, 1 or 2.
  *
- * Assumes that the given operation is not NULL, is null-terminated and
- * represents an actual operation.
+ * Assumes that the given index is the index of an actual operation.
  *
- * @param operation The operation to get the number of operands for.
+ * @param operationIndex The index of the operation to get the number of
+ * operands for.
  * @return The number of operands the given operation expects to get (0, 1 or
  * 2).
  */
-OperandCount getOperandCount(char operation[]);
+OperandCount getOperandCount(Index operationIndex);
+
+/**
+ * Returns the first word of the given operation's instructions before the
+ * addressing modes of the operands are added to it.
+ *
+ * Assumes that the given index is the index of an actual operation.
+ *
+ * @param operationIndex The index of the operation to get the template of.
+ * @return The first word's template.
+ */
+Word getOperationTemplate(Index operationIndex);
 
 /**
  * Computes and returns the type (addressing mode) of the given operand.
@@ -54,21 +69,19 @@ OperandCount getOperandCount(char operation[]);
 OperandType getOperandType(char operand[]);
 
 /**
- * Checks and returns whether or not the given operation can receive the given
- * operand.
+ * Checks and returns whether or not the given operation can receive an operand
+ * of the given type (addressing mode), by checking it against the operation's
+ * modes in the instruction set.
  *
- * Assumes that the given operation is not NULL, is null-terminated and
- * represents an actual operation.
- * Assumes that the given operand is not NULL, is null-terminated and represents
- * an actual operand.
+ * Assumes that the given index is the index of an actual operation.
  *
- * @param operation The operation to check.
- * @param operand The operand to check.
+ * @param index The index of the operation to check.
+ * @param type The type (addressing mode) of the operand to check.
  * @param isSource Whether the operand is the source or the destination of the
  * instruction.
- * @return Whether or not the given operation can receive the given operand.
+ * @return Whether or not the given operation can receive such an operand.
  */
-Boolean doesOperationAcceptOperand(char operation[], char operand[],
+Boolean doesOperationAcceptOperand(Index index, OperandType type,
                                    Boolean isSource);
 
 #endif
@@ -13,31 +13,30 @@
 
 #include "encoder.h" /* Encoding label addresses into words. */
 #include "errorHandling.h" /* Printing errors, if no definition is found for a label. */
-#include "foundLabelList.h" /* Searching through the found label list. */
-#include "globals.h"        /* Constants and typedefs. */
-#include "labelList.h"      /* Searching through the list of extern labels. */
+#include "globals.h"     /* Constants and typedefs. */
+#include "symbolTable.h" /* Searching for the symbols of the used labels. */
 
-Boolean linkLabels(char fileName[], Label *externLabels, UsedLabel *usedLabels,
-                   FoundLabel *foundLabels, WordCount instructionCount) {
+Boolean linkLabels(char fileName[], WordImage *code, SymbolTable *symbols,
+                   UsedLabel *usedLabels, WordCount instructionCount) {
     Boolean isSuccessful; /* Whether all the used labels are defined somehow. */
-    FoundLabel *matchingFoundLabel; /* The current used label's defintion. */
+    Symbol *symbol;       /* The current used label's symbol. */
 
     isSuccessful = TRUE;
 
     /* Loop over the used labels and link their definitions to the words. */
     while (usedLabels != NULL) {
-        /* Get the possible definition of the current used label. */
-        matchingFoundLabel = getFoundLabel(foundLabels, usedLabels->name);
+        /* Get the symbol, which holds the possible definition of the label. */
+        symbol = getSymbol(symbols, usedLabels->name);
 
         /* Check if the used label is undefined. */
-        if (matchingFoundLabel == NULL) {
+        if (symbol->definition == NULL) {
             /* The label could still be declared as extern. */
             isSuccessful =
-                handleUndefinedLabel(fileName, externLabels, usedLabels) &&
+                handleUndefinedLabel(fileName, code, symbol, usedLabels) &&
                 isSuccessful;
         } else {
             /* Encode the label's definition's address into the target word. */
-            handleDefinedLabel(usedLabels, matchingFoundLabel,
+            handleDefinedLabel(code, usedLabels, symbol->definition,
                                instructionCount);
         }
 
@@ -48,12 +47,12 @@ Boolean linkLabels(char fileName[], Label *externLabels, UsedLabel *usedLabels,
     return isSuccessful;
 }
 
-Boolean handleUndefinedLabel(char fileName[], Label *externLabels,
+Boolean handleUndefinedLabel(char fileName[], WordImage *code, Symbol *symbol,
                              UsedLabel *usedLabel) {
     /* Check if the label is declared as extern. */
-    if (containsLabel(externLabels, usedLabel->name)) {
+    if (symbol->isExtern) {
         /* Mark the target word as extern. */
-        encodeMetadata(usedLabel->wordPointer, 'E');
+        encodeMetadata(&code->words[usedLabel->wordIndex], 'E');
         /* This label is valid. */
         return TRUE;
     }
@@ -65,21 +64,24 @@ Boolean handleUndefinedLabel(char fileName[], Label *externLabels,
     return FALSE;
 }
 
-void handleDefinedLabel(UsedLabel *usedLabel, FoundLabel *foundLabel,
-                        WordCount instructionCount) {
+void handleDefinedLabel(WordImage *code, UsedLabel *usedLabel,
+                        FoundLabel *foundLabel, WordCount instructionCount) {
+    Word *word; /* The target word. */
+
+    /* Get the target word from the code image. */
+    word = &code->words[usedLabel->wordIndex];
+
     /* Mark the target word as a label that is defined in the same file. */
-    encodeMetadata(usedLabel->wordPointer, 'R');
+    encodeMetadata(word, 'R');
 
     /* Check if the label is defined in the data part. */
     if (foundLabel->isData) {
         /* Add to the label's address the instruction count and encode. */
-        encodeLabel(usedLabel->wordPointer, foundLabel->address +
-                                                (Address)instructionCount +
-                                                STARTING_MEMORY_ADDRESS);
+        encodeLabel(word, foundLabel->address + (Address)instructionCount +
+                              STARTING_MEMORY_ADDRESS);
         return;
     }
 
     /* Encode the label in the code part. */
-    encodeLabel(usedLabel->wordPointer,
-                foundLabel->address + STARTING_MEMORY_ADDRESS);
+    encodeLabel(word, foundLabel->address + STARTING_MEMORY_ADDRESS);
 }
@@ -16,8 +16,7 @@
 
 /**
  * Links all the instances of used labels with their definitions.
- * Modifies the words in the code and data parts to include the addresses of the
- * labels.
+ * Modifies the words in the code image to include the addresses of the labels.
  * Also, checks and returns whether or not all of the used labels are defined or
  * declared as extern.
  *
@@ -25,16 +24,19 @@
  * Assumes that the instruction count is the final instruction count of the file
  * to compile.
  *
+ * Assumes that the given code image pointer is not NULL.
+ * Assumes that the given symbol table has been built from the label lists.
+ *
  * @param fileName The name of the current file that is being compiled.
- * @param externLabels The list of extern labels.
+ * @param code The code image.
+ * @param symbols The symbol table of the file.
  * @param usedLabels The list of used labels.
- * @param foundLabels The list of found labels.
  * @param instructionCount The final instruction count.
  * @return TRUE if no errors occurred (all labels are defined or declared as
  * extern), FALSE otherwise.
  */
-Boolean linkLabels(char fileName[], Label *externLabels, UsedLabel *usedLabels,
-                   FoundLabel *foundLabels, WordCount instructionCount);
+Boolean linkLabels(char fileName[], WordImage *code, SymbolTable *symbols,
+                   UsedLabel *usedLabels, WordCount instructionCount);
 
 /**
  * Handles an undefined label.
@@ -43,14 +45,17 @@ Boolean linkLabels(char fileName[], Label *externLabels, UsedLabel *usedLabels,
  * If not, prints an error.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that the given code image pointer is not NULL.
+ * Assumes that the given symbol is the symbol of the given used label.
  * Assumes that the given used label is not NULL.
  *
  * @param fileName The name of the current file that is being compiled.
- * @param externLabels The list of extern labels.
+ * @param code The code image.
+ * @param symbol The symbol of the undefined used label.
  * @param usedLabel The undefined used label.
  * @return TRUE if the label has been declared as extern, FALSE otherwise.
  */
-Boolean handleUndefinedLabel(char fileName[], Label *externLabels,
+Boolean handleUndefinedLabel(char fileName[], WordImage *code, Symbol *symbol,
                              UsedLabel *usedLabel);
 
 /**
@@ -59,14 +64,16 @@ Boolean handleUndefinedLabel(char fileName[], Label *externLabels,
  * Encodes the label's definition's address into the target word, based on
  * whether the label is defined in the data part or in the code part.
  *
+ * Assumes that the given code image pointer is not NULL.
  * Assumes that the given used label is not NULL.
  * Assumes that the given found label is not NULL.
  *
+ * @param code The code image.
  * @param usedLabel The defined used label.
  * @param foundLabel The matching found label.
  * @param instructionCount The final instruction count.
  */
-void handleDefinedLabel(UsedLabel *usedLabel, FoundLabel *foundLabel,
-                        WordCount instructionCount);
+void handleDefinedLabel(WordImage *code, UsedLabel *usedLabel,
+                        FoundLabel *foundLabel, WordCount instructionCount);
 
 #endif
@@ -16,7 +16,8 @@
 
 /**
  * Adds a new label to the label list.
- * IMPORTANT: The caller must free the new label.
+ * IMPORTANT: The new label comes from the current file's arena, so it must not
+ * be freed.
  *
  * Assumes that the pointer to the labels is not NULL.
  * Assumes that the label name is not NULL and is null-terminated.
@@ -27,34 +28,4 @@
  */
 void addLabel(Label **labels, char labelName[], LineNumber lineNumber);
 
-/**
- * Searches for the given label name in the given label list.
- * Returns whether or not it has been found.
- *
- * Assumes that the given label name is not NULL and is null-terminated.
- *
- * @param labels The label list.
- * @param labelName The name of the label to search for.
- * @return TRUE if the label exists, FALSE otherwise.
- */
-Boolean containsLabel(Label *labels, char labelName[]);
-
-/**
- * Frees a list of labels.
- *
- * Assumes that the given labels have not been freed yet.
- *
- * @param labels The label list to free.
- */
-void freeLabelList(Label *labels);
-
-/**
- * Frees a single label.
- *
- * Assumes that the given label is not NULL and has not been freed yet.
- *
- * @param label The label to free.
- */
-void freeLabel(Label *label);
-
 #endif
@@ -0,0 +1,126 @@
+/*
+ * lexer.c
+ *
+ * Contains functions to split a line of the .am file into tokens.
+ * Each line is scanned only once, and the tokens are then shared by the
+ * validation, the label handling and the encoding of the line, without
+ * allocating any memory.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "lexer.h"
+
+#include "globals.h"                /* Constants and typedefs. */
+#include "instructionInformation.h" /* getKeywordIndex. */
+#include "utils.h"                  /* Classifying characters. */
+
+void lexLine(char line[], TokenLine *tokens) {
+    Length index;     /* The index of the current character. */
+    Token *token;     /* The current token. */
+    Boolean hasWord;  /* Whether a word has been found before this token. */
+    Index statement;  /* The index of the first word after the label. */
+
+    /* Start with no tokens. */
+    tokens->line = line;
+    tokens->count = EMPTY;
+    index = INITIAL_VALUE;
+    hasWord = FALSE;
+
+    /* Scan the line character by character. */
+    while (line[index] != '\0') {
+        /* Skip whitespace characters. */
+        if (getCharacterClass(line[index]) == WHITESPACE_CLASS) {
+            index++;
+            continue;
+        }
+
+        /* Start a new token. */
+        token = &tokens->tokens[tokens->count];
+        token->offset = index;
+        tokens->count++;
+
+        /* Every comma is a token of its own. */
+        if (line[index] == ',') {
+            token->length = SINGLE_ENTRY;
+            token->kind = COMMA_TOKEN;
+            index++;
+            continue;
+        }
+
+        /* Copy the word until the next whitespace character or comma. */
+        while (!(getCharacterClass(line[index]) & TOKEN_END_CLASSES)) {
+            tokens->text[index] = line[index];
+            index++;
+        }
+
+        /* End the copied word with a null character. */
+        tokens->text[index] = '\0';
+        token->length = index - token->offset;
+        token->kind = WORD_TOKEN;
+
+        /* Check if this is the first word and it ends with a colon (label). */
+        if (!hasWord && line[index - LAST_INDEX_DIFF] == ':') {
+            /* Remove the colon from the copied word. */
+            tokens->text[index - LAST_INDEX_DIFF] = '\0';
+            token->kind = LABEL_TOKEN;
+        }
+
+        /* Later words are never labels. */
+        hasWord = TRUE;
+    }
+
+    /* Remember where the line ends, and end the copy there as well. */
+    tokens->lineLength = index;
+    tokens->text[index] = '\0';
+
+    /* Find the first word, and skip it if it is a label. */
+    statement = findNextWord(tokens, FIRST_INDEX);
+    if (statement < tokens->count &&
+        tokens->tokens[statement].kind == LABEL_TOKEN) {
+        statement = findNextWord(tokens, statement + SINGLE_ENTRY);
+    }
+
+    /* Find the keyword of the line once, for all the stages. */
+    tokens->keyword = getKeywordIndex(getTokenText(tokens, statement));
+}
+
+Index findNextWord(TokenLine *tokens, Index index) {
+    /* Skip the commas. */
+    while (index < tokens->count &&
+           tokens->tokens[index].kind == COMMA_TOKEN) {
+        index++;
+    }
+
+    /* Return the index where the loop stopped. */
+    return index < tokens->count ? index : tokens->count;
+}
+
+Boolean checkIfComma(TokenLine *tokens, Index index) {
+    /* There must be a token at the index, and it must be a comma. */
+    return index < tokens->count && tokens->tokens[index].kind == COMMA_TOKEN;
+}
+
+char *getTokenText(TokenLine *tokens, Index index) {
+    /* Check if there is no token at the index. */
+    if (index >= tokens->count) {
+        /* The copy ends with a null character at the end of the line. */
+        return &tokens->text[tokens->lineLength];
+    }
+
+    /* Return the copied word. */
+    return &tokens->text[tokens->tokens[index].offset];
+}
+
+char *getRestOfLine(TokenLine *tokens, Index index) {
+    /* Check if there is no token at the index. */
+    if (index >= tokens->count) {
+        return &tokens->line[tokens->lineLength];
+    }
+
+    /* Return the original line from the token. */
+    return &tokens->line[tokens->tokens[index].offset];
+}
@@ -0,0 +1,90 @@
+/*
+ * lexer.h
+ *
+ * Contains the function prototypes for the functions in lexer.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef LEXER_H
+#define LEXER_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Splits the given line into tokens, scanning it only once.
+ * Words are separated by whitespace characters and commas, and every comma is a
+ * token of its own.
+ * The first word in the line is a label token if it ends with a colon.
+ * The keyword of the first word after the label (if there is one) is found as
+ * well, so that the line's type is only looked up once.
+ * The tokens keep pointing into the given line, so it must not change while
+ * they are used.
+ *
+ * Assumes that the given line is not NULL and is null-terminated.
+ * Assumes that the given line has at most 81 characters (80 and a newline).
+ * Assumes that the given token line pointer is not NULL.
+ *
+ * @param line The line to split.
+ * @param tokens The token line to fill.
+ */
+void lexLine(char line[], TokenLine *tokens);
+
+/**
+ * Returns the index of the first word (or label) token at the given index or
+ * after it, skipping commas.
+ * Returns the number of tokens if there is no such token.
+ *
+ * Assumes that the given token line pointer is not NULL.
+ *
+ * @param tokens The token line.
+ * @param index The index to start from.
+ * @return The index of the word, or the number of tokens if there is none.
+ */
+Index findNextWord(TokenLine *tokens, Index index);
+
+/**
+ * Checks and returns if the token at the given index is a comma.
+ * Returns FALSE if there is no token at the given index.
+ *
+ * Assumes that the given token line pointer is not NULL.
+ *
+ * @param tokens The token line.
+ * @param index The index of the token to check.
+ * @return TRUE if the token is a comma, FALSE otherwise.
+ */
+Boolean checkIfComma(TokenLine *tokens, Index index);
+
+/**
+ * Returns the word (or label) token at the given index as a null-terminated
+ * string, without a label's colon.
+ * Returns an empty string if there is no token at the given index.
+ * IMPORTANT: The string belongs to the token line. Copy it to keep it.
+ *
+ * Assumes that the given token line pointer is not NULL.
+ * Assumes that the token at the given index, if there is one, is not a comma.
+ *
+ * @param tokens The token line.
+ * @param index The index of the token.
+ * @return The token as a string.
+ */
+char *getTokenText(TokenLine *tokens, Index index);
+
+/**
+ * Returns the rest of the original line, starting from the token at the given
+ * index.
+ * Returns the end of the line (an empty string) if there is no token at the
+ * given index.
+ *
+ * Assumes that the given token line pointer is not NULL.
+ *
+ * @param tokens The token line.
+ * @param index The index of the token to start from.
+ * @return The rest of the line.
+ */
+char *getRestOfLine(TokenLine *tokens, Index index);
+
+#endif
@@ -2,6 +2,7 @@
  * lineValidation.c
  *
  * Contains functions to check for errors in each line of the .am file.
+ * Each line is checked through its tokens, which the lexer finds only once.
  *
  * Name: Ariel Keren
  * Course: C Lab, 20465
@@ -12,40 +13,47 @@
 #include "lineValidation.h"
 
 #include <ctype.h>  /* isdigit, isalpha, isalnum. */
-#include <stdlib.h> /* free, atoi. */
-#include <string.h> /* strlen, strcmp. */
+#include <stdlib.h> /* atoi. */
+#include <string.h> /* strlen. */
 
 #include "errorHandling.h"          /* Printing errors and warnings. */
 #include "globals.h"                /* Constants and typedefs. */
 #include "instructionInformation.h" /* Information about the different instructions. */
+#include "lexer.h"                  /* Going over the tokens of a line. */
 #include "utils.h"                  /* Parsing lines. */
 
-Boolean validateLine(char line[], char fileName[], LineNumber lineNumber) {
+Boolean validateLine(TokenLine *tokens, ParsedLine *parsed, char fileName[],
+                     LineNumber lineNumber) {
     Boolean isValid; /* Whether the line is valid. */
+    Index index;     /* The index of the current token. */
     char *token;     /* The current token. */
 
     /* Do not check comment lines. */
-    if (*line == ';') {
+    if (*tokens->line == ';') {
         return TRUE;
     }
 
     isValid = TRUE;
 
     /* Check for a comma at the start of the line. */
-    if (checkIfFollowedByComma(line)) {
+    if (checkIfComma(tokens, FIRST_INDEX)) {
         printError("Comma at the start of the line.", fileName, lineNumber);
         isValid = FALSE;
     }
 
-    line = skipWhitespace(line);
+    /* Find the first word. */
+    index = findNextWord(tokens, FIRST_INDEX);
 
     /* Check for an empty line. */
-    if (*line == '\0') {
+    if (index == tokens->count) {
         return isValid;
     }
 
+    /* Get the first token. */
+    token = getTokenText(tokens, index);
+
     /* Check for an invalid comment symbol, because it came after whitespace. */
-    if (*line == ';') {
+    if (*token == ';') {
         printError(
             "There should not be any whitespace characters before the "
             "semicolon in a comment line.",
@@ -53,46 +61,37 @@ Boolean validateLine(char line[], char fileName[], LineNumber lineNumber) {
         return FALSE;
     }
 
-    /* Get the first token. */
-    token = getNextToken(line);
-
     /* Check if the first token is a label. */
-    if (checkIfLabel(token)) {
-        /* Remove the colon from the token. */
-        removeEnding(token, ':');
-        /* Check if the label is valid. */
+    if (tokens->tokens[index].kind == LABEL_TOKEN) {
+        /* Check if the label (without its colon) is valid. */
         isValid = validateLabel(token, fileName, lineNumber) && isValid;
 
-        /* The label is no longer needed. */
-        free(token);
-        line = skipCharacters(line);
-
         /* Check if the label is followed by a comma. */
-        if (checkIfFollowedByComma(line)) {
+        if (checkIfComma(tokens, index + SINGLE_ENTRY)) {
             printError("Comma after the label.", fileName, lineNumber);
             isValid = FALSE;
         }
 
-        line = skipWhitespace(line);
         /* Get the second token. */
-        token = getNextToken(line);
+        index = findNextWord(tokens, index + SINGLE_ENTRY);
+        token = getTokenText(tokens, index);
 
         /* Check if the label is followed by nothing. */
-        if (token == NULL) {
+        if (index == tokens->count) {
             printError("Label with nothing after it.", fileName, lineNumber);
             return FALSE;
         }
 
         /* Check if the label is followed by either .entry or .extern. */
-        if (strcmp(token, ".entry") == EQUAL_STRINGS) {
+        if (tokens->keyword == ENTRY_KEYWORD) {
             printWarning("Label defined before .entry.", fileName, lineNumber);
-        } else if (strcmp(token, ".extern") == EQUAL_STRINGS) {
+        } else if (tokens->keyword == EXTERN_KEYWORD) {
             printWarning("Label defined before .extern.", fileName, lineNumber);
         }
     }
 
     /* Check if the first/second token is followed by a comma. */
-    if (checkIfFollowedByComma(skipCharacters(line))) {
+    if (checkIfComma(tokens, index + SINGLE_ENTRY)) {
         printError(
             "Comma after the first token in the line (excluding the label, if "
             "there is one).",
@@ -100,67 +99,54 @@ Boolean validateLine(char line[], char fileName[], LineNumber lineNumber) {
         isValid = FALSE;
     }
 
-    /* Validate the line based on its type. */
-    isValid = splitLineValidation(line, fileName, lineNumber, token) && isValid;
-    /* The token is no longer used. */
-    free(token);
-    /* Return whether the line is valid. */
-    return isValid;
+    /* Validate the line based on its type and return whether it is valid. */
+    return splitLineValidation(tokens, index, parsed, fileName, lineNumber) &&
+           isValid;
 }
 
-Boolean splitLineValidation(char line[], char fileName[], LineNumber lineNumber,
-                            char token[]) {
-    /* Check if it is a .entry line. */
-    if (strcmp(token, ".entry") == EQUAL_STRINGS) {
-        return validateEntryExtern(skipWhitespace(skipCharacters(line)),
-                                   fileName, lineNumber);
-    }
+Boolean splitLineValidation(TokenLine *tokens, Index index, ParsedLine *parsed,
+                            char fileName[], LineNumber lineNumber) {
+    Index nextIndex; /* The index of the word after the token. */
 
-    /* Check if it is a .extern line. */
-    if (strcmp(token, ".extern") == EQUAL_STRINGS) {
-        return validateEntryExtern(skipWhitespace(skipCharacters(line)),
-                                   fileName, lineNumber);
-    }
+    /* Get the index of the word after the token. */
+    nextIndex = findNextWord(tokens, index + SINGLE_ENTRY);
 
-    /* Check if it is a .data line. */
-    if (strcmp(token, ".data") == EQUAL_STRINGS) {
-        return validateData(skipWhitespace(skipCharacters(line)), fileName,
-                            lineNumber);
-    }
+    /* Split based on the token's keyword (found by the lexer). */
+    switch (tokens->keyword) {
+        case ENTRY_KEYWORD:
+        case EXTERN_KEYWORD:
+            return validateEntryExtern(tokens, nextIndex, fileName, lineNumber);
 
-    /* Check if it is a .string line. */
-    if (strcmp(token, ".string") == EQUAL_STRINGS) {
-        return validateString(skipWhitespace(skipCharacters(line)), fileName,
-                              lineNumber);
-    }
+        case DATA_KEYWORD:
+            return validateData(tokens, nextIndex, parsed, fileName,
+                                lineNumber);
 
-    /* Otherwise, it is an instruction line with an operation. */
-    return validateInstruction(line, fileName, lineNumber);
+        case STRING_KEYWORD:
+            return validateString(getRestOfLine(tokens, nextIndex), fileName,
+                                  lineNumber);
+
+        default:
+            /* Otherwise, it is an instruction line with an operation. */
+            return validateInstruction(tokens, index, parsed, fileName,
+                                       lineNumber);
+    }
 }
 
-Boolean validateEntryExtern(char label[], char fileName[],
+Boolean validateEntryExtern(TokenLine *tokens, Index index, char fileName[],
                             LineNumber lineNumber) {
     Boolean isValid; /* Whether the line is valid. */
-    char *token;     /* The label. */
 
-    /* Get only the label. */
-    token = getNextToken(label);
-    /* Check if it represents a valid label. */
-    isValid = validateLabel(token, fileName, lineNumber);
-    /* The token is no longer needed. */
-    free(token);
-    label = skipCharacters(label);
+    /* Check if the label is valid (an empty string if it is missing). */
+    isValid = validateLabel(getTokenText(tokens, index), fileName, lineNumber);
 
     /* Check if the label is followed by a comma. */
-    if (checkIfFollowedByComma(label)) {
+    if (checkIfComma(tokens, index + SINGLE_ENTRY)) {
         printError("Comma after the label.", fileName, lineNumber);
         isValid = FALSE;
     }
 
-    label = skipWhitespace(label);
-
     /* The label might not be the only token, aside from .entry/.extern. */
-    if (*label != '\0') {
+    if (findNextWord(tokens, index + SINGLE_ENTRY) != tokens->count) {
         printError("Extra non-whitespace characters after the label.", fileName,
                    lineNumber);
         return FALSE;
@@ -183,6 +169,7 @@ Boolean validateMacro(char macro[], char fileName[], LineNumber lineNumber) {
 Boolean validateName(char name[], char fileName[], LineNumber lineNumber,
                      Boolean isMacro) {
     Boolean isValid; /* Whether the name is valid. */
+    Index keyword;   /* The keyword the name is, if it is one. */
 
     /* Check if the name is empty. */
     if (*name == '\0') {
@@ -208,22 +195,25 @@ Boolean validateName(char name[], char fileName[], LineNumber lineNumber,
         isValid = FALSE;
     }
 
+    /* Find the keyword the name is, if it is one. */
+    keyword = getKeywordIndex(name);
+
     /* Check if the name is macr, a reserved keyword. */
-    if (strcmp(name, "macr") == EQUAL_STRINGS) {
+    if (keyword == MACRO_KEYWORD) {
         printNameError("cannot be named \"macr\".", fileName, lineNumber,
                        isMacro);
         isValid = FALSE;
     }
 
     /* Check if the name is endmacr, a reserved keyword. */
-    if (strcmp(name, "endmacr") == EQUAL_STRINGS) {
+    if (keyword == END_MACRO_KEYWORD) {
         printNameError("cannot be named \"endmacr\".", fileName, lineNumber,
                        isMacro);
         isValid = FALSE;
     }
 
     /* Check if the name is some reserved keyword for an operation. */
-    if (getOperationIndex(name) != INVALID_OPERATION) {
+    if (keyword < OPERATION_COUNT) {
         printNameError("cannot share the same name as an operation.", fileName,
                        lineNumber, isMacro);
         isValid = FALSE;
@@ -357,22 +347,23 @@ Boolean validateMacroEnd(char line[], char fileName[], LineNumber lineNumber) {
     return isValid;
 }
 
-Boolean validateData(char data[], char fileName[], LineNumber lineNumber) {
+Boolean validateData(TokenLine *tokens, Index index, ParsedLine *parsed,
+                     char fileName[], LineNumber lineNumber) {
     Boolean isValid;           /* Whether the line is valid.*/
     Boolean isFollowedByComma; /* Whether there was a comma. */
-    char *token;               /* The current token. */
 
     /* Check if nothing is given in the .data line. */
-    if (*data == '\0') {
+    if (index == tokens->count) {
         printError("No data specified.", fileName, lineNumber);
         return FALSE;
     }
 
     isValid = TRUE;
     isFollowedByComma = TRUE;
+    parsed->numberCount = EMPTY;
 
-    /* Loop over the tokens in the .data line. */
-    while (*data != '\0') {
+    /* Loop over the words in the .data line. */
+    while (index < tokens->count) {
         /* Check if a comma is missing between the numbers. */
         if (!isFollowedByComma) {
             printError("Missing comma between the numbers.", fileName,
@@ -380,30 +371,30 @@ Boolean validateData(char data[], char fileName[], LineNumber lineNumber) {
             isValid = FALSE;
         }
 
-        /* Get the current token. */
-        token = getNextToken(data);
-        /* Check if the token represents a valid number. */
-        isValid = validateNumber(token, fileName, lineNumber, FALSE) && isValid;
-        /* The token is no longer needed. */
-        free(token);
+        /* Check if the current word represents a valid number (and keep
+         * it). */
+        isValid = validateNumber(getTokenText(tokens, index), fileName,
+                                 lineNumber, FALSE,
+                                 &parsed->numbers[parsed->numberCount]) &&
+                  isValid;
+        parsed->numberCount++;
 
-        /* Skip the token. */
-        data = skipCharacters(data);
+        /* Check if there is a comma before the next word. */
+        isFollowedByComma = checkIfComma(tokens, index + SINGLE_ENTRY);
 
-        /* Check for multiple consecutive commas before the next token. */
-        if (checkForConsecutiveCommas(data)) {
+        /* Check for multiple consecutive commas before the next word. */
+        if (isFollowedByComma &&
+            checkIfComma(tokens, index + SINGLE_ENTRY + SINGLE_ENTRY)) {
             printError("Multiple consecutive commas between the numbers.",
                        fileName, lineNumber);
             isValid = FALSE;
         }
 
-        /* Check if there is a comma before the next token. */
-        isFollowedByComma = checkIfFollowedByComma(data);
-        /* Skip to the next token. */
-        data = skipWhitespace(data);
+        /* Skip to the next word. */
+        index = findNextWord(tokens, index + SINGLE_ENTRY);
     }
 
-    /* Check if the last token is followed by a comma. */
+    /* Check if the last word is followed by a comma. */
     if (isFollowedByComma) {
         printError("The last number is followed by a comma.", fileName,
                    lineNumber);
@@ -415,7 +406,7 @@ Boolean validateData(char data[], char fileName[], LineNumber lineNumber) {
 }
 
 Boolean validateNumber(char number[], char fileName[], LineNumber lineNumber,
-                       Boolean isImmediate) {
+                       Boolean isImmediate, short *parsedValue) {
     char *current; /* The current character in the number.*/
     int value;     /* The numerical value of the number.*/
 
@@ -439,8 +430,9 @@ Boolean validateNumber(char number[], char fileName[], LineNumber lineNumber,
         current++;
     }
 
-    /* Convert the number string to an integer. */
+    /* Convert the number string to an integer, and keep it for encoding. */
     value = atoi(number);
+    *parsedValue = (short)value;
 
     /* Immediate values have a different valid range. */
     if (isImmediate) {
@@ -498,100 +490,93 @@ Boolean validateString(char string[], char fileName[], LineNumber lineNumber) {
     return isValid;
 }
 
-Boolean validateInstruction(char instruction[], char fileName[],
+Boolean validateInstruction(TokenLine *tokens, Index index,
+                            ParsedLine *parsed, char fileName[],
                             LineNumber lineNumber) {
-    char *operation;       /* The operation of the instruction line. */
-    char *token;           /* The operand of the instruction line. */
-    OperandCount operands; /* The number of expected operands. */
+    Index operation;        /* The operation of the instruction line. */
+    char *token;            /* The operand of the instruction line. */
+    OperandCount operands;  /* The number of expected operands. */
+    ParsedOperand *operand; /* Where the current operand is kept. */
 
-    /* Get the operation. */
-    operation = getNextToken(instruction);
+    /* Get the operation (found by the lexer). */
+    operation = tokens->keyword;
 
     /* Check if the operation is invalid. */
     if (!validateOperation(operation, fileName, lineNumber)) {
-        free(operation);
         return FALSE;
     }
 
     /* Get the number of expected operands. */
     operands = getOperandCount(operation);
-    instruction = skipCharacters(instruction);
-    instruction = skipWhitespace(instruction);
+    index = findNextWord(tokens, index + SINGLE_ENTRY);
+
+    /* Start with no operands. */
+    parsed->source.type = ABSENT_OPERAND;
+    parsed->destination.type = ABSENT_OPERAND;
 
     /* Check if the operation expects no operands. */
     if (operands == NO_OPERANDS) {
         /* Check if any operands were given. */
-        if (*instruction != '\0') {
-            free(operation);
+        if (index != tokens->count) {
             printError("Operation expects no operands.", fileName, lineNumber);
             return FALSE;
         }
 
         /* End here, as there are no more tokens. */
-        free(operation);
         return TRUE;
     }
 
-    /* Get the first operand. */
-    token = getNextToken(instruction);
-
     /* Check if no operand was given. */
-    if (token == NULL) {
-        free(operation);
+    if (index == tokens->count) {
         printError("Operation expects operands, but none were given.", fileName,
                    lineNumber);
         return FALSE;
     }
 
+    /* Get the first operand (the destination, if it is the only one). */
+    token = getTokenText(tokens, index);
+    operand =
+        operands == ONE_OPERAND ? &parsed->destination : &parsed->source;
+
     /* Check if the operand is invalid. */
-    if (!validateOperand(token, fileName, lineNumber)) {
-        free(operation);
-        free(token);
+    if (!validateOperand(token, operand, fileName, lineNumber)) {
         return FALSE;
     }
 
     /* Check if the operation does not accept the first operand. */
-    if (!doesOperationAcceptOperand(operation, token,
+    if (!doesOperationAcceptOperand(operation, operand->type,
                                     operands != ONE_OPERAND)) {
-        free(operation);
-        free(token);
         printError(
             "Operation does not accept the first operand - incompatible type.",
             fileName, lineNumber);
         return FALSE;
     }
 
-    /* The first operand is no longer needed. */
-    free(token);
-    instruction = skipCharacters(instruction);
-
     /* Check if there is only one operand, that is followed by a comma. */
-    if (operands == ONE_OPERAND && checkIfFollowedByComma(instruction)) {
-        free(operation);
+    if (operands == ONE_OPERAND && checkIfComma(tokens, index + SINGLE_ENTRY)) {
         printError("Comma after the only operand.", fileName, lineNumber);
         return FALSE;
     }
 
     /* Check if there are two operands, that are not separated by a comma. */
-    if (operands == TWO_OPERANDS && !checkIfFollowedByComma(instruction)) {
-        free(operation);
+    if (operands == TWO_OPERANDS &&
+        !checkIfComma(tokens, index + SINGLE_ENTRY)) {
         printError("Missing comma between the operands.", fileName, lineNumber);
         return FALSE;
     }
 
     /* Check if the operands are separated by multiple commas. */
-    if (operands == TWO_OPERANDS && checkForConsecutiveCommas(instruction)) {
-        free(operation);
+    if (operands == TWO_OPERANDS &&
+        checkIfComma(tokens, index + SINGLE_ENTRY + SINGLE_ENTRY)) {
         printError("Multiple consecutive commas between the operands.",
                    fileName, lineNumber);
         return FALSE;
     }
 
-    instruction = skipWhitespace(instruction);
+    index = findNextWord(tokens, index + SINGLE_ENTRY);
 
     /* Check if there are more tokens when only one operand is expected. */
-    if (operands == ONE_OPERAND && *instruction != '\0') {
-        free(operation);
+    if (operands == ONE_OPERAND && index != tokens->count) {
         printError(
             "Extra non-whitespace characters after the operation - it should "
             "have only one operand.",
@@ -602,32 +587,27 @@ Boolean validateInstruction(char instruction[], char fileName[],
     /* Check if only one operand is expected. */
     if (operands == ONE_OPERAND) {
         /* End here, as there are no more tokens. */
-        free(operation);
         return TRUE;
     }
 
-    /* Get the second operand. */
-    token = getNextToken(instruction);
-
     /* Check if no second operand was given. */
-    if (token == NULL) {
-        free(operation);
+    if (index == tokens->count) {
         printError("Operation expects two operands, but only one was given.",
                    fileName, lineNumber);
         return FALSE;
     }
 
+    /* Get the second operand. */
+    token = getTokenText(tokens, index);
+
     /* Check if the second operand is invalid. */
-    if (!validateOperand(token, fileName, lineNumber)) {
-        free(operation);
-        free(token);
+    if (!validateOperand(token, &parsed->destination, fileName, lineNumber)) {
         return FALSE;
     }
 
     /* Check if the operation does not accept the second operand. */
-    if (!doesOperationAcceptOperand(operation, token, FALSE)) {
-        free(operation);
-        free(token);
+    if (!doesOperationAcceptOperand(operation, parsed->destination.type,
+                                    FALSE)) {
         printError(
             "Operation does not accept the second operand - incompatible "
             "type.",
@@ -635,21 +615,14 @@ Boolean validateInstruction(char instruction[], char fileName[],
         return FALSE;
     }
 
-    /* The operation and the second operand are no longer needed. */
-    free(operation);
-    free(token);
-    instruction = skipCharacters(instruction);
-
     /* Check if there is a comma after the second operand. */
-    if (checkIfFollowedByComma(instruction)) {
+    if (checkIfComma(tokens, index + SINGLE_ENTRY)) {
         printError("Comma after the second operand.", fileName, lineNumber);
         return FALSE;
     }
 
-    instruction = skipWhitespace(instruction);
-
     /* Check if there are more tokens when only two operands are expected. */
-    if (*instruction != '\0') {
+    if (findNextWord(tokens, index + SINGLE_ENTRY) != tokens->count) {
         printError(
             "Extra non-whitespace characters after the operation - it should "
             "have only two operands.",
@@ -661,10 +634,10 @@ Boolean validateInstruction(char instruction[], char fileName[],
     return TRUE;
 }
 
-Boolean validateOperation(char operation[], char fileName[],
+Boolean validateOperation(Index operation, char fileName[],
                           LineNumber lineNumber) {
-    /* Check if the operation could not be found (invalid). */
-    if (getOperationIndex(operation) == INVALID_OPERATION) {
+    /* Check if the keyword is not an operation (invalid). */
+    if (operation >= OPERATION_COUNT) {
         printError("Invalid operation.", fileName, lineNumber);
         return FALSE;
     }
@@ -672,19 +645,31 @@ Boolean validateOperation(char operation[], char fileName[],
     return TRUE;
 }
 
-Boolean validateOperand(char operand[], char fileName[],
+Boolean validateOperand(char operand[], ParsedOperand *parsed, char fileName[],
                         LineNumber lineNumber) {
+    /* Keep the operand's addressing mode. */
+    parsed->type = getOperandType(operand);
+
     /* Split the validation based on the operand's addressing mode. */
-    switch (getOperandType(operand)) {
+    switch (parsed->type) {
         case IMMEDIATE:
             return validateNumber(&operand[SECOND_INDEX], fileName, lineNumber,
-                                  TRUE);
+                                  TRUE, &parsed->value);
         case DIRECT:
+            /* Keep the label, to be linked later. */
+            parsed->label = operand;
             return validateLabel(operand, fileName, lineNumber);
         case INDIRECT_REGISTER:
-            return validateIndirectRegister(operand, fileName, lineNumber);
+            /* Check the register before keeping its number. */
+            if (!validateIndirectRegister(operand, fileName, lineNumber)) {
+                return FALSE;
+            }
+
+            parsed->value = convertDigitToNumber(operand[THIRD_INDEX]);
+            return TRUE;
         case DIRECT_REGISTER:
             /* If it ends up here, the operand is already a valid register. */
+            parsed->value = convertDigitToNumber(operand[SECOND_INDEX]);
             return TRUE;
         default:
             /* This should never happen. */
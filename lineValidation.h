@@ -20,49 +20,58 @@
  * the existing state of the program.
  * Prints errors and warnings to stdout.
  * NOTE: Warnings do not mean the line is invalid. They are only printed.
+ * Keeps what is found in the line (operands and numbers) in the given parsed
+ * line, so that a valid line is encoded without being parsed again.
  *
- * Assumes that the given line is not NULL and is null-terminated.
+ * Assumes that the given token line pointer is not NULL and that the line has
+ * been split into tokens.
+ * Assumes that the given parsed line pointer is not NULL.
  * Assumes that the given file name is not NULL and is null-terminated.
  *
- * @param line The line to check.
+ * @param tokens The tokens of the line to check.
+ * @param parsed The parsed line to fill.
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @return TRUE if the line contains no errors, FALSE otherwise.
  */
-Boolean validateLine(char line[], char fileName[], LineNumber lineNumber);
+Boolean validateLine(TokenLine *tokens, ParsedLine *parsed, char fileName[],
+                     LineNumber lineNumber);
 
 /**
  * Splits the validation into the different types of lines.
- * The type of the line depends on the given token.
+ * The type of the line depends on the token at the given index.
  * Returns whether or not the line is valid.
  * Prints errors to stdout.
  *
- * Assumes that the given line is not NULL and is null-terminated.
+ * Assumes that the given token line pointer is not NULL.
+ * Assumes that the given index is the index of a word (not a label's).
  * Assumes that the given file name is not NULL and is null-terminated.
- * Assumes that the given token is not NULL and is null-terminated.
  *
- * @param line The line to check.
+ * @param tokens The tokens of the line to check.
+ * @param index The index of the token to check with.
+ * @param parsed The parsed line to fill.
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
- * @param token The token to check with.
  * @return TRUE if the line contains no errors, FALSE otherwise.
  */
-Boolean splitLineValidation(char line[], char fileName[], LineNumber lineNumber,
-                            char token[]);
+Boolean splitLineValidation(TokenLine *tokens, Index index, ParsedLine *parsed,
+                            char fileName[], LineNumber lineNumber);
 
 /**
  * Checks and returns if the given entry/extern declaration is valid.
  * Prints all the errors to stdout.
  *
- * Assumes that the given label string is not NULL and is null-terminated.
+ * Assumes that the given token line pointer is not NULL.
  * Assumes that the given file name is not NULL and is null-terminated.
  *
- * @param label The entry/extern declaration to check.
+ * @param tokens The tokens of the line to check.
+ * @param index The index of the label's token (the number of tokens if there is
+ * none).
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @return TRUE if this part contains no errors, FALSE otherwise.
  */
-Boolean validateEntryExtern(char label[], char fileName[],
+Boolean validateEntryExtern(TokenLine *tokens, Index index, char fileName[],
                             LineNumber lineNumber);
 
 /**
@@ -167,16 +176,21 @@ Boolean validateMacroEnd(char line[], char fileName[], LineNumber lineNumber);
 /**
  * Checks and returns if the given .data line is valid.
  * Prints all the errors to stdout.
+ * Keeps the numbers in the given parsed line.
  *
- * Assumes that the given data string is not NULL and is null-terminated.
+ * Assumes that the given token line pointer is not NULL.
  * Assumes that the given file name is not NULL and is null-terminated.
  *
- * @param data The .data line to check.
+ * @param tokens The tokens of the .data line to check.
+ * @param index The index of the first number's token (the number of tokens if
+ * there is none).
+ * @param parsed The parsed line to fill.
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @return TRUE if this part contains no errors, FALSE otherwise.
  */
-Boolean validateData(char data[], char fileName[], LineNumber lineNumber);
+Boolean validateData(TokenLine *tokens, Index index, ParsedLine *parsed,
+                     char fileName[], LineNumber lineNumber);
 
 /**
  * Checks and returns if the given number in some .data line is valid.
@@ -195,10 +209,12 @@ Boolean validateData(char data[], char fileName[], LineNumber lineNumber);
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @param isImmediate Whether the number is an immediate value or not.
+ * @param parsedValue The value to fill with the number (only if it has only
+ * digits).
  * @return TRUE if this part contains no errors, FALSE otherwise.
  */
 Boolean validateNumber(char number[], char fileName[], LineNumber lineNumber,
-                       Boolean isImmediate);
+                       Boolean isImmediate, short *parsedValue);
 
 /**
  * Checks and returns if the given .string line is valid.
@@ -217,46 +233,55 @@ Boolean validateString(char string[], char fileName[], LineNumber lineNumber);
 /**
  * Checks and returns if the given instruction line (not .data, .string, .entry,
  * .extern) is valid. Prints all the errors to stdout.
+ * Keeps the operands in the given parsed line.
  *
- * Assumes that the given instruction string is not NULL and is null-terminated.
+ * Assumes that the given token line pointer is not NULL.
+ * Assumes that the given index is the index of a word (not a label's).
  * Assumes that the given file name is not NULL and is null-terminated.
  *
- * @param instruction The instruction line to check.
+ * @param tokens The tokens of the instruction line to check.
+ * @param index The index of the operation's token.
+ * @param parsed The parsed line to fill with the operands.
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @return TRUE if this part contains no errors, FALSE otherwise.
  */
-Boolean validateInstruction(char instruction[], char fileName[],
+Boolean validateInstruction(TokenLine *tokens, Index index,
+                            ParsedLine *parsed, char fileName[],
                             LineNumber lineNumber);
 
 /**
- * Checks and returns if the given operation is valid.
+ * Checks and returns if the given keyword is a valid operation.
  * Prints all the errors to stdout.
  *
- * Assumes that the given operation string is not NULL and is null-terminated.
  * Assumes that the given file name is not NULL and is null-terminated.
  *
- * @param operation The operation to check.
+ * @param operation The keyword of the operation to check (see
+ * getKeywordIndex).
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @return TRUE if this part contains no errors, FALSE otherwise.
  */
-Boolean validateOperation(char operation[], char fileName[],
+Boolean validateOperation(Index operation, char fileName[],
                           LineNumber lineNumber);
 
 /**
  * Checks and returns if the given operand is valid.
  * Prints all the errors to stdout.
+ * Keeps what is found in the operand in the given parsed operand.
  *
  * Assumes that the given operand string is not NULL and is null-terminated.
  * Assumes that the given file name is not NULL and is null-terminated.
  *
  * @param operand The operand to check.
+ * @param parsed The parsed operand to fill with the addressing mode, and the
+ * register's number, the immediate value or the label.
  * @param fileName The name of the file in which the line is.
  * @param lineNumber The line's line number.
  * @return TRUE if this part contains no errors, FALSE otherwise.
  */
-Boolean validateOperand(char operand[], char fileName[], LineNumber lineNumber);
+Boolean validateOperand(char operand[], ParsedOperand *parsed, char fileName[],
+                        LineNumber lineNumber);
 
 /**
  * Checks and returns if the given indirect register is valid.
@@ -2,8 +2,8 @@
  * macroExpansion.c
  *
  * Contains functions to expand the macros in the .as file.
- * Generates the macro-expanded .am file, which is used in later stages of the
- * compilation.
+ * Generates the macro-expanded text in memory, which is used in later stages of
+ * the compilation, and optionally writes it to the .am file.
  *
  * Name: Ariel Keren
  * Course: C Lab, 20465
@@ -13,69 +13,86 @@
 
 #include "macroExpansion.h"
 
-#include <stdio.h>  /* FILE, fclose, fgets, feof, getc, fputs. */
-#include <stdlib.h> /* free. */
-#include <string.h> /* strlen, strcmp. */
+#include <stdio.h> /* FILE, fclose. */
 
 #include "errorHandling.h"  /* Printing errors. */
 #include "globals.h"        /* Constants and typedefs. */
 #include "lineValidation.h" /* Checking if a macro's name is valid. */
+#include "mappedFile.h"     /* Reading the lines of the .as file. */
+#include "outputCache.h"    /* Recording the .am file's contents in the cache. */
+#include "pipeline.h"       /* Handing the expanded lines over to the parsing. */
 #include "macroTable.h" /* Adding a new macro, adding content to a macro and searching if a macro exists. */
+#include "textBuffer.h" /* Adding lines to the expanded text and writing it. */
 #include "utils.h"      /* Opening the .as and .am files and parsing lines. */
 
-Boolean expandMacros(char fileName[], Macro **macros) {
+Boolean expandMacros(char fileName[], MacroTable *macros,
+                     TextBuffer *expanded, Options *options, LineRing *ring) {
     Boolean isSuccessful; /* Whether the macro expansion is successful. */
-    FILE *inputFile;      /* The .as file. */
-    FILE *outputFile;     /* The .am file. */
+    MappedFile inputFile; /* The .as file, mapped into memory. */
+    FILE *outputFile;     /* The .am file (NULL if it is not written). */
 
-    /* Try to open the .as file. */
-    inputFile = openFile(fileName, "as", "r");
-
-    /* Check if the .as file could not be opened. */
-    if (inputFile == NULL) {
+    /* Try to map the .as file into memory. */
+    if (!mapFile(fileName, "as", &inputFile)) {
         return FALSE;
     }
 
-    /* Try to open the .am file. */
-    outputFile = openFile(fileName, "am", "w");
+    /* Start with no .am file. */
+    outputFile = NULL;
 
-    /* Check if the .am file could not be opened. */
-    if (outputFile == NULL) {
-        /* Close the open .as file. */
-        fclose(inputFile);
-        return FALSE;
+    /* Check if the .am file should be written. */
+    if (options->shouldWriteAm) {
+        /* Try to open the .am file. */
+        outputFile = openFile(fileName, "am", "w");
+
+        /* Check if the .am file could not be opened. */
+        if (outputFile == NULL) {
+            /* Unmap the .as file. */
+            unmapFile(&inputFile);
+            return FALSE;
+        }
     }
 
-    /* Expand the macros in the .as file into the .am file. */
-    isSuccessful = expandFileMacros(inputFile, outputFile, macros, fileName);
+    /* Expand the macros in the .as file into memory. */
+    isSuccessful =
+        expandFileMacros(&inputFile, expanded, macros, fileName, ring);
 
-    /* Close both files. */
-    fclose(inputFile);
-    fclose(outputFile);
+    /* Unmap the .as file. */
+    unmapFile(&inputFile);
+
+    /* Check if the .am file is open. */
+    if (outputFile != NULL) {
+        /* Write the expanded text into the .am file at once. */
+        writeTextBuffer(expanded, outputFile);
+        fclose(outputFile);
+        recordOutput("am", expanded);
+    }
 
     /* Return if the macro expansion was successful. */
     return isSuccessful;
 }
 
-Boolean expandFileMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
-                         char fileName[]) {
+Boolean expandFileMacros(MappedFile *inputFile, TextBuffer *expanded,
+                         MacroTable *macros, char fileName[], LineRing *ring) {
     Boolean isSuccessful;  /* Whether the macro expansion is successful. */
     Boolean isInsideMacro; /* Whether the current line is part of a macro. */
+    LineNumber lineIndex;  /* The index of the next line in the file. */
     LineNumber lineNumber; /* The current line's line number. */
     char line[MAX_LINE_LENGTH + NEWLINE_BYTE + NULL_BYTE]; /* Current line. */
 
     /* Initialize the necessary variables. */
     isSuccessful = TRUE;
     isInsideMacro = FALSE;
+    lineIndex = INITIAL_VALUE;
     lineNumber = INITIAL_VALUE;
 
-    /* Read each line of the .as file. */
-    while (fgets(line, sizeof(line), inputFile) != NULL) {
+    /* Read each line of the .as file from the index of its lines. */
+    while (lineIndex < inputFile->lineCount) {
         /* Update the line number. */
         lineNumber++;
 
-        /* Check if the line is too long (more than 80 characters). */
-        if (line[strlen(line) - LAST_INDEX_DIFF] != '\n' && !feof(inputFile)) {
+        /* Check if the line is too long (more than 80 characters), and copy
+         * it if it is not. */
+        if (!copyMappedLine(inputFile, &lineIndex, line)) {
             /* Print an error message. */
             printMacroError(
                 "Line is too long. Maximum length is 80 characters (including "
@@ -83,49 +100,56 @@ Boolean expandFileMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
                 fileName, lineNumber);
             isSuccessful = FALSE;
 
-            /* Skip the rest of the line. */
-            while (getc(inputFile) != '\n' && !feof(inputFile));
             /* Move on to the next line. */
             continue;
         }
 
         /* Handle the current line. */
-        if (!expandLineMacros(inputFile, outputFile, macros, fileName, line,
-                              lineNumber, &isInsideMacro)) {
+        if (!expandLineMacros(expanded, macros, fileName, line, lineNumber,
+                              &isInsideMacro)) {
             /* Finish the macro expansion and stop, in case of an error. */
             isSuccessful = FALSE;
         }
+
+        /* Hand the expanded lines over to the parsing, if it has started. */
+        if (ring != NULL) {
+            pushExpandedLines(ring, expanded, FALSE);
+        }
+    }
+
+    /* Hand over the rest of the expanded text, if the parsing has started. */
+    if (ring != NULL) {
+        pushExpandedLines(ring, expanded, TRUE);
     }
 
     /* Return if the macro expansion was successful. */
     return isSuccessful;
 }
 
-Boolean expandLineMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
+Boolean expandLineMacros(TextBuffer *expanded, MacroTable *macros,
                          char fileName[], char line[], LineNumber lineNumber,
                          Boolean *isInsideMacro) {
-    char *token; /* The first token in the line. */
+    TokenSlice token; /* The first token in the line. */
 
     /* Check if the line is part of a macro. */
     if (*isInsideMacro) {
-        return handleInsideMacro(*macros, fileName, line, lineNumber,
+        return handleInsideMacro(macros->latest, fileName, line, lineNumber,
                                  isInsideMacro);
     }
 
     /* Check if the line is empty. */
     if (*skipWhitespace(line) == '\0') {
-        /* Write the line to the .am file. */
-        fputs(line, outputFile);
+        /* Add the line to the expanded text. */
+        appendText(expanded, line);
         return TRUE;
     }
 
     /* Get the first token in the line. */
-    token = getNextToken(skipWhitespace(line));
+    token = getTokenSlice(skipWhitespace(line));
 
     /* Check if the first token is "endmacr", but not after a macro. */
-    if (strcmp(token, "endmacr") == EQUAL_STRINGS) {
+    if (compareTokenSlice(token, "endmacr")) {
         /* This is invalid. */
-        free(token);
         printMacroError("End of macro definition without declaring a macro.",
                         fileName, lineNumber);
 
@@ -133,9 +157,7 @@ Boolean expandLineMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
     }
 
     /* Check if the line is the start of a macro definition. */
-    if (strcmp(token, "macr") == EQUAL_STRINGS) {
-        free(token);
-
+    if (compareTokenSlice(token, "macr")) {
         /* Check if the definition is valid. */
         if (!validateMacroDefinition(line, fileName, lineNumber)) {
             return FALSE;
@@ -150,54 +172,43 @@ Boolean expandLineMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
     }
 
     /* Decide whether to write the line or expand a macro. */
-    writeLine(outputFile, *macros, line, token);
-    /* The token is no longer used. */
-    free(token);
-
+    writeLine(expanded, macros, line, token);
     return TRUE;
 }
 
-Boolean handleMacroDefinition(Macro **macros, char fileName[], char line[],
+Boolean handleMacroDefinition(MacroTable *macros, char fileName[], char line[],
                               LineNumber lineNumber) {
-    char *macroName; /* The name of the macro. */
+    char macroName[MAX_LINE_LENGTH + NULL_BYTE]; /* The name of the macro. */
 
     /* Skip the "macr" keyword to get the macro name. */
     line = skipWhitespace(line);
     line = skipCharacters(line);
     line = skipWhitespace(line);
 
-    /* Get the macro name. */
-    macroName = getNextToken(line);
+    /* Get the macro name, without allocating any memory yet. */
+    copyTokenSlice(macroName, getTokenSlice(line));
 
     /* Check if the macro name does not follow the rules. */
     if (!validateMacro(macroName, fileName, lineNumber)) {
-        free(macroName);
         return FALSE;
     }
 
     /* Check if the macro is already defined. */
-    if (getMacroContent(*macros, macroName) != NULL) {
-        free(macroName);
+    if (getMacroContent(macros, macroName) != NULL) {
         printMacroError("Macro with the same name already defined.", fileName,
                         lineNumber);
         return FALSE;
     }
 
-    /* After all the checks, add the macro. */
-    addMacro(macros, macroName);
+    /* After all the checks, add the macro with a copy of its name. */
+    addMacro(macros, copyStringForFile(macroName));
     return TRUE;
 }
 
 Boolean handleInsideMacro(Macro *macro, char fileName[], char line[],
                           LineNumber lineNumber, Boolean *isInsideMacro) {
-    char *token; /* The first token in the line. */
-
-    /* Get the first token. */
-    token = getNextToken(skipWhitespace(line));
-
     /* Check if the line is the end of the macro. */
-    if (token != NULL && strcmp(token, "endmacr") == EQUAL_STRINGS) {
-        free(token);
+    if (compareTokenSlice(getTokenSlice(skipWhitespace(line)), "endmacr")) {
         /* Stop the macro definition. */
         *isInsideMacro = FALSE;
 
@@ -205,29 +216,27 @@ Boolean handleInsideMacro(Macro *macro, char fileName[], char line[],
         return validateMacroEnd(line, fileName, lineNumber);
     }
 
-    /* Free the token if it is not empty. */
-    if (token != NULL) {
-        free(token);
-    }
-
     /* Add the line to the macro's content. */
     addMacroContent(macro, line);
     return TRUE;
 }
 
-void writeLine(FILE *outputFile, Macro *macros, char line[], char token[]) {
-    char *content; /* The macro's content. */
+void writeLine(TextBuffer *expanded, MacroTable *macros, char line[],
+               TokenSlice token) {
+    char *content;                          /* The macro's content. */
+    char name[MAX_LINE_LENGTH + NULL_BYTE]; /* The token as a string. */
 
     /* Check if the given line consists of a single token. */
     if (*skipWhitespace(skipCharacters(skipWhitespace(line))) == '\0') {
         /* Check if the token is an already-defined macro's name. */
-        content = getMacroContent(macros, token);
+        copyTokenSlice(name, token);
+        content = getMacroContent(macros, name);
         /* If so, expand the macro's content. If not, write the actual line. */
-        fputs(content == NULL ? line : content, outputFile);
+        appendText(expanded, content == NULL ? line : content);
 
         return;
     }
 
-    /* Write the line, as it definitely is not a call to a macro. */
-    fputs(line, outputFile);
+    /* Add the line, as it definitely is not a call to a macro. */
+    appendText(expanded, line);
 }
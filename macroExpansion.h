@@ -12,65 +12,72 @@
 #ifndef MACRO_EXPANSION_H
 #define MACRO_EXPANSION_H
 
-#include <stdio.h> /* FILE. */
-
 #include "globals.h" /* Typedefs. */
 
 /**
  * Expands the macros in the .as file.
- * Opens the .as for reading and the .am for writing.
- * Generates the expanded .am file, which is used in later stages of the
- * compilation.
+ * Maps the .as into memory and, unless turned off, opens the .am for writing.
+ * Generates the expanded text in memory, which is used in later stages of the
+ * compilation, and writes it to the .am file at once.
+ * If a ring is given, also hands each expanded line over to the parsing as
+ * soon as it is expanded.
  * Returns whether or not the macro expansion was successful.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
- * Assumes that the given pointer to the macros is not NULL.
+ * Assumes that the given pointers to the macros, to the expanded text and to
+ * the options are not NULL.
  *
  * @param fileName The name of the source file.
  * @param macros The macro table.
+ * @param expanded The text buffer to add the expanded lines to.
+ * @param options The options given as command line arguments.
+ * @param ring The ring of the parsing thread, or NULL if there is none.
  * @return TRUE if the macro expansion was successful, FALSE otherwise.
  */
-Boolean expandMacros(char fileName[], Macro **macros);
+Boolean expandMacros(char fileName[], MacroTable *macros,
+                     TextBuffer *expanded, Options *options, LineRing *ring);
 
 /**
  * Expands the macros in the .as file line by line.
- * Inserts each line into the .am file if they don't contain macros.
+ * Inserts each line into the expanded text if they don't contain macros.
  * Remembers definitions of macros and expands them when seen.
+ * Lines that are too long are reported and skipped.
+ * If a ring is given, writes the expanded lines into it after each line.
  * Returns whether or not the macro expansion was successful.
  *
- * Assumes that the given input file pointer is not NULL.
- * Assumes that the given output file pointer is not NULL.
+ * Assumes that the given input file pointer is not NULL and that the file has
+ * been mapped and indexed.
+ * Assumes that the given pointer to the expanded text is not NULL.
  * Assumes that the given pointer to the macros is not NULL.
  * Assumes that the given file name is not NULL and is null-terminated.
  *
- * @param inputFile The .as file.
- * @param outputFile The .am file.
+ * @param inputFile The .as file, mapped into memory.
+ * @param expanded The expanded text.
  * @param macros The macro table.
  * @param fileName The name of the source file.
+ * @param ring The ring of the parsing thread, or NULL if there is none.
  * @return TRUE if the macro expansion was successful, FALSE otherwise.
  */
-Boolean expandFileMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
-                         char fileName[]);
+Boolean expandFileMacros(MappedFile *inputFile, TextBuffer *expanded,
+                         MacroTable *macros, char fileName[], LineRing *ring);
 
 /**
  * Handles each line of the .as file.
  * Determines whether the line contains a macro defintion.
  * If so, fills in the macro's content.
  * If there is a reference to an already-defined macro, inserts its content into
- * the .am file.
- * Otherwise, just inserts the current line into the .am file.
+ * the expanded text.
+ * Otherwise, just inserts the current line into the expanded text.
  * Returns whether or not the handling the line was successful.
  *
- * Assumes that the given input file pointer is not NULL.
- * Assumes that the given output file pointer is not NULL.
+ * Assumes that the given pointer to the expanded text is not NULL.
  * Assumes that the given pointer to the macros is not NULL.
  * Assumes that the given file name is not NULL and is null-terminated.
  * Assumes that the given line is not NULL and is null-terminated.
  * Assumes that the given pointer to whether or not this line is inside a macro
  * is not NULL.
  *
- * @param inputFile The .as file.
- * @param outputFile The .am file.
+ * @param expanded The expanded text.
  * @param macros The macro table.
  * @param fileName The name of the source file.
  * @param line The current line.
@@ -79,7 +86,7 @@ Boolean expandFileMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
  * definition.
  * @return TRUE if the handling of the line was successful, FALSE otherwise.
  */
-Boolean expandLineMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
+Boolean expandLineMacros(TextBuffer *expanded, MacroTable *macros,
                          char fileName[], char line[], LineNumber lineNumber,
                          Boolean *isInsideMacro);
 
@@ -99,7 +106,7 @@ Boolean expandLineMacros(FILE *inputFile, FILE *outputFile, Macro **macros,
  * @param lineNumber The current line's line number.
  * @return TRUE if the definition is valid, FALSE otherwise.
  */
-Boolean handleMacroDefinition(Macro **macros, char fileName[], char line[],
+Boolean handleMacroDefinition(MacroTable *macros, char fileName[], char line[],
                               LineNumber lineNumber);
 
 /**
@@ -124,18 +131,19 @@ Boolean handleInsideMacro(Macro *macro, char fileName[], char line[],
 
 /**
  * If the given line contains ONLY an already-defined macro's name, expands
- * the macro's content into the given output file. Otherwise, writes the
- * given line into the given output file.
+ * the macro's content into the given expanded text. Otherwise, adds the
+ * given line to the given expanded text.
  *
- * Assumes that the given output file pointer is not NULL.
+ * Assumes that the given pointer to the expanded text is not NULL.
  * Assumes that the given line is not NULL and is null-terminated.
- * Assumes that the given token is not NULL and is null-terminated.
+ * Assumes that the given token points to the first token in the given line.
  *
- * @param outputFile The .am file pointer.
+ * @param expanded The expanded text.
  * @param macros The macro table.
  * @param line The current line.
  * @param token The first token in the line (to check for a macro).
  */
-void writeLine(FILE *outputFile, Macro *macros, char line[], char token[]);
+void writeLine(TextBuffer *expanded, MacroTable *macros, char line[],
+               TokenSlice token);
 
 #endif
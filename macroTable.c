@@ -1,10 +1,12 @@
 /*
  * macroTable.c
  *
- * Contains functions to interface with a macro table, to search through it and
- * finally to free it.
+ * Contains functions to interface with a macro table and to search through it.
  * The macro table contains all the macro definitions in the .as file, along
  * with their contents.
+ * It is a hash table, so searching for a macro takes the same time no matter
+ * how many macros are defined.
+ * Everything in the table comes from the current file's arena.
  *
  * Name: Ariel Keren
  * Course: C Lab, 20465
@@ -14,83 +16,130 @@
 
 #include "macroTable.h"
 
-#include <stdlib.h> /* free. */
-#include <string.h> /* strcmp, strlen, strcpy, strcat. */
+#include <string.h> /* strcmp, strlen, memcpy. */
 
 #include "globals.h" /* Constants and typedefs. */
-#include "utils.h"   /* Allocating memory. */
+#include "utils.h"   /* Allocating memory from the file's arena and hashing names. */
+
+void initMacroTable(MacroTable *macros) {
+    /* The table starts with no slots at all. */
+    macros->slots = NULL;
+    macros->capacity = EMPTY;
+    macros->count = EMPTY;
+    macros->latest = NULL;
+}
 
-void addMacro(Macro **macros, char macroName[]) {
+void addMacro(MacroTable *macros, char macroName[]) {
     Macro *newMacro; /* The new macro. */
 
+    /* Make sure there will be enough empty slots after adding the macro. */
+    if ((macros->count + SINGLE_ENTRY) * TABLE_LOAD_DIVISOR >
+        macros->capacity) {
+        growMacroTable(macros);
+    }
+
     /* Allocate enough memory for the new macro. */
-    newMacro = allocate(sizeof(Macro));
+    newMacro = allocateForFile(sizeof(Macro));
 
     /* Set the new macro's properties. */
     newMacro->name = macroName;
     newMacro->content = "";
+    newMacro->length = EMPTY;
+    newMacro->capacity = EMPTY;
+    newMacro->hash = hashString(macroName);
+
+    /* Make the new macro the latest one. */
+    newMacro->next = macros->latest;
+    macros->latest = newMacro;
 
-    /* Add the new macro to the head of the list. */
-    newMacro->next = *macros;
-    *macros = newMacro;
+    /* Put the new macro in its slot. */
+    *findMacroSlot(macros, macroName, newMacro->hash) = newMacro;
+    macros->count++;
 }
 
 void addMacroContent(Macro *macro, char content[]) {
-    char *newContent; /* The new combined content. */
+    size_t length;      /* The length of the given content. */
+    size_t newCapacity; /* The capacity needed for the combined content. */
+    char *newContent;   /* The new, larger buffer. */
+
+    /* Compute the given content's length. */
+    length = strlen(content);
+
+    /* Check if the combined content does not fit in the current buffer. */
+    if (macro->length + length + NULL_BYTE > macro->capacity) {
+        /* Double the capacity until the combined content fits. */
+        newCapacity = macro->capacity == EMPTY ? INITIAL_BUFFER_CAPACITY
+                                               : macro->capacity;
+        while (macro->length + length + NULL_BYTE > newCapacity) {
+            newCapacity *= BUFFER_GROWTH_FACTOR;
+        }
 
-    /* Allocate enough memory for the new combined content. */
-    newContent = allocate(
-        sizeof(char) * (strlen(macro->content) + strlen(content) + NULL_BYTE));
+        /* Allocate the larger buffer and copy the old content into it. */
+        newContent = allocateForFile(sizeof(char) * newCapacity);
+        memcpy(newContent, macro->content, macro->length);
 
-    /* Copy the old content. */
-    strcpy(newContent, macro->content);
-    /* Free the old content if it is not empty. */
-    if (*macro->content != '\0') {
-        free(macro->content);
+        /* Replace the old buffer (taken back with the rest of the arena). */
+        macro->content = newContent;
+        macro->capacity = newCapacity;
     }
-    /* Concatenate the given content. */
-    strcat(newContent, content);
 
-    /* Replace the old content with the new content. */
-    macro->content = newContent;
+    /* Append the given content, including its null character. */
+    memcpy(&macro->content[macro->length], content, length + NULL_BYTE);
+    macro->length += length;
 }
 
-char *getMacroContent(Macro *macros, char macroName[]) {
-    /* Loop over the macros in the list and find the one with the given name. */
-    while (macros != NULL) {
-        /* Compare the macro names. */
-        if (strcmp(macros->name, macroName) == EQUAL_STRINGS) {
-            /* Return the desired content. */
-            return macros->content;
-        }
+char *getMacroContent(MacroTable *macros, char macroName[]) {
+    Macro *macro; /* The macro in the name's slot. */
 
-        /* Move on to the next macro. */
-        macros = macros->next;
+    /* Check if the table is empty. */
+    if (macros->count == EMPTY) {
+        return NULL;
     }
 
-    /* Not found. */
-    return NULL;
+    /* Find the slot of the given name. */
+    macro = *findMacroSlot(macros, macroName, hashString(macroName));
+
+    /* Return the desired content, or NULL if the slot is empty. */
+    return macro == NULL ? NULL : macro->content;
 }
 
-void freeMacroTable(Macro *macros) {
-    Macro *next; /* The next macro in the list. */
-
-    /* Loop over the macros in the list and free them. */
-    while (macros != NULL) {
-        /* Store the next macro. */
-        next = macros->next;
-        /* Free the current macro. */
-        freeMacro(macros);
-        /* Move on to the next macro. */
-        macros = next;
+Macro **findMacroSlot(MacroTable *macros, char macroName[],
+                      unsigned long hash) {
+    unsigned long index; /* The index of the current slot. */
+
+    /* Start from the slot that the hash points to. */
+    index = hash & (macros->capacity - LAST_INDEX_DIFF);
+
+    /* Move on to the next slot until an empty or matching one is found. */
+    while (macros->slots[index] != NULL &&
+           (macros->slots[index]->hash != hash ||
+            strcmp(macros->slots[index]->name, macroName) != EQUAL_STRINGS)) {
+        /* Wrap around at the end of the table. */
+        index = (index + SINGLE_ENTRY) & (macros->capacity - LAST_INDEX_DIFF);
     }
+
+    /* Return the slot where the loop stopped. */
+    return &macros->slots[index];
 }
 
-void freeMacro(Macro *macro) {
-    /* Free the name string. */
-    free(macro->name);
-    /* Free the content string. */
-    free(macro->content);
-    /* Free the macro. */
-    free(macro);
+void growMacroTable(MacroTable *macros) {
+    Macro *macro;        /* The current macro to move. */
+    unsigned long index; /* The index of the current slot. */
+
+    /* Compute the new number of slots. */
+    macros->capacity = macros->capacity == EMPTY
+                           ? INITIAL_TABLE_CAPACITY
+                           : macros->capacity * TABLE_GROWTH_FACTOR;
+
+    /* Allocate the new slots and empty them (the old ones are abandoned, as the
+     * macros are all in the list anyway). */
+    macros->slots = allocateForFile(sizeof(Macro *) * macros->capacity);
+    for (index = INITIAL_VALUE; index < macros->capacity; index++) {
+        macros->slots[index] = NULL;
+    }
+
+    /* Move every macro to its slot in the grown table. */
+    for (macro = macros->latest; macro != NULL; macro = macro->next) {
+        *findMacroSlot(macros, macro->name, macro->hash) = macro;
+    }
 }
@@ -14,20 +14,35 @@
 
 #include "globals.h" /* Typedefs. */
 
+/**
+ * Initializes the given macro table to be empty.
+ * Does not allocate any memory until the first macro is added.
+ *
+ * Assumes that the given macro table pointer is not NULL.
+ *
+ * @param macros The macro table to initialize.
+ */
+void initMacroTable(MacroTable *macros);
+
 /**
  * Adds a new macro to the given macro table with the given name.
- * IMPORTANT: The caller must free the new macro.
+ * The new macro becomes the latest macro of the table.
+ * IMPORTANT: The new macro comes from the current file's arena, so it must not
+ * be freed.
  *
- * Assumes that the given pointer to the macros is not NULL.
+ * Assumes that the given macro table pointer is not NULL.
  * Assumes that the given macro name is not NULL and is null-terminated.
+ * Assumes that no macro with the given name is in the table.
  *
  * @param macros The macro table to add the macro to.
  * @param macroName The name of the new macro.
  */
-void addMacro(Macro **macros, char macroName[]);
+void addMacro(MacroTable *macros, char macroName[]);
 
 /**
  * Appends the given content to the given macro's content.
+ * The content's buffer doubles in size whenever it is full, so that appending
+ * many lines takes linear time.
  *
  * Assumes that the given macro pointer is not NULL.
  * Assumes that the given content is not NULL and is null-terminated.
@@ -42,30 +57,42 @@ void addMacroContent(Macro *macro, char content[]);
  * If found, returns its content.
  * If not found, returns NULL.
  *
+ * Assumes that the given macro table pointer is not NULL.
  * Assumes that the given macro name is not NULL and is null-terminated.
  *
  * @param macros The macro table.
  * @param macroName The macro name to search for.
  * @return The macro's content, or NULL if not found.
  */
-char *getMacroContent(Macro *macros, char macroName[]);
+char *getMacroContent(MacroTable *macros, char macroName[]);
 
 /**
- * Frees a macro table.
+ * Returns the slot of the given macro name in the given macro table.
+ * If the macro is in the table, the slot points to it.
+ * Otherwise, the slot is the empty slot where the macro should be added.
  *
- * Assumes that the given macro table has not been freed yet.
+ * Assumes that the given macro table pointer is not NULL and that its capacity
+ * is not zero.
+ * Assumes that the given macro name is not NULL and is null-terminated.
+ * Assumes that the given hash is the hash of the given macro name.
  *
- * @param macros The macro table to free.
+ * @param macros The macro table.
+ * @param macroName The macro name to search for.
+ * @param hash The hash of the macro name.
+ * @return The slot of the macro name in the table.
  */
-void freeMacroTable(Macro *macros);
+Macro **findMacroSlot(MacroTable *macros, char macroName[],
+                      unsigned long hash);
 
 /**
- * Frees a single macro.
+ * Grows the given macro table, so that there are enough empty slots for more
+ * macros.
+ * Moves every macro to its slot in the grown table.
  *
- * Assumes that the given macro is not NULL and has not been freed yet.
+ * Assumes that the given macro table pointer is not NULL.
  *
- * @param macro The macro to free.
+ * @param macros The macro table to grow.
  */
-void freeMacro(Macro *macro);
+void growMacroTable(MacroTable *macros);
 
 #endif
@@ -0,0 +1,160 @@
+/*
+ * mappedFile.c
+ *
+ * Contains functions to read a source file through a memory mapping.
+ * The whole file is mapped at once, the newline characters are found with
+ * memchr into an index of line offsets, and each line is then copied straight
+ * out of the mapping, without going through the locking and the buffering of
+ * the standard input functions.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "mappedFile.h"
+
+#include <fcntl.h>    /* open, O_RDONLY. */
+#include <string.h>   /* memchr, memcpy. */
+#include <sys/mman.h> /* mmap, munmap. */
+#include <sys/stat.h> /* fstat. */
+#include <unistd.h>   /* close. */
+
+#include "errorHandling.h" /* Printing file errors. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "utils.h"         /* Adding the extension and allocating the index. */
+
+Boolean mapFile(char fileName[], char extension[], MappedFile *file) {
+    char *fileNameWithExtension; /* The full file name with the extension. */
+    int descriptor;              /* The descriptor of the opened file. */
+    struct stat status;          /* The status of the file (its size). */
+    void *mapping;               /* The mapped characters of the file. */
+
+    /* Combine the file name with the extension and open the file. */
+    fileNameWithExtension = addExtension(fileName, extension);
+    descriptor = open(fileNameWithExtension, O_RDONLY);
+
+    /* Check if there was a problem opening the file. */
+    if (descriptor == SYSTEM_CALL_FAILED) {
+        printFileError(fileNameWithExtension);
+        return FALSE;
+    }
+
+    /* Find the size of the file. */
+    if (fstat(descriptor, &status) == SYSTEM_CALL_FAILED) {
+        close(descriptor);
+        printFileError(fileNameWithExtension);
+        return FALSE;
+    }
+
+    file->size = (size_t)status.st_size;
+    file->text = NULL;
+
+    /* Map the file, unless it is empty (an empty mapping is invalid). */
+    if (file->size != EMPTY) {
+        mapping = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, descriptor,
+                       INITIAL_VALUE);
+
+        /* Check if there was a problem mapping the file. */
+        if (mapping == MAP_FAILED) {
+            close(descriptor);
+            printFileError(fileNameWithExtension);
+            return FALSE;
+        }
+
+        file->text = (char *)mapping;
+    }
+
+    /* The mapping stays valid after the file is closed. */
+    close(descriptor);
+
+    /* Find where every line starts. */
+    indexLines(file);
+    return TRUE;
+}
+
+void indexLines(MappedFile *file) {
+    size_t offset;   /* The offset of the current line. */
+    LineNumber line; /* The index of the current line. */
+
+    /* Count the lines first, so that the index is allocated at once. */
+    file->lineCount = EMPTY;
+    offset = INITIAL_VALUE;
+    while (offset < file->size) {
+        file->lineCount++;
+        offset = findNextLine(file, offset);
+    }
+
+    /* Allocate room for the start of every line and for the end of the file. */
+    file->lineStarts =
+        allocateForFile((file->lineCount + SINGLE_ENTRY) * sizeof(size_t));
+
+    /* Find the start of every line the same way. */
+    offset = INITIAL_VALUE;
+    for (line = INITIAL_VALUE; line < file->lineCount; line++) {
+        file->lineStarts[line] = offset;
+        offset = findNextLine(file, offset);
+    }
+
+    /* The last line ends where the file ends. */
+    file->lineStarts[file->lineCount] = file->size;
+}
+
+size_t findNextLine(MappedFile *file, size_t offset) {
+    char *newline; /* The newline character at the end of the line. */
+
+    /* Search for the end of the line. */
+    newline = memchr(&file->text[offset], '\n', file->size - offset);
+
+    /* The last line may not end with a newline character. */
+    return newline == NULL ? file->size
+                           : (size_t)(newline - file->text) + SINGLE_ENTRY;
+}
+
+Boolean copyMappedLine(MappedFile *file, LineNumber *index, char line[]) {
+    size_t start;       /* The offset of the line's first character. */
+    size_t length;      /* The number of characters in the line. */
+    size_t width;       /* The number of characters without the newline. */
+    Boolean hasNewline; /* Whether the line ends with a newline character. */
+
+    /* Find the line and its length from the index, and move past it. */
+    start = file->lineStarts[*index];
+    length = file->lineStarts[*index + SINGLE_ENTRY] - start;
+    (*index)++;
+
+    /* Do not count the newline character (the last line may not have one). */
+    hasNewline = file->text[start + length - LAST_INDEX_DIFF] == '\n';
+    width = hasNewline ? length - NEWLINE_BYTE : length;
+
+    /* Check if the line is too long (more than 80 characters). */
+    if (width > MAX_LINE_LENGTH) {
+        return FALSE;
+    }
+
+    /*
+     * Reading with fgets found the end of a line with strlen, so a null
+     * character in a line with a newline made it look too long, and skipping
+     * the rest of it skipped the next line. Keep the same diagnostics.
+     */
+    if (hasNewline && memchr(&file->text[start], '\0', width) != NULL) {
+        /* Skip the next line, if there is one. */
+        if (*index < file->lineCount) {
+            (*index)++;
+        }
+
+        return FALSE;
+    }
+
+    /* Copy the line with its newline character and end it. */
+    memcpy(line, &file->text[start], length);
+    line[length] = '\0';
+    return TRUE;
+}
+
+void unmapFile(MappedFile *file) {
+    /* Check if the file has been mapped (empty files are not). */
+    if (file->text != NULL) {
+        munmap(file->text, file->size);
+    }
+}
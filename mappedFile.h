@@ -0,0 +1,91 @@
+/*
+ * mappedFile.h
+ *
+ * Contains the function prototypes for the functions in mappedFile.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Maps the file with the given name and extension into memory, and finds where
+ * each of its lines starts.
+ * Prints a file error to stdout if the file could not be opened or mapped.
+ *
+ * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that the given extension is not NULL and is null-terminated.
+ * Assumes that the given mapped file pointer is not NULL.
+ *
+ * @param fileName The name of the file (without the extension).
+ * @param extension The extension of the file.
+ * @param file The mapped file to fill.
+ * @return Whether the file has been mapped.
+ */
+Boolean mapFile(char fileName[], char extension[], MappedFile *file);
+
+/**
+ * Finds the offset of the first character of each line in the given mapped
+ * file, searching for the newline characters with memchr.
+ * The index comes from the current file's arena.
+ *
+ * Assumes that the given mapped file pointer is not NULL and that its text and
+ * size have been set.
+ *
+ * @param file The mapped file to index.
+ */
+void indexLines(MappedFile *file);
+
+/**
+ * Returns the offset of the line after the line that starts at the given
+ * offset (the size of the file if it is the last line).
+ *
+ * Assumes that the given mapped file pointer is not NULL.
+ * Assumes that the given offset is smaller than the size of the file.
+ *
+ * @param file The mapped file.
+ * @param offset The offset of the line's first character.
+ * @return The offset of the next line's first character.
+ */
+size_t findNextLine(MappedFile *file, size_t offset);
+
+/**
+ * Copies the line with the given index (from 0) into the given buffer, the same
+ * way fgets would read it: with its newline character (if it has one) and a
+ * null character.
+ * Does not copy anything if the line is too long (more than 80 characters, not
+ * including the newline character).
+ * Moves the given index to the next line to read. Like reading with fgets, a
+ * line that has a null character before its newline is too long, and the line
+ * after it is skipped as well.
+ *
+ * Assumes that the given mapped file pointer is not NULL and that it has been
+ * indexed.
+ * Assumes that the given index is smaller than the number of lines.
+ * Assumes that the given buffer has room for 82 characters.
+ *
+ * @param file The mapped file.
+ * @param index The index of the line, to move to the next line to read.
+ * @param line The buffer to copy the line to.
+ * @return Whether the line fits in the buffer (is not too long).
+ */
+Boolean copyMappedLine(MappedFile *file, LineNumber *index, char line[]);
+
+/**
+ * Unmaps the given mapped file from memory.
+ * The index of its lines is freed with the current file's arena.
+ *
+ * Assumes that the given mapped file pointer is not NULL and that it has been
+ * mapped.
+ *
+ * @param file The mapped file to unmap.
+ */
+void unmapFile(MappedFile *file);
+
+#endif
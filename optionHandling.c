@@ -0,0 +1,127 @@
+/*
+ * optionHandling.c
+ *
+ * Contains functions to read the options given as command line arguments,
+ * before the names of the files to compile.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "optionHandling.h"
+
+#include <ctype.h>  /* isdigit. */
+#include <stdlib.h> /* exit. */
+#include <string.h> /* strcmp, strncmp, strlen. */
+
+#include "errorHandling.h" /* Printing an error if an option is invalid. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "utils.h"         /* Converting digits to numbers. */
+
+int handleOptions(char *arguments[], int argumentCount, Options *options) {
+    int index; /* The index of the current argument. */
+
+    /* Start with the default options. */
+    options->jobCount = DEFAULT_JOB_COUNT;
+    options->shouldWriteAm = TRUE;
+    options->shouldReportTime = FALSE;
+    options->parseJobCount = DEFAULT_JOB_COUNT;
+    options->cacheDirectory = NULL;
+
+    /* Read the arguments until the first one that is not an option. */
+    for (index = INITIAL_VALUE; index < argumentCount; index++) {
+        /* Check for the end of the options. */
+        if (strcmp(arguments[index], "--") == EQUAL_STRINGS) {
+            return index + ARGS_DIFF;
+        }
+
+        /* Check for skipping the .am files. */
+        if (strcmp(arguments[index], "--no-am") == EQUAL_STRINGS) {
+            options->shouldWriteAm = FALSE;
+            continue;
+        }
+
+        /* Check for printing how long each phase took. */
+        if (strcmp(arguments[index], "--time-report") == EQUAL_STRINGS) {
+            options->shouldReportTime = TRUE;
+            continue;
+        }
+
+        /* Check for caching the outputs of each file in a directory. */
+        if (strcmp(arguments[index], "--cache") == EQUAL_STRINGS) {
+            /* The directory must come right after the option. */
+            if (index + ARGS_DIFF == argumentCount) {
+                printOptionError(arguments[index]);
+                exit(ERROR);
+            }
+
+            index++;
+            options->cacheDirectory = arguments[index];
+            continue;
+        }
+
+        /* Check for the number of jobs, given separately ("-j 4"). */
+        if (strcmp(arguments[index], "-j") == EQUAL_STRINGS) {
+            /* The number must come right after the option. */
+            if (index + ARGS_DIFF == argumentCount) {
+                printOptionError(arguments[index]);
+                exit(ERROR);
+            }
+
+            index++;
+            options->jobCount = convertJobCount(arguments[index]);
+        } else if (strncmp(arguments[index], "-j", strlen("-j")) ==
+                   EQUAL_STRINGS) {
+            /* The number of jobs, given together ("-j4"). */
+            options->jobCount =
+                convertJobCount(&arguments[index][strlen("-j")]);
+        } else {
+            /* This is the first file name. */
+            return index;
+        }
+
+        /* Check if the number of jobs is invalid. */
+        if (options->jobCount == EMPTY) {
+            printOptionError(arguments[index]);
+            exit(ERROR);
+        }
+    }
+
+    /* All the arguments are options. */
+    return argumentCount;
+}
+
+unsigned int convertJobCount(char value[]) {
+    unsigned int jobCount; /* The number of jobs so far. */
+
+    jobCount = INITIAL_VALUE;
+
+    /* Check for an empty value. */
+    if (*value == '\0') {
+        return EMPTY;
+    }
+
+    /* Convert the digits one by one. */
+    while (*value != '\0') {
+        /* Check for a character that is not a digit. */
+        if (!isdigit(*value)) {
+            return EMPTY;
+        }
+
+        /* Add the digit to the number. */
+        jobCount = jobCount * DECIMAL_BASE + convertDigitToNumber(*value);
+
+        /* Check if the number is too large. */
+        if (jobCount > MAX_JOB_COUNT) {
+            return EMPTY;
+        }
+
+        /* Move on to the next digit. */
+        value++;
+    }
+
+    /* Return the number of jobs (0 is invalid anyway). */
+    return jobCount;
+}
@@ -0,0 +1,49 @@
+/*
+ * optionHandling.h
+ *
+ * Contains the function prototypes for the functions in optionHandling.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef OPTION_HANDLING_H
+#define OPTION_HANDLING_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Reads the options at the start of the command line arguments into the given
+ * options struct.
+ * Options that are not given get their default values.
+ * Stops at the first argument that is not an option, or right after "--".
+ * If an option is invalid, prints an error and exits the program.
+ * Returns the number of arguments that were read as options.
+ *
+ * Assumes that the given arguments array contains argumentCount non-NULL and
+ * null-terminated arguments (not including the program's name).
+ * Assumes that the given options pointer is not NULL.
+ *
+ * @param arguments The command line arguments (not including the program's
+ * name).
+ * @param argumentCount The number of command line arguments.
+ * @param options The options struct to fill.
+ * @return The number of arguments that were read as options.
+ */
+int handleOptions(char *arguments[], int argumentCount, Options *options);
+
+/**
+ * Converts the given value of the -j option to the number of jobs and returns
+ * it.
+ * Returns 0 if the value is not a whole number between 1 and 256, inclusive.
+ *
+ * Assumes that the given value is not NULL and is null-terminated.
+ *
+ * @param value The value to convert.
+ * @return The number of jobs, or 0 if the value is invalid.
+ */
+unsigned int convertJobCount(char value[]);
+
+#endif
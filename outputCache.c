@@ -0,0 +1,492 @@
+/*
+ * outputCache.c
+ *
+ * Contains functions to keep the outputs of each file in a cache directory
+ * (the --cache option), so that a file that has not changed is not compiled
+ * again.
+ * Each entry is named after a hash of the bytes of the .as file and of the
+ * running assembler, so an entry is never used after either of them changes.
+ * An entry holds the output files and the messages of the file, and restoring
+ * it writes the same files and prints the same messages as compiling it.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "outputCache.h"
+
+#include <errno.h>     /* errno, EEXIST. */
+#include <pthread.h>   /* pthread_key_t, pthread_once, mutexes. */
+#include <stdio.h>     /* FILE, fopen, fread, fprintf, sprintf, rename. */
+#include <stdlib.h>    /* free. */
+#include <string.h>    /* strlen, memchr, memcpy. */
+#include <sys/stat.h>  /* mkdir. */
+#include <sys/types.h> /* pid_t. */
+#include <unistd.h>    /* getpid. */
+
+#include "arena.h"         /* Taking back the memory of a restored file. */
+#include "errorHandling.h" /* Keeping the messages aside and replaying them. */
+#include "freeingLogic.h"  /* Getting the arena of the current thread. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "textBuffer.h"    /* Reading the entries and writing the outputs. */
+#include "timeReport.h"    /* Reporting a restored file with no phases. */
+#include "utils.h"         /* Allocating memory and opening the outputs. */
+
+/* The hashes of the running assembler, which every key starts from. */
+static unsigned long toolHashes[CACHE_HASH_COUNT];
+/* Makes sure that the assembler is hashed only once. */
+static pthread_once_t toolHashOnce = PTHREAD_ONCE_INIT;
+/* Whether the assembler could be read, so that the keys depend on it. */
+static Boolean isToolHashed = FALSE;
+
+/* The key of the entry that the current thread records. */
+static pthread_key_t entryKey;
+/* Makes sure that the key is created only once. */
+static pthread_once_t entryKeyOnce = PTHREAD_ONCE_INIT;
+
+/* Protects the counters below, which every worker updates. */
+static pthread_mutex_t statisticsLock = PTHREAD_MUTEX_INITIALIZER;
+/* The number of files restored from the cache. */
+static unsigned long hitCount = INITIAL_VALUE;
+/* The number of files that were looked up but had to be compiled. */
+static unsigned long missCount = INITIAL_VALUE;
+/* The number of entries started so far (to name their temporary files). */
+static unsigned long startedCount = INITIAL_VALUE;
+
+void openCache(Options *options) {
+    /* Check if the outputs are not cached. */
+    if (options->cacheDirectory == NULL) {
+        return;
+    }
+
+    /* Create the directory, unless it already exists. */
+    if (mkdir(options->cacheDirectory, CACHE_DIRECTORY_MODE) ==
+            SYSTEM_CALL_FAILED &&
+        errno != EEXIST) {
+        printCacheError("Could not create the cache directory",
+                        options->cacheDirectory);
+        options->cacheDirectory = NULL;
+        return;
+    }
+
+    /* Hash the assembler, as an entry must not outlive it: without its bytes
+     * in the keys, a rebuilt assembler would restore stale outputs. */
+    pthread_once(&toolHashOnce, hashTool);
+    if (!isToolHashed) {
+        printCacheError("Could not read the running assembler",
+                        CACHE_TOOL_PATH);
+        options->cacheDirectory = NULL;
+    }
+}
+
+Boolean restoreCachedFile(char fileName[], Options *options,
+                          CacheEntry *entry, FileReport *report) {
+    unsigned long hashes[CACHE_HASH_COUNT]; /* The hashes of the key. */
+    TextBuffer contents;                    /* The contents of the entry. */
+    Boolean isRestored; /* Whether the entry has been restored. */
+
+    /* Start with an entry that is not recorded. */
+    entry->path = NULL;
+    entry->temporaryPath = NULL;
+    entry->sourceSize = EMPTY;
+    entry->file = NULL;
+    entry->messages.first = NULL;
+    entry->messages.last = NULL;
+    entry->previousMessages = NULL;
+
+    /* Check if the outputs are not cached. */
+    if (options->cacheDirectory == NULL) {
+        return FALSE;
+    }
+
+    /* Start from the hashes of the running assembler. */
+    pthread_once(&toolHashOnce, hashTool);
+    memcpy(hashes, toolHashes, sizeof(toolHashes));
+
+    /* The .am file is one of the outputs only if it is written. */
+    hashText(hashes, options->shouldWriteAm ? "am" : "no-am");
+
+    /* Try hashing the .as file (compiling it reports the error if it fails). */
+    isRestored = FALSE;
+    if (hashFile(addExtension(fileName, "as"), hashes, &entry->sourceSize)) {
+        /* Name the entry after the key. */
+        entry->path = allocate(sizeof(char) *
+                               (strlen(options->cacheDirectory) + SLASH_BYTE +
+                                CACHE_KEY_LENGTH + NULL_BYTE));
+        sprintf(entry->path, "%s/%08lx%08lx", options->cacheDirectory,
+                hashes[FIRST_HASH], hashes[SECOND_HASH]);
+
+        /* Try restoring the outputs from the entry. */
+        if (loadCacheEntry(entry->path, entry->sourceSize, &contents)) {
+            initFileReport(report, fileName);
+            applyCacheEntry(&contents, fileName);
+            isRestored = TRUE;
+
+            /* Nothing is left to record. */
+            free(entry->path);
+            entry->path = NULL;
+        }
+    }
+
+    /* Count the lookup. */
+    pthread_mutex_lock(&statisticsLock);
+    if (isRestored) {
+        hitCount++;
+    } else {
+        missCount++;
+    }
+    pthread_mutex_unlock(&statisticsLock);
+
+    /* Take back the memory of the lookup, keeping it for the file. */
+    resetArena(getFileArena());
+
+    return isRestored;
+}
+
+Boolean hashFile(char path[], unsigned long hashes[], unsigned long *size) {
+    FILE *file;                  /* The file to hash. */
+    char block[CACHE_READ_SIZE]; /* The bytes read at once. */
+    size_t length;               /* The number of bytes read. */
+
+    /* Try opening the file. */
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    /* Hash the file a block at a time. */
+    while ((length = fread(block, sizeof(char), CACHE_READ_SIZE, file)) >
+           EMPTY) {
+        hashBytes(hashes, block, length);
+        *size += length;
+    }
+
+    fclose(file);
+    return TRUE;
+}
+
+void hashTool() {
+    unsigned long size; /* The size of the assembler (not needed). */
+
+    /* Start both hashes from their own initial values. */
+    toolHashes[FIRST_HASH] = HASH_OFFSET_BASIS;
+    toolHashes[SECOND_HASH] = CACHE_SECOND_OFFSET_BASIS;
+
+    /* Mix in the format and the assembler itself (the cache is turned off if
+     * it cannot be read). */
+    hashText(toolHashes, CACHE_FORMAT);
+    size = EMPTY;
+    isToolHashed = hashFile(CACHE_TOOL_PATH, toolHashes, &size);
+}
+
+void hashText(unsigned long hashes[], char text[]) {
+    /* Mix the text in with its null character, to separate it from the next
+     * bytes. */
+    hashBytes(hashes, text, strlen(text) + NULL_BYTE);
+}
+
+void hashBytes(unsigned long hashes[], char bytes[], size_t length) {
+    size_t index;       /* The index of the current byte. */
+    unsigned char byte; /* The current byte. */
+
+    /* Mix each byte into both hashes (FNV-1a, with 2 different primes). */
+    for (index = INITIAL_VALUE; index < length; index++) {
+        byte = (unsigned char)bytes[index];
+        hashes[FIRST_HASH] =
+            ((hashes[FIRST_HASH] ^ byte) * HASH_PRIME) & CACHE_HASH_MASK;
+        hashes[SECOND_HASH] =
+            ((hashes[SECOND_HASH] ^ byte) * CACHE_SECOND_PRIME) &
+            CACHE_HASH_MASK;
+    }
+}
+
+Boolean loadCacheEntry(char path[], unsigned long sourceSize,
+                       TextBuffer *contents) {
+    FILE *file;                  /* The entry file. */
+    char block[CACHE_READ_SIZE]; /* The bytes read at once. */
+    size_t length;               /* The number of bytes read. */
+    char *position;              /* The current record. */
+    char *end;                   /* The end of the contents. */
+    CacheRecord record;          /* The current record. */
+    unsigned long size;          /* The size of the .as file of the entry. */
+
+    /* Try opening the entry (it does not exist if the file is new). */
+    file = fopen(path, "rb");
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    /* Read the whole entry, and end it with a null character. */
+    initTextBuffer(contents);
+    while ((length = fread(block, sizeof(char), CACHE_READ_SIZE, file)) >
+           EMPTY) {
+        appendChars(contents, block, length);
+    }
+    fclose(file);
+    appendChars(contents, "", NULL_BYTE);
+    end = &contents->text[contents->length - NULL_BYTE];
+
+    /* Check the format and the size of the .as file, on the first line. */
+    position = memchr(contents->text, '\n', end - contents->text);
+    if (position == NULL ||
+        sscanf(contents->text, CACHE_FORMAT " %lu", &size) != SINGLE_ENTRY ||
+        size != sourceSize) {
+        return FALSE;
+    }
+
+    /* The records start on the next line. */
+    position++;
+    contents->position = position - contents->text;
+
+    /* Check that every record is valid, up to the end record. */
+    do {
+        position = readCacheRecord(position, end, &record);
+        if (position == NULL) {
+            return FALSE;
+        }
+    } while (record.type != END_RECORD);
+
+    /* Nothing may come after the end record. */
+    return position == end;
+}
+
+char *readCacheRecord(char *position, char *end, CacheRecord *record) {
+    char line[CACHE_RECORD_LINE_SIZE]; /* The first line of the record. */
+    char *lineEnd;                     /* The newline of the first line. */
+    int kind;                          /* The kind of the message. */
+    int isMacro;         /* Whether the message is about a macro name. */
+    unsigned long length; /* The length of the text of the record. */
+
+    /* Copy the first line of the record, if it is not too long. */
+    lineEnd = memchr(position, '\n', end - position);
+    if (lineEnd == NULL || lineEnd - position >= CACHE_RECORD_LINE_SIZE) {
+        return NULL;
+    }
+    memcpy(line, position, lineEnd - position);
+    line[lineEnd - position] = '\0';
+
+    /* Read the line according to the kind of the record. */
+    record->type = line[INITIAL_VALUE];
+    switch (record->type) {
+        case OUTPUT_RECORD:
+            /* The extension has 3 letters at most. */
+            if (sscanf(line, "%*c %3s %lu", record->extension, &length) !=
+                OUTPUT_RECORD_FIELDS) {
+                return NULL;
+            }
+            break;
+        case MESSAGE_RECORD:
+            if (sscanf(line, "%*c %d %d %lu %lu", &kind, &isMacro,
+                       &record->lineNumber, &length) != MESSAGE_RECORD_FIELDS ||
+                kind < ERROR_MESSAGE || kind >= FILE_ERROR_MESSAGE) {
+                return NULL;
+            }
+            record->kind = (MessageKind)kind;
+            record->isMacro = isMacro ? TRUE : FALSE;
+            break;
+        case END_RECORD:
+            /* The end record has no text. */
+            record->text = lineEnd + NEWLINE_BYTE;
+            record->length = EMPTY;
+            return record->text;
+        default:
+            return NULL;
+    }
+
+    /* The text comes after the line, and is followed by a newline. */
+    record->text = lineEnd + NEWLINE_BYTE;
+    if (length >= (unsigned long)(end - record->text) ||
+        record->text[length] != '\n') {
+        return NULL;
+    }
+    record->length = length;
+
+    /* Return the start of the next record. */
+    return &record->text[length + NEWLINE_BYTE];
+}
+
+void applyCacheEntry(TextBuffer *contents, char fileName[]) {
+    char *position;     /* The current record. */
+    char *end;          /* The end of the contents. */
+    CacheRecord record; /* The current record. */
+    FILE *file;         /* The current output file. */
+
+    position = &contents->text[contents->position];
+    end = &contents->text[contents->length - NULL_BYTE];
+
+    /* Apply each record, in the order they were recorded. */
+    for (position = readCacheRecord(position, end, &record);
+         record.type != END_RECORD;
+         position = readCacheRecord(position, end, &record)) {
+        /* Check if the record is a message. */
+        if (record.type == MESSAGE_RECORD) {
+            /* The newline after the text ends it instead. */
+            record.text[record.length] = '\0';
+            replayMessage(&record, fileName);
+            continue;
+        }
+
+        /* Write the output file, the same way compiling the file would. */
+        file = openFile(fileName, record.extension, "w");
+        if (file != NULL) {
+            fwrite(record.text, sizeof(char), record.length, file);
+            fclose(file);
+        }
+    }
+}
+
+void replayMessage(CacheRecord *record, char fileName[]) {
+    /* Print the message with the function that printed it originally. */
+    switch (record->kind) {
+        case ERROR_MESSAGE:
+            printError(record->text, fileName, record->lineNumber);
+            break;
+        case MACRO_ERROR_MESSAGE:
+            printMacroError(record->text, fileName, record->lineNumber);
+            break;
+        case WARNING_MESSAGE:
+            printWarning(record->text, fileName, record->lineNumber);
+            break;
+        case NAME_ERROR_MESSAGE:
+            printNameError(record->text, fileName, record->lineNumber,
+                           record->isMacro);
+            break;
+        default:
+            /* Should not happen (file errors are never cached). */
+            break;
+    }
+}
+
+void createEntryKey() {
+    /* Every thread starts without an entry (NULL). */
+    pthread_key_create(&entryKey, NULL);
+}
+
+void startCacheEntry(CacheEntry *entry) {
+    unsigned long number; /* The number of this entry in the run. */
+
+    /* Check if the file should not be recorded. */
+    if (entry->path == NULL) {
+        return;
+    }
+
+    /* Give the entry a temporary name of its own. */
+    pthread_mutex_lock(&statisticsLock);
+    number = startedCount++;
+    pthread_mutex_unlock(&statisticsLock);
+    entry->temporaryPath = allocate(
+        sizeof(char) * (strlen(entry->path) +
+                        (DOT_BYTE + MAX_DIGIT_COUNT) * TEMPORARY_NUMBER_COUNT +
+                        NULL_BYTE));
+    sprintf(entry->temporaryPath, "%s.%lu.%lu", entry->path,
+            (unsigned long)getpid(), number);
+
+    /* Try creating the entry (the file is just not cached if it fails). */
+    entry->file = fopen(entry->temporaryPath, "wb");
+    if (entry->file == NULL) {
+        free(entry->temporaryPath);
+        free(entry->path);
+        entry->temporaryPath = NULL;
+        entry->path = NULL;
+        return;
+    }
+
+    /* Start with the format and the size of the .as file. */
+    fprintf(entry->file, "%s %lu\n", CACHE_FORMAT, entry->sourceSize);
+
+    /* Keep the messages aside, to record them before they are printed. */
+    entry->previousMessages = getMessageQueue();
+    queueMessages(&entry->messages);
+
+    /* Record the output files that this thread writes. */
+    pthread_once(&entryKeyOnce, createEntryKey);
+    pthread_setspecific(entryKey, entry);
+}
+
+void recordOutput(char extension[], TextBuffer *output) {
+    CacheEntry *entry; /* The entry of the current thread. */
+
+    /* Get the entry of the current thread. */
+    pthread_once(&entryKeyOnce, createEntryKey);
+    entry = pthread_getspecific(entryKey);
+
+    /* Check if the file is not recorded. */
+    if (entry == NULL) {
+        return;
+    }
+
+    /* Record the extension and the contents, followed by a newline. */
+    fprintf(entry->file, "%c %s %lu\n", OUTPUT_RECORD, extension,
+            (unsigned long)output->length);
+    writeTextBuffer(output, entry->file);
+    fputc('\n', entry->file);
+}
+
+void finishCacheEntry(CacheEntry *entry) {
+    Boolean isStored; /* Whether the entry is stored in the cache. */
+
+    /* Check if the file was not recorded. */
+    if (entry->file == NULL) {
+        free(entry->path);
+        entry->path = NULL;
+        return;
+    }
+
+    /* Stop recording, and store the messages where they were stored before. */
+    pthread_setspecific(entryKey, NULL);
+    queueMessages(entry->previousMessages);
+
+    /* Record the messages and end the entry. */
+    isStored = recordMessages(entry->file, &entry->messages);
+    fprintf(entry->file, "%c\n", END_RECORD);
+    if (ferror(entry->file)) {
+        isStored = FALSE;
+    }
+    if (fclose(entry->file) != SUCCESS) {
+        isStored = FALSE;
+    }
+
+    /* Give the entry its name at once, so it is never read half-written. */
+    if (!isStored || rename(entry->temporaryPath, entry->path) != SUCCESS) {
+        remove(entry->temporaryPath);
+    }
+
+    /* Print the messages, now that they have been recorded. */
+    flushMessages(&entry->messages);
+
+    /* Free the paths of the entry. */
+    free(entry->temporaryPath);
+    free(entry->path);
+    entry->temporaryPath = NULL;
+    entry->path = NULL;
+    entry->file = NULL;
+}
+
+Boolean recordMessages(FILE *file, MessageQueue *messages) {
+    Message *message; /* The current message. */
+
+    /* Record each message, in order. */
+    for (message = messages->first; message != NULL; message = message->next) {
+        /* A file that could not be opened might open next time. */
+        if (message->kind == FILE_ERROR_MESSAGE) {
+            return FALSE;
+        }
+
+        /* Record the message's properties, and then its text. */
+        fprintf(file, "%c %d %d %lu %lu\n", MESSAGE_RECORD, (int)message->kind,
+                (int)message->isMacro, (unsigned long)message->lineNumber,
+                (unsigned long)strlen(message->text));
+        fprintf(file, "%s\n", message->text);
+    }
+
+    return TRUE;
+}
+
+void printCacheStatistics() {
+    /* The outputs are the same without the cache, so only stderr is used. */
+    fprintf(stderr, "\n--- Cache ---\n");
+    fprintf(stderr, "Hits: %lu\n", hitCount);
+    fprintf(stderr, "Misses: %lu\n", missCount);
+}
@@ -0,0 +1,203 @@
+/*
+ * outputCache.h
+ *
+ * Contains the function prototypes for the functions in outputCache.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef OUTPUT_CACHE_H
+#define OUTPUT_CACHE_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Creates the cache directory of the given options, if it does not exist yet,
+ * and hashes the running assembler, which every key depends on.
+ * If the directory could not be created or the assembler could not be read,
+ * prints a cache error to stderr and turns the cache off.
+ *
+ * Assumes that the given options pointer is not NULL.
+ *
+ * @param options The options given as command line arguments.
+ */
+void openCache(Options *options);
+
+/**
+ * Looks the given file up in the cache, by the bytes of its .as file, the
+ * bytes of the running assembler and whether the .am file is written.
+ * If an entry is found, writes the output files it holds and prints its
+ * messages, exactly as compiling the file would have.
+ * Otherwise, prepares the given entry to record the file as it is compiled.
+ *
+ * Assumes that the given file name is not NULL and is null-terminated.
+ * Assumes that the given options and entry pointers are not NULL.
+ *
+ * @param fileName The name of the file (without the extension).
+ * @param options The options given as command line arguments.
+ * @param entry The entry of the file to prepare.
+ * @param report The time report of the file (NULL if it is not reported).
+ * @return Whether the outputs of the file have been restored from the cache.
+ */
+Boolean restoreCachedFile(char fileName[], Options *options,
+                          CacheEntry *entry, FileReport *report);
+
+/**
+ * Hashes the bytes of the file at the given path into the given hashes, and
+ * adds its size to the given size.
+ *
+ * Assumes that the given path is not NULL and is null-terminated.
+ * Assumes that the given pointers are not NULL.
+ *
+ * @param path The path of the file.
+ * @param hashes The hashes to update.
+ * @param size The size to add the file's size to.
+ * @return Whether the file could be read.
+ */
+Boolean hashFile(char path[], unsigned long hashes[], unsigned long *size);
+
+/**
+ * Hashes the bytes of the running assembler, once for the whole run, and
+ * records whether they could be read.
+ *
+ * Assumes that this function is called only once (through pthread_once).
+ */
+void hashTool();
+
+/**
+ * Mixes the given text, with its null character, into each of the given
+ * hashes.
+ *
+ * Assumes that the given text is not NULL and is null-terminated.
+ * Assumes that the given hashes pointer is not NULL.
+ *
+ * @param hashes The hashes to update (CACHE_HASH_COUNT of them).
+ * @param text The text to mix in.
+ */
+void hashText(unsigned long hashes[], char text[]);
+
+/**
+ * Mixes the given bytes into each of the given hashes.
+ *
+ * Assumes that the given pointers are not NULL.
+ *
+ * @param hashes The hashes to update (CACHE_HASH_COUNT of them).
+ * @param bytes The bytes to mix in.
+ * @param length The number of bytes.
+ */
+void hashBytes(unsigned long hashes[], char bytes[], size_t length);
+
+/**
+ * Reads the entry at the given path and checks that it is complete and
+ * belongs to a source file of the given size.
+ *
+ * Assumes that the given path is not NULL and is null-terminated.
+ * Assumes that the given contents pointer is not NULL.
+ *
+ * @param path The path of the entry.
+ * @param sourceSize The size of the .as file.
+ * @param contents The text buffer to read the entry into (from the file's
+ * arena).
+ * @return Whether the entry has been found and can be restored.
+ */
+Boolean loadCacheEntry(char path[], unsigned long sourceSize,
+                       TextBuffer *contents);
+
+/**
+ * Reads the record at the given position of an entry's contents.
+ *
+ * Assumes that the given pointers are not NULL, and that the contents end with
+ * a null character at the given end.
+ *
+ * @param position The first character of the record.
+ * @param end The end of the contents.
+ * @param record The record to fill.
+ * @return The first character of the next record, or NULL if the record is
+ * invalid.
+ */
+char *readCacheRecord(char *position, char *end, CacheRecord *record);
+
+/**
+ * Writes the output files of the given loaded entry and prints its messages.
+ *
+ * Assumes that the given entry has been checked by loadCacheEntry.
+ * Assumes that the given file name is not NULL and is null-terminated.
+ *
+ * @param contents The contents of the entry.
+ * @param fileName The name of the file (without the extension).
+ */
+void applyCacheEntry(TextBuffer *contents, char fileName[]);
+
+/**
+ * Prints the given message record the same way it was printed originally.
+ *
+ * Assumes that the text of the given record is null-terminated.
+ * Assumes that the given file name is not NULL and is null-terminated.
+ *
+ * @param record The message record.
+ * @param fileName The name of the file (without the extension).
+ */
+void replayMessage(CacheRecord *record, char fileName[]);
+
+/**
+ * Creates the key of the entry that each thread records.
+ *
+ * Assumes that this function is called only once (through pthread_once).
+ */
+void createEntryKey();
+
+/**
+ * Starts recording the outputs and the messages of the file of the given
+ * entry, on the calling thread, if the entry was prepared to be recorded.
+ *
+ * Assumes that the given entry pointer is not NULL.
+ *
+ * @param entry The entry of the file.
+ */
+void startCacheEntry(CacheEntry *entry);
+
+/**
+ * Adds the given contents of an output file to the entry that the calling
+ * thread records, if it records one.
+ *
+ * Assumes that the given extension is not NULL and is null-terminated.
+ * Assumes that the given output pointer is not NULL.
+ *
+ * @param extension The extension of the output file.
+ * @param output The contents of the output file.
+ */
+void recordOutput(char extension[], TextBuffer *output);
+
+/**
+ * Stops recording the file of the given entry, and stores the entry in the
+ * cache unless a file could not be opened or the entry could not be written.
+ * Then prints the messages of the file (or moves them to the queue of the
+ * calling thread).
+ *
+ * Assumes that the given entry pointer is not NULL.
+ *
+ * @param entry The entry of the file.
+ */
+void finishCacheEntry(CacheEntry *entry);
+
+/**
+ * Writes the messages in the given queue into the given entry file.
+ *
+ * Assumes that the given pointers are not NULL.
+ *
+ * @param file The entry file.
+ * @param messages The messages of the file.
+ * @return Whether the messages can be cached (none of them is a file error).
+ */
+Boolean recordMessages(FILE *file, MessageQueue *messages);
+
+/**
+ * Prints how many files were restored from the cache and how many were
+ * compiled, to stderr.
+ */
+void printCacheStatistics();
+
+#endif
@@ -0,0 +1,237 @@
+/*
+ * pipeline.c
+ *
+ * Contains functions to parse a large file on its own thread while its macros
+ * are still expanded.
+ * The expanding thread writes each expanded line into a ring of lines, and the
+ * parsing thread reads them from the ring as they arrive, so that the file
+ * takes about as long as the slower of the 2 stages.
+ * The messages of the parsing are kept aside until the expansion is done, so
+ * they are printed after the expansion's messages (and not at all if it
+ * fails), exactly as if the stages ran one after another.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "pipeline.h"
+
+#include <pthread.h>  /* pthread_create, pthread_join, mutexes and conditions. */
+#include <stdlib.h>   /* free. */
+#include <string.h>   /* memchr, strcpy. */
+#include <sys/stat.h> /* stat. */
+
+#include "arena.h"         /* Preparing the arena of the parsing thread. */
+#include "errorHandling.h" /* Keeping the messages of the parsing aside. */
+#include "fileReading.h"   /* Parsing the expanded lines. */
+#include "freeingLogic.h"  /* Registering the memory of the parsing thread. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "macroTable.h"    /* Checking the found labels against the macros. */
+#include "textBuffer.h"    /* Reading the expanded lines one by one. */
+#include "utils.h"         /* Allocating the slots and adding the extension. */
+#include "wordImage.h"     /* Starting both parts with no words. */
+
+Boolean isLargeSource(char fileName[]) {
+    struct stat status; /* The status of the .as file (its size). */
+
+    /* Check the size of the .as file, if it can be found. */
+    return stat(addExtension(fileName, "as"), &status) != SYSTEM_CALL_FAILED &&
+           status.st_size >= PIPELINE_MIN_SOURCE_SIZE;
+}
+
+Boolean startParsingStage(ParsingStage *stage, char fileName[]) {
+    /* Start with an empty ring, no words, no labels and no messages. */
+    initLineRing(&stage->ring);
+    stage->fileName = fileName;
+    initMacroTable(&stage->macros);
+    initWordImage(&stage->code);
+    initWordImage(&stage->data);
+    stage->entryLabels = NULL;
+    stage->externLabels = NULL;
+    stage->usedLabels = NULL;
+    stage->foundLabels = NULL;
+    stage->instructionCount = INITIAL_VALUE;
+    stage->dataCount = INITIAL_VALUE;
+    stage->isSuccessful = FALSE;
+    stage->messages.first = NULL;
+    stage->messages.last = NULL;
+    initArena(&stage->toFree.arena);
+
+    /* Try starting the parsing thread. */
+    if (pthread_create(&stage->thread, NULL, runParsingStage, stage) !=
+        SUCCESS) {
+        destroyLineRing(&stage->ring);
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+void *runParsingStage(void *parsingStage) {
+    ParsingStage *stage; /* The parsing stage of this thread. */
+
+    stage = parsingStage;
+
+    /* Keep a separate arena, as the lists belong to this thread. */
+    registerToFree(&stage->toFree);
+    /* Store the messages, as the expansion might still report errors. */
+    queueMessages(&stage->messages);
+
+    /* Parse the lines as they arrive. */
+    stage->isSuccessful = readLines(
+        stage->fileName, NULL, &stage->ring, &stage->macros, &stage->code,
+        &stage->data, &stage->entryLabels, &stage->externLabels,
+        &stage->usedLabels, &stage->foundLabels, &stage->instructionCount,
+        &stage->dataCount);
+
+    return NULL;
+}
+
+Boolean finishParsingStage(ParsingStage *stage, Boolean isExpanded,
+                           MacroTable *macros) {
+    /* No more lines will arrive (stop parsing if the expansion failed). */
+    publishLines(&stage->ring, TRUE, !isExpanded);
+    pthread_join(stage->thread, NULL);
+    destroyLineRing(&stage->ring);
+
+    /* Check if the parsing went the same way it would have after expanding. */
+    if (isExpanded && !hasMacroLabel(macros, stage->foundLabels)) {
+        /* Print the messages of the parsing, after those of the expansion. */
+        flushMessages(&stage->messages);
+        return TRUE;
+    }
+
+    /* The results are not used, so neither are the messages. */
+    discardMessages(&stage->messages);
+    return FALSE;
+}
+
+Boolean hasMacroLabel(MacroTable *macros, FoundLabel *foundLabels) {
+    /* Check each found label against the macros. */
+    while (foundLabels != NULL) {
+        if (getMacroContent(macros, foundLabels->name) != NULL) {
+            return TRUE;
+        }
+
+        foundLabels = foundLabels->next;
+    }
+
+    /* No found label is named after a macro. */
+    return FALSE;
+}
+
+void initLineRing(LineRing *ring) {
+    /* Allocate all the slots at once. */
+    ring->slots = allocate(sizeof(char) * RING_SLOT_COUNT * RING_SLOT_SIZE);
+
+    /* Start with no lines, and with every slot free. */
+    ring->written = INITIAL_VALUE;
+    ring->writeLimit = RING_SLOT_COUNT;
+    ring->read = INITIAL_VALUE;
+    ring->readLimit = INITIAL_VALUE;
+    ring->published = INITIAL_VALUE;
+    ring->freed = INITIAL_VALUE;
+    ring->isFinished = FALSE;
+    ring->isCancelled = FALSE;
+    pthread_mutex_init(&ring->lock, NULL);
+    pthread_cond_init(&ring->hasLines, NULL);
+    pthread_cond_init(&ring->hasRoom, NULL);
+}
+
+void destroyLineRing(LineRing *ring) {
+    /* Free the lock and the conditions, and then the slots. */
+    pthread_cond_destroy(&ring->hasRoom);
+    pthread_cond_destroy(&ring->hasLines);
+    pthread_mutex_destroy(&ring->lock);
+    free(ring->slots);
+}
+
+void pushExpandedLines(LineRing *ring, TextBuffer *expanded,
+                       Boolean isFinished) {
+    size_t remaining; /* The number of characters that have not been written. */
+
+    /* Write the lines of the text that have not been written yet. */
+    while (expanded->position < expanded->length) {
+        remaining = expanded->length - expanded->position;
+
+        /* Keep a partial line for later, unless it cannot grow any more. */
+        if (!isFinished && remaining < RING_SLOT_SIZE - NULL_BYTE &&
+            memchr(&expanded->text[expanded->position], '\n', remaining) ==
+                NULL) {
+            return;
+        }
+
+        /* Read the next line straight into a free slot. */
+        readTextLine(getFreeSlot(ring), RING_SLOT_SIZE, expanded);
+        ring->written++;
+
+        /* Hand the lines over in batches, to take the lock less often. */
+        if (ring->written - ring->published >= RING_BATCH_SIZE) {
+            publishLines(ring, FALSE, FALSE);
+        }
+    }
+}
+
+char *getFreeSlot(LineRing *ring) {
+    /* Check if every slot is still in use, as far as this thread knows. */
+    if (ring->written == ring->writeLimit) {
+        /* Hand over every written line first, so the parsing can go on. */
+        pthread_mutex_lock(&ring->lock);
+        ring->published = ring->written;
+        pthread_cond_signal(&ring->hasLines);
+
+        /* Wait until a slot is freed. */
+        while (ring->written - ring->freed == RING_SLOT_COUNT) {
+            pthread_cond_wait(&ring->hasRoom, &ring->lock);
+        }
+
+        /* The freed slots can all be written without the lock. */
+        ring->writeLimit = ring->freed + RING_SLOT_COUNT;
+        pthread_mutex_unlock(&ring->lock);
+    }
+
+    /* Return the slot after the last written line. */
+    return &ring->slots[(ring->written % RING_SLOT_COUNT) * RING_SLOT_SIZE];
+}
+
+void publishLines(LineRing *ring, Boolean isFinished, Boolean isCancelled) {
+    /* Hand over every written line, and wake the parsing thread up. */
+    pthread_mutex_lock(&ring->lock);
+    ring->published = ring->written;
+    ring->isFinished = isFinished;
+    ring->isCancelled = isCancelled;
+    pthread_cond_signal(&ring->hasLines);
+    pthread_mutex_unlock(&ring->lock);
+}
+
+Boolean takeExpandedLine(LineRing *ring, char line[]) {
+    /* Check if every handed-over line has been read, as far as this thread
+     * knows. */
+    if (ring->read == ring->readLimit) {
+        /* Free the slots of the lines that have been read. */
+        pthread_mutex_lock(&ring->lock);
+        ring->freed = ring->read;
+        pthread_cond_signal(&ring->hasRoom);
+
+        /* Wait until more lines are handed over or the ring is finished. */
+        while (ring->published == ring->read && !ring->isFinished) {
+            pthread_cond_wait(&ring->hasLines, &ring->lock);
+        }
+
+        /* The handed-over lines can all be read without the lock. */
+        ring->readLimit = ring->isCancelled ? ring->read : ring->published;
+        pthread_mutex_unlock(&ring->lock);
+
+        /* Check if there are no more lines. */
+        if (ring->read == ring->readLimit) {
+            return FALSE;
+        }
+    }
+
+    /* Copy the next line out of its slot. */
+    strcpy(line, &ring->slots[(ring->read % RING_SLOT_COUNT) * RING_SLOT_SIZE]);
+    ring->read++;
+    return TRUE;
+}
@@ -0,0 +1,160 @@
+/*
+ * pipeline.h
+ *
+ * Contains the function prototypes for the functions in pipeline.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Checks if the .as file with the given name is large enough to be parsed on
+ * its own thread while its macros are expanded.
+ * A file that could not be checked is not, so that opening it reports the
+ * error as usual.
+ *
+ * Assumes that the given file name is not NULL and is null-terminated.
+ *
+ * @param fileName The name of the source file (without the extension).
+ * @return Whether the file should be parsed while it is expanded.
+ */
+Boolean isLargeSource(char fileName[]);
+
+/**
+ * Starts parsing the lines of the given file on a new thread, as they arrive
+ * in the stage's ring.
+ * Nothing is left to finish if the thread could not be started.
+ *
+ * Assumes that the given stage pointer is not NULL.
+ * Assumes that the given file name is not NULL and is null-terminated.
+ *
+ * @param stage The parsing stage to start.
+ * @param fileName The name of the source file.
+ * @return Whether the thread has been started.
+ */
+Boolean startParsingStage(ParsingStage *stage, char fileName[]);
+
+/**
+ * The function that the parsing thread runs.
+ * Parses the lines from the stage's ring until it is finished, with an arena
+ * and a message queue of its own.
+ *
+ * Assumes that the given argument points to a started parsing stage.
+ *
+ * @param parsingStage The parsing stage (ParsingStage *).
+ * @return NULL.
+ */
+void *runParsingStage(void *parsingStage);
+
+/**
+ * Finishes the ring of the given stage and waits for the parsing thread.
+ * The results are kept only if the expansion was successful and no found label
+ * is named after a macro (which the parsing could not know about). In that
+ * case the messages of the parsing are printed, and otherwise they are thrown
+ * away and the file should be read again.
+ * The memory of the stage is kept until it is freed.
+ *
+ * Assumes that the given stage has been started.
+ * Assumes that the given macros pointer is not NULL.
+ *
+ * @param stage The parsing stage to finish.
+ * @param isExpanded Whether the expansion was successful.
+ * @param macros The macro table of the whole file.
+ * @return Whether the results of the parsing are kept.
+ */
+Boolean finishParsingStage(ParsingStage *stage, Boolean isExpanded,
+                           MacroTable *macros);
+
+/**
+ * Checks if any of the given found labels is named after a macro.
+ *
+ * Assumes that the given macros pointer is not NULL.
+ *
+ * @param macros The macro table.
+ * @param foundLabels The found labels list.
+ * @return Whether a found label's name is taken by a macro.
+ */
+Boolean hasMacroLabel(MacroTable *macros, FoundLabel *foundLabels);
+
+/**
+ * Prepares the given ring with no lines.
+ *
+ * Assumes that the given ring pointer is not NULL.
+ *
+ * @param ring The ring to prepare.
+ */
+void initLineRing(LineRing *ring);
+
+/**
+ * Frees the slots of the given ring and its lock and conditions.
+ *
+ * Assumes that the given ring has been prepared and is no longer used.
+ *
+ * @param ring The ring to free.
+ */
+void destroyLineRing(LineRing *ring);
+
+/**
+ * Writes the complete lines of the given expanded text that have not been
+ * written yet into the given ring, the same way they would be read back from
+ * the text. A partial line at the end is kept for later, unless the text is
+ * finished.
+ * Waits for free slots when the ring is full.
+ *
+ * Assumes that the given pointers are not NULL, and that only the calling
+ * thread writes into the ring and reads from the text.
+ *
+ * @param ring The ring to write to.
+ * @param expanded The expanded text (its position is the first line that has
+ * not been written yet).
+ * @param isFinished Whether nothing will be added to the text.
+ */
+void pushExpandedLines(LineRing *ring, TextBuffer *expanded,
+                       Boolean isFinished);
+
+/**
+ * Returns the slot that the next line is written into, waiting until the
+ * parsing thread frees one if the ring is full.
+ *
+ * Assumes that the given ring pointer is not NULL.
+ *
+ * @param ring The ring.
+ * @return The free slot (RING_SLOT_SIZE characters).
+ */
+char *getFreeSlot(LineRing *ring);
+
+/**
+ * Hands the written lines over to the parsing thread, and marks the ring as
+ * finished if asked to.
+ *
+ * Assumes that the given ring pointer is not NULL.
+ *
+ * @param ring The ring.
+ * @param isFinished Whether no more lines will be written.
+ * @param isCancelled Whether the lines that have not been read are not needed.
+ */
+void publishLines(LineRing *ring, Boolean isFinished, Boolean isCancelled);
+
+/**
+ * Copies the next line of the given ring into the given buffer, waiting until
+ * it is written.
+ *
+ * Assumes that the given ring pointer is not NULL, and that only the calling
+ * thread reads from it.
+ * Assumes that the given buffer has room for RING_SLOT_SIZE characters.
+ *
+ * @param ring The ring to read from.
+ * @param line The buffer to copy the line to.
+ * @return Whether a line has been copied (FALSE once the ring is finished and
+ * empty, or cancelled).
+ */
+Boolean takeExpandedLine(LineRing *ring, char line[]);
+
+#endif
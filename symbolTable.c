@@ -0,0 +1,160 @@
+/*
+ * symbolTable.c
+ *
+ * Contains functions to interface with a symbol table, which gathers the
+ * definition, the extern declaration and the uses of every label in a file.
+ * The table is built once, after the file has been read, so that linking the
+ * labels and generating the .ent and .ext files take linear time.
+ * Everything in the table comes from the current file's arena.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "symbolTable.h"
+
+#include <string.h> /* strcmp. */
+
+#include "globals.h" /* Constants and typedefs. */
+#include "utils.h"   /* Allocating memory from the file's arena and hashing names. */
+
+void initSymbolTable(SymbolTable *symbols) {
+    /* The table starts with no slots at all. */
+    symbols->slots = NULL;
+    symbols->capacity = EMPTY;
+    symbols->count = EMPTY;
+    symbols->latest = NULL;
+}
+
+void buildSymbolTable(SymbolTable *symbols, Label *entryLabels,
+                      Label *externLabels, UsedLabel *usedLabels,
+                      FoundLabel *foundLabels) {
+    Symbol *symbol; /* The symbol of the current label. */
+
+    /* Add the entry labels, so that every entry label has a symbol. */
+    for (; entryLabels != NULL; entryLabels = entryLabels->next) {
+        addSymbol(symbols, entryLabels->name);
+    }
+
+    /* Mark the extern labels. */
+    for (; externLabels != NULL; externLabels = externLabels->next) {
+        addSymbol(symbols, externLabels->name)->isExtern = TRUE;
+    }
+
+    /* Link every label to its definition. */
+    for (; foundLabels != NULL; foundLabels = foundLabels->next) {
+        addSymbol(symbols, foundLabels->name)->definition = foundLabels;
+    }
+
+    /* Chain the uses of every label, keeping the order of the list. */
+    for (; usedLabels != NULL; usedLabels = usedLabels->next) {
+        symbol = addSymbol(symbols, usedLabels->name);
+        usedLabels->nextUse = NULL;
+
+        /* Add the use after the last one. */
+        if (symbol->lastUse == NULL) {
+            symbol->firstUse = usedLabels;
+        } else {
+            symbol->lastUse->nextUse = usedLabels;
+        }
+        symbol->lastUse = usedLabels;
+    }
+}
+
+Symbol *addSymbol(SymbolTable *symbols, char labelName[]) {
+    Symbol **slot;      /* The slot of the label's name. */
+    unsigned long hash; /* The hash of the label's name. */
+    Symbol *newSymbol;  /* The new symbol. */
+
+    /* Compute the name's hash once. */
+    hash = hashString(labelName);
+
+    /* Check if the name already has a symbol. */
+    if (symbols->count != EMPTY) {
+        slot = findSymbolSlot(symbols, labelName, hash);
+        if (*slot != NULL) {
+            return *slot;
+        }
+    }
+
+    /* Make sure there will be enough empty slots after adding the symbol. */
+    if ((symbols->count + SINGLE_ENTRY) * TABLE_LOAD_DIVISOR >
+        symbols->capacity) {
+        growSymbolTable(symbols);
+    }
+
+    /* Allocate enough memory for the new symbol. */
+    newSymbol = allocateForFile(sizeof(Symbol));
+
+    /* Set the new symbol's properties (nothing is known about it yet). */
+    newSymbol->name = labelName;
+    newSymbol->hash = hash;
+    newSymbol->definition = NULL;
+    newSymbol->isExtern = FALSE;
+    newSymbol->isEntry = FALSE;
+    newSymbol->firstUse = NULL;
+    newSymbol->lastUse = NULL;
+
+    /* Make the new symbol the latest one. */
+    newSymbol->next = symbols->latest;
+    symbols->latest = newSymbol;
+
+    /* Put the new symbol in its slot. */
+    *findSymbolSlot(symbols, labelName, hash) = newSymbol;
+    symbols->count++;
+
+    return newSymbol;
+}
+
+Symbol *getSymbol(SymbolTable *symbols, char labelName[]) {
+    /* Check if the table is empty. */
+    if (symbols->count == EMPTY) {
+        return NULL;
+    }
+
+    /* Return the symbol in the name's slot, or NULL if the slot is empty. */
+    return *findSymbolSlot(symbols, labelName, hashString(labelName));
+}
+
+Symbol **findSymbolSlot(SymbolTable *symbols, char labelName[],
+                        unsigned long hash) {
+    unsigned long index; /* The index of the current slot. */
+
+    /* Start from the slot that the hash points to. */
+    index = hash & (symbols->capacity - LAST_INDEX_DIFF);
+
+    /* Move on to the next slot until an empty or matching one is found. */
+    while (symbols->slots[index] != NULL &&
+           (symbols->slots[index]->hash != hash ||
+            strcmp(symbols->slots[index]->name, labelName) != EQUAL_STRINGS)) {
+        /* Wrap around at the end of the table. */
+        index = (index + SINGLE_ENTRY) & (symbols->capacity - LAST_INDEX_DIFF);
+    }
+
+    /* Return the slot where the loop stopped. */
+    return &symbols->slots[index];
+}
+
+void growSymbolTable(SymbolTable *symbols) {
+    Symbol *symbol;      /* The current symbol to move. */
+    unsigned long index; /* The index of the current slot. */
+
+    /* Compute the new number of slots. */
+    symbols->capacity = symbols->capacity == EMPTY
+                            ? INITIAL_TABLE_CAPACITY
+                            : symbols->capacity * TABLE_GROWTH_FACTOR;
+
+    /* Allocate the new slots and empty them (the old ones are abandoned, as the
+     * symbols are all in the list anyway). */
+    symbols->slots = allocateForFile(sizeof(Symbol *) * symbols->capacity);
+    for (index = INITIAL_VALUE; index < symbols->capacity; index++) {
+        symbols->slots[index] = NULL;
+    }
+
+    /* Move every symbol to its slot in the grown table. */
+    for (symbol = symbols->latest; symbol != NULL; symbol = symbol->next) {
+        *findSymbolSlot(symbols, symbol->name, symbol->hash) = symbol;
+    }
+}
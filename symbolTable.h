@@ -0,0 +1,108 @@
+/*
+ * symbolTable.h
+ *
+ * Contains the function prototypes for the functions in symbolTable.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Initializes the given symbol table to be empty.
+ * Does not allocate any memory until the first symbol is added.
+ *
+ * Assumes that the given symbol table pointer is not NULL.
+ *
+ * @param symbols The symbol table to initialize.
+ */
+void initSymbolTable(SymbolTable *symbols);
+
+/**
+ * Builds the given symbol table from the label lists of a file.
+ * Every label in the lists gets a symbol, which points to the label's
+ * definition, marks whether it is extern and chains its uses in the same order
+ * as in the list of used labels.
+ * The names in the table are shared with the lists.
+ *
+ * Assumes that the given symbol table pointer is not NULL and that the table is
+ * empty.
+ * Assumes that every label is defined at most once.
+ *
+ * @param symbols The symbol table to build.
+ * @param entryLabels The list of entry labels.
+ * @param externLabels The list of extern labels.
+ * @param usedLabels The list of used labels.
+ * @param foundLabels The list of found labels.
+ */
+void buildSymbolTable(SymbolTable *symbols, Label *entryLabels,
+                      Label *externLabels, UsedLabel *usedLabels,
+                      FoundLabel *foundLabels);
+
+/**
+ * Returns the symbol of the given label name in the given symbol table.
+ * Adds a new symbol, which knows nothing about the label yet, if the name is
+ * not in the table.
+ * IMPORTANT: The new symbol comes from the current file's arena, so it must not
+ * be freed.
+ *
+ * Assumes that the given symbol table pointer is not NULL.
+ * Assumes that the given label name is not NULL and is null-terminated, and
+ * that it lives as long as the table.
+ *
+ * @param symbols The symbol table.
+ * @param labelName The name of the label.
+ * @return The symbol of the label.
+ */
+Symbol *addSymbol(SymbolTable *symbols, char labelName[]);
+
+/**
+ * Searches for the given label name in the given symbol table.
+ * If found, returns its symbol.
+ * If not found, returns NULL.
+ *
+ * Assumes that the given symbol table pointer is not NULL.
+ * Assumes that the given label name is not NULL and is null-terminated.
+ *
+ * @param symbols The symbol table.
+ * @param labelName The label name to search for.
+ * @return The label's symbol, or NULL if not found.
+ */
+Symbol *getSymbol(SymbolTable *symbols, char labelName[]);
+
+/**
+ * Returns the slot of the given label name in the given symbol table.
+ * If the label is in the table, the slot points to its symbol.
+ * Otherwise, the slot is the empty slot where the symbol should be added.
+ *
+ * Assumes that the given symbol table pointer is not NULL and that its capacity
+ * is not zero.
+ * Assumes that the given label name is not NULL and is null-terminated.
+ * Assumes that the given hash is the hash of the given label name.
+ *
+ * @param symbols The symbol table.
+ * @param labelName The label name to search for.
+ * @param hash The hash of the label name.
+ * @return The slot of the label name in the table.
+ */
+Symbol **findSymbolSlot(SymbolTable *symbols, char labelName[],
+                        unsigned long hash);
+
+/**
+ * Grows the given symbol table, so that there are enough empty slots for more
+ * symbols.
+ * Moves every symbol to its slot in the grown table.
+ *
+ * Assumes that the given symbol table pointer is not NULL.
+ *
+ * @param symbols The symbol table to grow.
+ */
+void growSymbolTable(SymbolTable *symbols);
+
+#endif
@@ -0,0 +1,217 @@
+/*
+ * textBuffer.c
+ *
+ * Contains functions to interface with a text buffer, which holds the
+ * macro-expanded lines in memory.
+ * The lines are read back one by one, the same way they would be read from the
+ * .am file, so that the .am file does not have to be read from the disk.
+ * The same buffer also holds the contents of the output files, which are
+ * formatted in memory and then written at once.
+ * The text comes from the current file's arena.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "textBuffer.h"
+
+#include <stdio.h>  /* FILE, fwrite. */
+#include <string.h> /* strlen, memcpy, memchr. */
+
+#include "globals.h" /* Constants and typedefs. */
+#include "utils.h"   /* Allocating memory from the file's arena. */
+
+void initTextBuffer(TextBuffer *buffer) {
+    /* The buffer starts with no text at all. */
+    buffer->text = NULL;
+    buffer->length = EMPTY;
+    buffer->capacity = EMPTY;
+    buffer->position = INITIAL_VALUE;
+}
+
+void appendText(TextBuffer *buffer, char text[]) {
+    /* Append the given text without its null character. */
+    appendChars(buffer, text, strlen(text));
+}
+
+void appendChars(TextBuffer *buffer, char text[], size_t length) {
+    size_t newCapacity; /* The capacity needed for the combined text. */
+    char *newText;      /* The new, larger buffer. */
+
+    /* Check if the combined text does not fit in the current buffer. */
+    if (buffer->length + length > buffer->capacity) {
+        /* Double the capacity until the combined text fits. */
+        newCapacity = buffer->capacity == EMPTY ? INITIAL_BUFFER_CAPACITY
+                                                : buffer->capacity;
+        while (buffer->length + length > newCapacity) {
+            newCapacity *= BUFFER_GROWTH_FACTOR;
+        }
+
+        /* Allocate the larger buffer and move the old text into it. */
+        newText = allocateForFile(sizeof(char) * newCapacity);
+        if (buffer->text != NULL) {
+            memcpy(newText, buffer->text, buffer->length);
+        }
+
+        /* Replace the old buffer (taken back with the rest of the arena). */
+        buffer->text = newText;
+        buffer->capacity = newCapacity;
+    }
+
+    /* Append the given text (no null character is needed). */
+    memcpy(&buffer->text[buffer->length], text, length);
+    buffer->length += length;
+}
+
+void appendPadded(TextBuffer *buffer, char text[], Length width) {
+    size_t length; /* The length of the given text. */
+
+    /* Append the given text. */
+    length = strlen(text);
+    appendChars(buffer, text, length);
+
+    /* Pad the text with spaces to the right until it is wide enough. */
+    while (length < width) {
+        appendChars(buffer, " ", SINGLE_ENTRY);
+        length++;
+    }
+}
+
+void appendDecimal(TextBuffer *buffer, unsigned long number, Length width) {
+    /* The decimal digits of every number from 0 to 99, 2 digits each. */
+    static char DIGIT_PAIRS[] = "00010203040506070809"
+                                "10111213141516171819"
+                                "20212223242526272829"
+                                "30313233343536373839"
+                                "40414243444546474849"
+                                "50515253545556575859"
+                                "60616263646566676869"
+                                "70717273747576777879"
+                                "80818283848586878889"
+                                "90919293949596979899";
+
+    char digits[MAX_DIGIT_COUNT]; /* The digits, written from the end. */
+    Length index;                 /* The index of the first digit so far. */
+    unsigned long pair;           /* The index of the current pair of digits. */
+
+    index = MAX_DIGIT_COUNT;
+
+    /* Write the last 2 digits at a time, using the table of pairs. */
+    while (number >= DECIMAL_BASE * DECIMAL_BASE) {
+        pair = (number % (DECIMAL_BASE * DECIMAL_BASE)) * DIGITS_PER_PAIR;
+        number /= DECIMAL_BASE * DECIMAL_BASE;
+
+        index -= DIGITS_PER_PAIR;
+        digits[index] = DIGIT_PAIRS[pair];
+        digits[index + SECOND_INDEX] = DIGIT_PAIRS[pair + SECOND_INDEX];
+    }
+
+    /* Write the remaining 1 or 2 digits. */
+    pair = number * DIGITS_PER_PAIR;
+    if (number >= DECIMAL_BASE) {
+        index -= DIGITS_PER_PAIR;
+        digits[index] = DIGIT_PAIRS[pair];
+        digits[index + SECOND_INDEX] = DIGIT_PAIRS[pair + SECOND_INDEX];
+    } else {
+        index--;
+        digits[index] = DIGIT_PAIRS[pair + SECOND_INDEX];
+    }
+
+    /* Append the digits, padded with zeros to the left. */
+    appendDigits(buffer, digits, index, width);
+}
+
+void appendOctal(TextBuffer *buffer, unsigned long number, Length width) {
+    /* The octal digits, by their values. */
+    static char OCTAL_DIGITS[] = "01234567";
+
+    char digits[MAX_DIGIT_COUNT]; /* The digits, written from the end. */
+    Length index;                 /* The index of the first digit so far. */
+
+    index = MAX_DIGIT_COUNT;
+
+    /* Write the last digit (3 bits) at a time, until no digits are left. */
+    do {
+        index--;
+        digits[index] = OCTAL_DIGITS[number & OCTAL_DIGIT_MASK];
+        number >>= BITS_PER_OCTAL_DIGIT;
+    } while (number != EMPTY);
+
+    /* Append the digits, padded with zeros to the left. */
+    appendDigits(buffer, digits, index, width);
+}
+
+void appendDigits(TextBuffer *buffer, char digits[], Length first,
+                  Length width) {
+    /* Pad the digits with zeros to the left until they are wide enough. */
+    while (first > EMPTY && MAX_DIGIT_COUNT - first < width) {
+        first--;
+        digits[first] = '0';
+    }
+
+    /* Append the digits at once. */
+    appendChars(buffer, &digits[first], MAX_DIGIT_COUNT - first);
+}
+
+char *readTextLine(char line[], size_t size, TextBuffer *buffer) {
+    size_t length;  /* The number of characters to copy. */
+    char *start;    /* The first character of the line. */
+    char *newline;  /* The newline character at the end of the line. */
+
+    /* Check if there are no more characters to read. */
+    if (buffer->position == buffer->length) {
+        return NULL;
+    }
+
+    /* At most, copy until the line is full or the text ends. */
+    start = &buffer->text[buffer->position];
+    length = buffer->length - buffer->position;
+    if (length > size - NULL_BYTE) {
+        length = size - NULL_BYTE;
+    }
+
+    /* Stop right after the newline character, if there is one in reach. */
+    newline = memchr(start, '\n', length);
+    if (newline != NULL) {
+        length = (size_t)(newline - start) + SINGLE_ENTRY;
+    }
+
+    /* Copy the line at once and end it with a null character. */
+    memcpy(line, start, length);
+    line[length] = '\0';
+    buffer->position += length;
+    return line;
+}
+
+size_t countTextLines(TextBuffer *buffer) {
+    size_t count; /* The number of lines so far. */
+    size_t index; /* The index of the current character. */
+
+    /* Count the newline characters. */
+    count = EMPTY;
+    for (index = INITIAL_VALUE; index < buffer->length; index++) {
+        if (buffer->text[index] == '\n') {
+            count++;
+        }
+    }
+
+    /* Count the last line as well, if it does not end with a newline. */
+    if (buffer->length != EMPTY &&
+        buffer->text[buffer->length - LAST_INDEX_DIFF] != '\n') {
+        count++;
+    }
+
+    return count;
+}
+
+void writeTextBuffer(TextBuffer *buffer, FILE *file) {
+    /* Check if there is nothing to write. */
+    if (buffer->length == EMPTY) {
+        return;
+    }
+
+    /* Write the whole text at once. */
+    fwrite(buffer->text, sizeof(char), buffer->length, file);
+}
@@ -0,0 +1,157 @@
+/*
+ * textBuffer.h
+ *
+ * Contains the function prototypes for the functions in textBuffer.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef TEXT_BUFFER_H
+#define TEXT_BUFFER_H
+
+#include <stdio.h> /* FILE. */
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Initializes the given text buffer to be empty.
+ * Does not allocate any memory until the first text is added.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ *
+ * @param buffer The text buffer to initialize.
+ */
+void initTextBuffer(TextBuffer *buffer);
+
+/**
+ * Appends the given text to the end of the given text buffer.
+ * The buffer doubles in size whenever it is full, so that appending many lines
+ * takes linear time.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given text is not NULL and is null-terminated.
+ *
+ * @param buffer The text buffer to append to.
+ * @param text The text to append.
+ */
+void appendText(TextBuffer *buffer, char text[]);
+
+/**
+ * Appends the given number of characters of the given text to the end of the
+ * given text buffer.
+ * The buffer doubles in size whenever it is full, so that appending many times
+ * takes linear time.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given text has at least the given number of characters.
+ *
+ * @param buffer The text buffer to append to.
+ * @param text The text to append.
+ * @param length The number of characters to append.
+ */
+void appendChars(TextBuffer *buffer, char text[], size_t length);
+
+/**
+ * Appends the given text to the end of the given text buffer, padded with
+ * spaces to the right to be at least the given width (like "%-*s").
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given text is not NULL and is null-terminated.
+ *
+ * @param buffer The text buffer to append to.
+ * @param text The text to append.
+ * @param width The minimum number of characters to append.
+ */
+void appendPadded(TextBuffer *buffer, char text[], Length width);
+
+/**
+ * Appends the decimal digits of the given number to the end of the given text
+ * buffer, padded with zeros to the left to be at least the given width (like
+ * "%0*lu").
+ * Takes the digits 2 at a time from a table, instead of formatting them.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given width is less than 24.
+ *
+ * @param buffer The text buffer to append to.
+ * @param number The number to append.
+ * @param width The minimum number of digits to append (0 for no padding).
+ */
+void appendDecimal(TextBuffer *buffer, unsigned long number, Length width);
+
+/**
+ * Appends the octal digits of the given number to the end of the given text
+ * buffer, padded with zeros to the left to be at least the given width (like
+ * "%0*lo").
+ * Takes every digit from a table, by the 3 bits that it stands for.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given width is less than 24.
+ *
+ * @param buffer The text buffer to append to.
+ * @param number The number to append.
+ * @param width The minimum number of digits to append (0 for no padding).
+ */
+void appendOctal(TextBuffer *buffer, unsigned long number, Length width);
+
+/**
+ * Appends the digits at the end of the given digits array, starting from the
+ * given index, to the end of the given text buffer.
+ * Pads them with zeros to the left to be at least the given width.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given digits array has room for 24 digits, and that the
+ * digits fill it from the given index to its end.
+ *
+ * @param buffer The text buffer to append to.
+ * @param digits The digits array.
+ * @param first The index of the first digit in the array.
+ * @param width The minimum number of digits to append.
+ */
+void appendDigits(TextBuffer *buffer, char digits[], Length first,
+                  Length width);
+
+/**
+ * Reads the next line of the given text buffer into the given line, the same
+ * way fgets reads the next line of a file.
+ * Reads at most size - 1 characters, stops after a newline character and ends
+ * the line with a null character.
+ * Returns NULL if there are no more characters to read.
+ *
+ * Assumes that the given line has room for at least size characters.
+ * Assumes that the given size is at least 2.
+ * Assumes that the given text buffer pointer is not NULL.
+ *
+ * @param line The line to read into.
+ * @param size The size of the given line.
+ * @param buffer The text buffer to read from.
+ * @return The given line, or NULL if there are no more characters to read.
+ */
+char *readTextLine(char line[], size_t size, TextBuffer *buffer);
+
+/**
+ * Counts and returns the number of lines in the given text buffer, including a
+ * last line that does not end with a newline.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ *
+ * @param buffer The text buffer.
+ * @return The number of lines in the buffer.
+ */
+size_t countTextLines(TextBuffer *buffer);
+
+/**
+ * Writes all the text in the given text buffer to the given file at once.
+ *
+ * Assumes that the given text buffer pointer is not NULL.
+ * Assumes that the given file pointer is not NULL and is open for writing.
+ *
+ * @param buffer The text buffer to write.
+ * @param file The file to write to.
+ */
+void writeTextBuffer(TextBuffer *buffer, FILE *file);
+
+#endif
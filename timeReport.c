@@ -0,0 +1,166 @@
+/*
+ * timeReport.c
+ *
+ * Contains functions to measure how long each phase of compiling a file takes,
+ * for the --time-report option, and to print the measurements to stderr.
+ * A monotonic clock is used, so that changes to the system's time do not
+ * affect the measurements.
+ * When the option is not given, the reports are NULL and the clock is never
+ * read.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "timeReport.h"
+
+#include <stdio.h>        /* fprintf, stderr. */
+#include <sys/resource.h> /* getrusage, RUSAGE_SELF. */
+#include <time.h>         /* clock_gettime, CLOCK_MONOTONIC. */
+
+#include "globals.h"    /* Constants and typedefs. */
+#include "textBuffer.h" /* Counting the macro-expanded lines. */
+
+double getMonotonicTime() {
+    struct timespec now; /* The current time of the clock. */
+
+    /* Read the clock, which never goes back. */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    /* Combine the seconds and the nanoseconds. */
+    return (double)now.tv_sec + (double)now.tv_nsec / NANOSECONDS_PER_SECOND;
+}
+
+void initFileReport(FileReport *report, char fileName[]) {
+    Index phase; /* The index of the current phase. */
+
+    /* Check if the time is not reported. */
+    if (report == NULL) {
+        return;
+    }
+
+    /* Start with no time measured and nothing counted. */
+    report->fileName = fileName;
+    for (phase = INITIAL_VALUE; phase < PHASE_COUNT; phase++) {
+        report->phaseTimes[phase] = EMPTY;
+    }
+    report->lineCount = EMPTY;
+    report->wordCount = EMPTY;
+    report->labelCount = EMPTY;
+    report->macroCount = EMPTY;
+}
+
+double startPhase(FileReport *report) {
+    /* Only read the clock if the time is reported. */
+    return report == NULL ? EMPTY : getMonotonicTime();
+}
+
+double endPhase(FileReport *report, Phase phase, double startTime) {
+    double endTime; /* The time at which the phase ended. */
+
+    /* Check if the time is not reported. */
+    if (report == NULL) {
+        return EMPTY;
+    }
+
+    /* Add the time the phase took. */
+    endTime = getMonotonicTime();
+    report->phaseTimes[phase] += endTime - startTime;
+
+    return endTime;
+}
+
+void recordCounts(FileReport *report, TextBuffer *expanded,
+                  WordCount wordCount, MacroTable *macros,
+                  SymbolTable *symbols) {
+    /* Check if the time is not reported. */
+    if (report == NULL) {
+        return;
+    }
+
+    /* Count everything that the phases went through. */
+    report->lineCount = countTextLines(expanded);
+    report->wordCount = wordCount;
+    report->labelCount = symbols->count;
+    report->macroCount = macros->count;
+}
+
+void addFileReport(FileReport *total, FileReport *report) {
+    Index phase; /* The index of the current phase. */
+
+    /* Add the time of each phase. */
+    for (phase = INITIAL_VALUE; phase < PHASE_COUNT; phase++) {
+        total->phaseTimes[phase] += report->phaseTimes[phase];
+    }
+
+    /* Add the counts. */
+    total->lineCount += report->lineCount;
+    total->wordCount += report->wordCount;
+    total->labelCount += report->labelCount;
+    total->macroCount += report->macroCount;
+}
+
+void printTimeReport(FileReport reports[], int fileCount, double wallTime) {
+    FileReport total; /* The totals of all the files. */
+    int index;        /* The index of the current file. */
+
+    /* Print the header, with the times in milliseconds. */
+    fprintf(stderr, "\n--- Time Report (ms) ---\n");
+    fprintf(stderr, "%-*s %*s%*s%*s%*s%*s%*s%*s%*s%*s%*s%*s\n",
+            NAME_COLUMN_WIDTH, "File", COUNT_COLUMN_WIDTH, "Lines",
+            COUNT_COLUMN_WIDTH, "Words", COUNT_COLUMN_WIDTH, "Labels",
+            COUNT_COLUMN_WIDTH, "Macros", TIME_COLUMN_WIDTH, "Expand",
+            TIME_COLUMN_WIDTH, "Read", TIME_COLUMN_WIDTH, "Link",
+            TIME_COLUMN_WIDTH, "Ent", TIME_COLUMN_WIDTH, "Ext",
+            TIME_COLUMN_WIDTH, "Ob", TIME_COLUMN_WIDTH, "Total");
+
+    /* Print a row for each file, and add it to the totals. */
+    initFileReport(&total, "Total");
+    for (index = INITIAL_VALUE; index < fileCount; index++) {
+        printReportRow(reports[index].fileName, &reports[index]);
+        addFileReport(&total, &reports[index]);
+    }
+
+    /* Print the totals of all the files and the time of the whole run. */
+    printReportRow(total.fileName, &total);
+    fprintf(stderr, "Wall time: %.*f\n", TIME_PRECISION,
+            wallTime * MILLISECONDS_PER_SECOND);
+    fprintf(stderr, "Peak memory (KB): %ld\n", getPeakMemory());
+}
+
+long getPeakMemory() {
+    struct rusage usage; /* The resources used by the whole process. */
+
+    /* Check if the usage could not be read. */
+    if (getrusage(RUSAGE_SELF, &usage) != SUCCESS) {
+        return EMPTY;
+    }
+
+    /* The largest resident set size so far (shared by every thread). */
+    return usage.ru_maxrss;
+}
+
+void printReportRow(char name[], FileReport *report) {
+    double totalTime; /* The time all the phases took together. */
+    Index phase;      /* The index of the current phase. */
+
+    /* Print the name and the counts. */
+    fprintf(stderr, "%-*s %*lu%*lu%*lu%*lu", NAME_COLUMN_WIDTH, name,
+            COUNT_COLUMN_WIDTH, report->lineCount, COUNT_COLUMN_WIDTH,
+            report->wordCount, COUNT_COLUMN_WIDTH, report->labelCount,
+            COUNT_COLUMN_WIDTH, report->macroCount);
+
+    /* Print the time of each phase, in milliseconds. */
+    totalTime = EMPTY;
+    for (phase = INITIAL_VALUE; phase < PHASE_COUNT; phase++) {
+        fprintf(stderr, "%*.*f", TIME_COLUMN_WIDTH, TIME_PRECISION,
+                report->phaseTimes[phase] * MILLISECONDS_PER_SECOND);
+        totalTime += report->phaseTimes[phase];
+    }
+
+    /* Print the time of all the phases together. */
+    fprintf(stderr, "%*.*f\n", TIME_COLUMN_WIDTH, TIME_PRECISION,
+            totalTime * MILLISECONDS_PER_SECOND);
+}
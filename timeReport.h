@@ -0,0 +1,125 @@
+/*
+ * timeReport.h
+ *
+ * Contains the function prototypes for the functions in timeReport.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef TIME_REPORT_H
+#define TIME_REPORT_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Returns the current time of a monotonic clock, in seconds.
+ * Only the difference between 2 times is meaningful.
+ *
+ * @return The current time, in seconds.
+ */
+double getMonotonicTime();
+
+/**
+ * Initializes the given report of the given file, with no time measured and
+ * nothing counted.
+ * Does nothing if the given report is NULL.
+ *
+ * Assumes that the given file name is not NULL and is null-terminated, and that
+ * it lives as long as the report.
+ *
+ * @param report The report to initialize (NULL if not reporting).
+ * @param fileName The name of the file.
+ */
+void initFileReport(FileReport *report, char fileName[]);
+
+/**
+ * Returns the time at which a phase starts.
+ * Does not read the clock if the given report is NULL, and returns 0 instead.
+ *
+ * @param report The report of the file (NULL if not reporting).
+ * @return The time at which the phase starts, in seconds.
+ */
+double startPhase(FileReport *report);
+
+/**
+ * Adds the time since the given start time to the given phase in the given
+ * report.
+ * Returns the time at which the phase ended, so that the next phase can start
+ * from it.
+ * Does not read the clock if the given report is NULL, and returns 0 instead.
+ *
+ * Assumes that the given start time was returned by startPhase or endPhase
+ * with the same report.
+ *
+ * @param report The report of the file (NULL if not reporting).
+ * @param phase The phase that ended.
+ * @param startTime The time at which the phase started, in seconds.
+ * @return The time at which the phase ended, in seconds.
+ */
+double endPhase(FileReport *report, Phase phase, double startTime);
+
+/**
+ * Records the number of lines, words, labels and macros of a file in the given
+ * report.
+ * Does nothing if the given report is NULL.
+ *
+ * Assumes that the given pointers are not NULL, and that the lists they point
+ * to have not been taken back yet.
+ *
+ * @param report The report of the file (NULL if not reporting).
+ * @param expanded The macro-expanded text.
+ * @param wordCount The number of words in the code and data parts.
+ * @param macros The macro table.
+ * @param symbols The symbol table.
+ */
+void recordCounts(FileReport *report, TextBuffer *expanded,
+                  WordCount wordCount, MacroTable *macros,
+                  SymbolTable *symbols);
+
+/**
+ * Adds the times and the counts of the given report to the given total.
+ *
+ * Assumes that the given pointers are not NULL.
+ *
+ * @param total The report to add to.
+ * @param report The report to add.
+ */
+void addFileReport(FileReport *total, FileReport *report);
+
+/**
+ * Prints the given reports to stderr as a table, with a row for each file, a
+ * row with the totals of all the files, the wall time of the whole run and the
+ * peak memory of the process.
+ * The times are printed in milliseconds.
+ *
+ * Assumes that the given reports array contains fileCount initialized reports.
+ *
+ * @param reports The reports of the files, in order.
+ * @param fileCount The number of files.
+ * @param wallTime The time it took to compile all the files, in seconds.
+ */
+void printTimeReport(FileReport reports[], int fileCount, double wallTime);
+
+/**
+ * Returns the largest amount of memory that the process has had in RAM so far,
+ * in kilobytes, or 0 if it cannot be read.
+ *
+ * @return The peak resident set size of the process, in kilobytes.
+ */
+long getPeakMemory();
+
+/**
+ * Prints a single row of the time report to stderr, with the given name.
+ *
+ * Assumes that the given name is not NULL and is null-terminated.
+ * Assumes that the given report pointer is not NULL.
+ *
+ * @param name The name of the row.
+ * @param report The report to print.
+ */
+void printReportRow(char name[], FileReport *report);
+
+#endif
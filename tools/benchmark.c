@@ -0,0 +1,626 @@
+/*
+ * benchmark.c
+ *
+ * A tool that measures the assembler from start to end, for the bench target.
+ * It generates corpora of different shapes with the workload generator (many
+ * tiny files, a few files that fill the whole memory, files that call many
+ * macros and a single large file, with 1 job and with 4), assembles each
+ * corpus several times with --time-report and writes the throughput, the
+ * time of each phase and the peak memory as JSON.
+ * The medians of the runs are written, so that a single slow run does not
+ * affect the results, along with the spread of the wall times.
+ * The results can be compared to a stored baseline, to flag regressions.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "benchmark.h"
+
+#include <ctype.h>     /* isdigit. */
+#include <errno.h>     /* errno, EEXIST. */
+#include <fcntl.h>     /* open, O_WRONLY, O_CREAT, O_TRUNC. */
+#include <stdio.h>     /* FILE, fopen, fclose, fprintf, fgets, sprintf. */
+#include <stdlib.h>    /* malloc, free, qsort, strtod, strtoul. */
+#include <string.h>    /* strcmp, strncmp, strstr, strchr, strlen. */
+#include <sys/stat.h>  /* mkdir. */
+#include <sys/types.h> /* pid_t. */
+#include <sys/wait.h>  /* waitpid, WIFEXITED, WEXITSTATUS. */
+#include <time.h>      /* clock_gettime, CLOCK_MONOTONIC. */
+#include <unistd.h>    /* fork, execv, dup2, close, _exit. */
+
+#include "../globals.h" /* Constants and typedefs. */
+
+/* The shapes of the generated corpora. */
+static Scenario SCENARIOS[SCENARIO_COUNT] = {
+    /* Many tiny files, where opening and writing the files dominate. */
+    {"tiny", 200, "20", "0", "3", "0", "0", NULL},
+    /* A few files that fill the whole memory. */
+    {"large", 4, "5000", "0", "3", "0", "0", NULL},
+    /* Files that call many long macros. */
+    {"macros", 20, "1500", "40", "8", "40", "0", NULL},
+    /* A single commented file that fills the whole memory, which is large
+     * enough to be parsed while it is expanded (with a single job)... */
+    {"single-j1", 1, "5000", "0", "3", "0", "100", "-j1"},
+    /* ...and to be parsed in ranges of lines at once (with several jobs). */
+    {"single-j4", 1, "5000", "0", "3", "0", "100", "-j4"}};
+
+/* The names of the phases in the results, in the order of Phase. */
+static char *PHASE_NAMES[PHASE_COUNT] = {"expand", "read", "link",
+                                         "ent",    "ext",  "ob"};
+
+int main(int argc, char *argv[]) {
+    BenchmarkOptions options;               /* The command line options. */
+    ScenarioResult results[SCENARIO_COUNT]; /* The results of the scenarios. */
+    char *fileNames[MAX_SCENARIO_FILES];    /* The names of the files. */
+    char *names;       /* The buffer that holds every file's name. */
+    FILE *output;      /* The file to write the results to. */
+    int scenario;      /* The index of the current scenario. */
+    int index;         /* The index of the current file. */
+    int regressions;   /* The number of regressions. */
+    Boolean succeeded; /* Whether every scenario has been measured. */
+
+    /* Read the options. */
+    if (!readBenchmarkOptions(argv + ARGS_DIFF, argc - ARGS_DIFF, &options)) {
+        printBenchmarkUsage();
+        return ERROR;
+    }
+
+    /* Create the directory of the corpora (it may already exist). */
+    if (mkdir(options.corpusDirectory, CORPUS_PERMISSIONS) != SUCCESS &&
+        errno != EEXIST) {
+        fprintf(stderr, "Failed to create %s.\n", options.corpusDirectory);
+        return ERROR;
+    }
+
+    /* Allocate the names of the files of the largest scenario. */
+    names = malloc(sizeof(char) * PATH_BUFFER_SIZE * MAX_SCENARIO_FILES);
+    if (names == NULL) {
+        fprintf(stderr, "Failed to allocate enough memory.\n");
+        return ERROR;
+    }
+    for (index = INITIAL_VALUE; index < MAX_SCENARIO_FILES; index++) {
+        fileNames[index] = &names[index * PATH_BUFFER_SIZE];
+    }
+
+    /* Generate and measure each scenario. */
+    succeeded = TRUE;
+    for (scenario = INITIAL_VALUE; scenario < SCENARIO_COUNT && succeeded;
+         scenario++) {
+        fprintf(stderr, "Measuring %s...\n", SCENARIOS[scenario].name);
+        succeeded = generateCorpus(&options, &SCENARIOS[scenario],
+                                   fileNames) &&
+                    runScenario(&options, &SCENARIOS[scenario], fileNames,
+                                &results[scenario]);
+    }
+    free(names);
+
+    /* Check if a scenario could not be measured. */
+    if (!succeeded) {
+        return ERROR;
+    }
+
+    /* Write the results. */
+    output = options.outputName == NULL ? stdout
+                                        : fopen(options.outputName, "w");
+    if (output == NULL) {
+        fprintf(stderr, "Failed to open %s.\n", options.outputName);
+        return ERROR;
+    }
+    writeResults(output, &options, results);
+    if (output != stdout) {
+        fclose(output);
+    }
+
+    /* Compare the results to the baseline, if one is given. */
+    if (options.baselineName == NULL) {
+        return SUCCESS;
+    }
+    regressions = compareResults(&options, results);
+    return regressions == EMPTY ? SUCCESS : ERROR;
+}
+
+Boolean readBenchmarkOptions(char *arguments[], int argumentCount,
+                             BenchmarkOptions *options) {
+    int index; /* The index of the current argument. */
+
+    /* Start with the default options. */
+    options->runCount = DEFAULT_RUN_COUNT;
+    options->jobCount = DEFAULT_BENCH_JOB_COUNT;
+    options->threshold = DEFAULT_THRESHOLD;
+    options->outputName = NULL;
+    options->baselineName = NULL;
+    options->assemblerPath = DEFAULT_ASSEMBLER_PATH;
+    options->generatorPath = DEFAULT_GENERATOR_PATH;
+    options->corpusDirectory = DEFAULT_CORPUS_DIRECTORY;
+
+    /* Every option comes with a value right after it. */
+    for (index = INITIAL_VALUE; index < argumentCount;
+         index += ARGS_DIFF + ARGS_DIFF) {
+        if (index + ARGS_DIFF == argumentCount) {
+            return FALSE;
+        }
+
+        /* Check for each option. */
+        if (strcmp(arguments[index], "--runs") == EQUAL_STRINGS) {
+            if (!convertNumber(arguments[index + ARGS_DIFF],
+                               &options->runCount)) {
+                return FALSE;
+            }
+        } else if (strcmp(arguments[index], "-j") == EQUAL_STRINGS) {
+            if (!convertNumber(arguments[index + ARGS_DIFF],
+                               &options->jobCount)) {
+                return FALSE;
+            }
+        } else if (strcmp(arguments[index], "--threshold") == EQUAL_STRINGS) {
+            if (!convertNumber(arguments[index + ARGS_DIFF],
+                               &options->threshold)) {
+                return FALSE;
+            }
+        } else if (strcmp(arguments[index], "-o") == EQUAL_STRINGS) {
+            options->outputName = arguments[index + ARGS_DIFF];
+        } else if (strcmp(arguments[index], "--compare") == EQUAL_STRINGS) {
+            options->baselineName = arguments[index + ARGS_DIFF];
+        } else if (strcmp(arguments[index], "--assembler") == EQUAL_STRINGS) {
+            options->assemblerPath = arguments[index + ARGS_DIFF];
+        } else if (strcmp(arguments[index], "--generator") == EQUAL_STRINGS) {
+            options->generatorPath = arguments[index + ARGS_DIFF];
+        } else if (strcmp(arguments[index], "--dir") == EQUAL_STRINGS) {
+            options->corpusDirectory = arguments[index + ARGS_DIFF];
+        } else {
+            return FALSE;
+        }
+    }
+
+    /* Every scenario is assembled at least once, with at least 1 job. */
+    return options->runCount != EMPTY && options->runCount <= MAX_RUN_COUNT &&
+           options->jobCount != EMPTY;
+}
+
+void printBenchmarkUsage() {
+    fprintf(stderr, "Usage: benchmark [options]\n"
+                    "  --runs N          Times each scenario is assembled.\n"
+                    "  -j N              Jobs the assembler is run with.\n"
+                    "  -o FILE           Write the JSON results to FILE.\n");
+    fprintf(stderr, "  --compare FILE    Compare to a stored baseline.\n"
+                    "  --threshold N     Percent of growth that regresses.\n"
+                    "  --assembler PATH  The assembler to measure.\n"
+                    "  --generator PATH  The workload generator.\n"
+                    "  --dir DIR         The directory of the corpora.\n");
+}
+
+Boolean generateCorpus(BenchmarkOptions *options, Scenario *scenario,
+                       char *fileNames[]) {
+    char *arguments[GENERATOR_ARGUMENT_COUNT]; /* The generator's arguments. */
+    char seed[PATH_BUFFER_SIZE];       /* The seed of the current file. */
+    char outputName[PATH_BUFFER_SIZE]; /* The name of the current .as file. */
+    int index;                         /* The index of the current file. */
+
+    /* The knobs that are the same for every file of the scenario. */
+    arguments[0] = options->generatorPath;
+    arguments[1] = "--seed";
+    arguments[2] = seed;
+    arguments[3] = "--lines";
+    arguments[4] = scenario->lineCount;
+    arguments[5] = "--macros";
+    arguments[6] = scenario->macroCount;
+    arguments[7] = "--macro-size";
+    arguments[8] = scenario->macroSize;
+    arguments[9] = "--call-percent";
+    arguments[10] = scenario->callPercent;
+    arguments[11] = "--comment-percent";
+    arguments[12] = scenario->commentPercent;
+    arguments[13] = "-o";
+    arguments[14] = outputName;
+    arguments[15] = NULL;
+
+    /* Generate each file with its own seed (its index, from 1). */
+    for (index = INITIAL_VALUE; index < scenario->fileCount; index++) {
+        sprintf(fileNames[index], "%s/%s%d", options->corpusDirectory,
+                scenario->name, index);
+        sprintf(outputName, "%s.as", fileNames[index]);
+        sprintf(seed, "%d", index + SINGLE_ENTRY);
+
+        if (!runProgram(arguments, NULL)) {
+            fprintf(stderr, "Failed to generate %s.\n", outputName);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+Boolean runScenario(BenchmarkOptions *options, Scenario *scenario,
+                    char *fileNames[], ScenarioResult *result) {
+    char **arguments;                  /* The assembler's arguments. */
+    char jobs[PATH_BUFFER_SIZE];       /* The number of jobs ("-jN"). */
+    char reportName[PATH_BUFFER_SIZE]; /* The file of the time report. */
+    double startTime;                  /* The time the current run started. */
+    unsigned long run;                 /* The index of the current run. */
+    int index;                         /* The index of the current file. */
+
+    /* Allocate the arguments: the options, the files and the NULL. */
+    arguments = malloc(sizeof(char *) * (ASSEMBLER_OPTION_COUNT +
+                                         scenario->fileCount + NULL_BYTE));
+    if (arguments == NULL) {
+        fprintf(stderr, "Failed to allocate enough memory.\n");
+        return FALSE;
+    }
+
+    /* Time every phase of every file, with the scenario's number of jobs or
+     * the given one. */
+    sprintf(jobs, "-j%lu", options->jobCount);
+    arguments[0] = options->assemblerPath;
+    arguments[1] = "--time-report";
+    arguments[2] = scenario->jobs != NULL ? scenario->jobs : jobs;
+    for (index = INITIAL_VALUE; index < scenario->fileCount; index++) {
+        arguments[ASSEMBLER_OPTION_COUNT + index] = fileNames[index];
+    }
+    arguments[ASSEMBLER_OPTION_COUNT + scenario->fileCount] = NULL;
+
+    /* The time report of every run is written next to the corpus. */
+    sprintf(reportName, "%s/%s.report", options->corpusDirectory,
+            scenario->name);
+    result->peakMemory = EMPTY;
+
+    /* Assemble the files, timing the whole process. */
+    for (run = INITIAL_VALUE; run < options->runCount; run++) {
+        startTime = getWallTime();
+        if (!runProgram(arguments, reportName)) {
+            fprintf(stderr, "Failed to assemble the %s files.\n",
+                    scenario->name);
+            free(arguments);
+            return FALSE;
+        }
+        result->wallTimes[run] = getWallTime() - startTime;
+
+        /* Read the measurements of the phases. */
+        if (!readTimeReport(reportName, result, (int)run)) {
+            fprintf(stderr, "Failed to read %s.\n", reportName);
+            free(arguments);
+            return FALSE;
+        }
+    }
+
+    free(arguments);
+    return TRUE;
+}
+
+Boolean readTimeReport(char reportName[], ScenarioResult *result, int run) {
+    char line[REPORT_LINE_SIZE]; /* The current line of the report. */
+    FILE *report;                /* The report. */
+    char *position;              /* The position of the next number. */
+    long peakMemory;             /* The peak memory of the run. */
+    Boolean hasTotals;           /* Whether the totals have been read. */
+    Index phase;                 /* The index of the current phase. */
+
+    /* Open the report. */
+    report = fopen(reportName, "r");
+    if (report == NULL) {
+        return FALSE;
+    }
+
+    /* Search for the totals and the peak memory. */
+    hasTotals = FALSE;
+    while (fgets(line, REPORT_LINE_SIZE, report) != NULL) {
+        /* The peak memory is on a line of its own. */
+        if (sscanf(line, "Peak memory (KB): %ld", &peakMemory) ==
+            SINGLE_ENTRY) {
+            if (peakMemory > result->peakMemory) {
+                result->peakMemory = peakMemory;
+            }
+            continue;
+        }
+
+        /* The totals start with their name. */
+        if (strncmp(line, "Total ", strlen("Total ")) != EQUAL_STRINGS) {
+            continue;
+        }
+
+        /* Read the lines and the words, and skip the labels and the macros. */
+        position = &line[strlen("Total ")];
+        result->lineCount = strtoul(position, &position, DECIMAL_BASE);
+        result->wordCount = strtoul(position, &position, DECIMAL_BASE);
+        strtoul(position, &position, DECIMAL_BASE);
+        strtoul(position, &position, DECIMAL_BASE);
+
+        /* Read the time of each phase, in milliseconds. */
+        for (phase = INITIAL_VALUE; phase < PHASE_COUNT; phase++) {
+            result->phaseTimes[phase][run] =
+                strtod(position, &position) / MILLISECONDS_PER_SECOND;
+        }
+        hasTotals = TRUE;
+    }
+
+    fclose(report);
+    return hasTotals;
+}
+
+Boolean runProgram(char *arguments[], char errorName[]) {
+    pid_t child; /* The process that runs the program. */
+    int status;  /* The exit status of the program. */
+    int output;  /* The file that the standard output goes to. */
+    int error;   /* The file that the standard error goes to. */
+
+    /* Run the program in a new process. */
+    child = fork();
+    if (child < EMPTY) {
+        return FALSE;
+    }
+
+    if (child == EMPTY) {
+        /* Throw away the standard output (and the standard error, if no file
+         * has been given for it). */
+        output = open("/dev/null", O_WRONLY);
+        error = errorName == NULL
+                    ? open("/dev/null", O_WRONLY)
+                    : open(errorName, O_WRONLY | O_CREAT | O_TRUNC,
+                           CORPUS_PERMISSIONS);
+        if (output < EMPTY || error < EMPTY) {
+            _exit(EXEC_FAILED);
+        }
+        dup2(output, STDOUT_FILENO);
+        dup2(error, STDERR_FILENO);
+        close(output);
+        close(error);
+
+        /* Replace the process with the program (returns only on failure). */
+        execv(arguments[0], arguments);
+        _exit(EXEC_FAILED);
+    }
+
+    /* Wait for the program to end. */
+    if (waitpid(child, &status, EMPTY) != child) {
+        return FALSE;
+    }
+
+    return WIFEXITED(status) && WEXITSTATUS(status) == SUCCESS;
+}
+
+void writeResults(FILE *output, BenchmarkOptions *options,
+                  ScenarioResult results[]) {
+    ScenarioResult *result; /* The result of the current scenario. */
+    double wallTime;        /* The median wall time of the scenario. */
+    int scenario;           /* The index of the current scenario. */
+    int runCount;           /* The number of runs of each scenario. */
+    Index phase;            /* The index of the current phase. */
+
+    runCount = (int)options->runCount;
+    fprintf(output, "{\n  \"runs\": %d,\n  \"jobs\": %lu,\n", runCount,
+            options->jobCount);
+    fprintf(output, "  \"scenarios\": [\n");
+
+    /* Write each scenario on a single line. */
+    for (scenario = INITIAL_VALUE; scenario < SCENARIO_COUNT; scenario++) {
+        result = &results[scenario];
+        wallTime = getMedian(result->wallTimes, runCount);
+
+        /* Write the sizes, the throughput and the peak memory. */
+        fprintf(output,
+                "    {\"name\": \"%s\", \"files\": %d, \"lines\": %lu, "
+                "\"words\": %lu, ",
+                SCENARIOS[scenario].name, SCENARIOS[scenario].fileCount,
+                result->lineCount, result->wordCount);
+        fprintf(output,
+                "\"wallMs\": %.*f, \"filesPerSecond\": %.*f, "
+                "\"wallSpreadPct\": %.*f, \"linesPerSecond\": %.*f, "
+                "\"peakMemoryKb\": %ld, ",
+                RESULT_PRECISION, wallTime * MILLISECONDS_PER_SECOND,
+                RESULT_PRECISION, SCENARIOS[scenario].fileCount / wallTime,
+                RESULT_PRECISION, getSpread(result->wallTimes, runCount),
+                RESULT_PRECISION, result->lineCount / wallTime,
+                result->peakMemory);
+
+        /* Write the median time of each phase, in milliseconds. */
+        fprintf(output, "\"phasesMs\": {");
+        for (phase = INITIAL_VALUE; phase < PHASE_COUNT; phase++) {
+            fprintf(output, "%s\"%s\": %.*f",
+                    phase == INITIAL_VALUE ? "" : ", ", PHASE_NAMES[phase],
+                    RESULT_PRECISION,
+                    getMedian(result->phaseTimes[phase], runCount) *
+                        MILLISECONDS_PER_SECOND);
+        }
+        fprintf(output, "}}%s\n",
+                scenario == SCENARIO_COUNT - LAST_INDEX_DIFF ? "" : ",");
+    }
+
+    fprintf(output, "  ]\n}\n");
+}
+
+int compareResults(BenchmarkOptions *options, ScenarioResult results[]) {
+    char line[REPORT_LINE_SIZE]; /* The current line of the baseline. */
+    FILE *baseline;              /* The baseline. */
+    char *name;                  /* The name of the current scenario. */
+    char *nameEnd;               /* The quote after the name. */
+    double wallTime;             /* The wall time in the baseline. */
+    double wallSpread;           /* The spread of the baseline's wall time. */
+    double wallLimit;            /* The percent the wall time may grow by. */
+    double peakMemory;           /* The peak memory in the baseline. */
+    int scenario;                /* The index of the current scenario. */
+    int regressions;             /* The number of regressions so far. */
+
+    /* Open the baseline. */
+    baseline = fopen(options->baselineName, "r");
+    if (baseline == NULL) {
+        fprintf(stderr, "Failed to open %s.\n", options->baselineName);
+        return ERROR_RESULT;
+    }
+
+    fprintf(stderr, "\n--- Compared to %s (threshold %lu%%) ---\n",
+            options->baselineName, options->threshold);
+
+    /* Compare every scenario in the baseline to the current one. */
+    regressions = EMPTY;
+    while (fgets(line, REPORT_LINE_SIZE, baseline) != NULL) {
+        /* Find the name of the scenario on the line. */
+        name = strstr(line, "\"name\": \"");
+        if (name == NULL || !findJsonNumber(line, "wallMs", &wallTime) ||
+            !findJsonNumber(line, "peakMemoryKb", &peakMemory)) {
+            continue;
+        }
+        name += strlen("\"name\": \"");
+        nameEnd = strchr(name, '"');
+        if (nameEnd == NULL) {
+            continue;
+        }
+        *nameEnd = '\0';
+
+        /* Baselines written before the spread was kept count as exact. */
+        if (!findJsonNumber(nameEnd + SINGLE_ENTRY, "wallSpreadPct",
+                            &wallSpread)) {
+            wallSpread = EMPTY;
+        }
+
+        /* Find the scenario with the same name. */
+        scenario = INITIAL_VALUE;
+        while (scenario < SCENARIO_COUNT &&
+               strcmp(SCENARIOS[scenario].name, name) != EQUAL_STRINGS) {
+            scenario++;
+        }
+        if (scenario == SCENARIO_COUNT) {
+            continue;
+        }
+
+        /* The wall time may also grow within the noise of both benchmarks. */
+        wallLimit = options->threshold > MIN_WALL_CHANGE_PERCENT
+                        ? (double)options->threshold
+                        : MIN_WALL_CHANGE_PERCENT;
+        wallLimit += wallSpread + getSpread(results[scenario].wallTimes,
+                                            (int)options->runCount);
+
+        /* Compare the median wall time and the peak memory. */
+        regressions += compareNumber(
+            name, "wall ms", wallTime,
+            getMedian(results[scenario].wallTimes, (int)options->runCount) *
+                MILLISECONDS_PER_SECOND,
+            wallLimit);
+        regressions += compareNumber(name, "peak KB", peakMemory,
+                                     (double)results[scenario].peakMemory,
+                                     (double)options->threshold);
+    }
+
+    fclose(baseline);
+    fprintf(stderr, "%d regression(s).\n", regressions);
+    return regressions;
+}
+
+Boolean compareNumber(char scenarioName[], char numberName[], double baseline,
+                      double current, double limit) {
+    double change;    /* The change in percents. */
+    Boolean regressed; /* Whether the number grew by more than the limit. */
+
+    /* Compute the change (a number that was 0 cannot regress). */
+    change = baseline == EMPTY
+                 ? EMPTY
+                 : (current - baseline) / baseline * WHOLE_PERCENT;
+    regressed = change > limit;
+
+    fprintf(stderr, "%-9s %-8s %12.*f -> %12.*f (%+.1f%%, limit %.1f%%)%s\n",
+            scenarioName, numberName, RESULT_PRECISION, baseline,
+            RESULT_PRECISION, current, change, limit,
+            regressed ? "  REGRESSION" : "");
+    return regressed;
+}
+
+Boolean findJsonNumber(char line[], char key[], double *number) {
+    char *position; /* The position of the key in the line. */
+    char *end;      /* The end of the number. */
+
+    /* Search for the quoted key (keys never contain each other with quotes). */
+    for (position = strchr(line, '"'); position != NULL;
+         position = strchr(position + SINGLE_ENTRY, '"')) {
+        if (strncmp(position + SINGLE_ENTRY, key, strlen(key)) ==
+                EQUAL_STRINGS &&
+            position[strlen(key) + SINGLE_ENTRY] == '"') {
+            break;
+        }
+    }
+    if (position == NULL) {
+        return FALSE;
+    }
+
+    /* Skip the closing quote and the colon, and read the number. */
+    position += strlen(key) + SINGLE_ENTRY + SINGLE_ENTRY;
+    position = strchr(position, ':');
+    if (position == NULL) {
+        return FALSE;
+    }
+    *number = strtod(position + SINGLE_ENTRY, &end);
+    return end != position + SINGLE_ENTRY;
+}
+
+double getMedian(double values[], int count) {
+    /* Sort the values, and take the one in the middle. */
+    qsort(values, (size_t)count, sizeof(double), compareDoubles);
+    if (count % MIDDLE_DIVISOR != EMPTY) {
+        return values[count / MIDDLE_DIVISOR];
+    }
+
+    /* Average the 2 values in the middle. */
+    return (values[count / MIDDLE_DIVISOR - LAST_INDEX_DIFF] +
+            values[count / MIDDLE_DIVISOR]) /
+           MIDDLE_DIVISOR;
+}
+
+double getSpread(double values[], int count) {
+    double median; /* The median of the values (which sorts them). */
+
+    /* A median of 0 leaves nothing to compare the spread to. */
+    median = getMedian(values, count);
+    if (median == EMPTY) {
+        return EMPTY;
+    }
+
+    /* Take the distance between the values a quarter from each end. */
+    return (values[count - LAST_INDEX_DIFF - count / QUARTER_DIVISOR] -
+            values[count / QUARTER_DIVISOR]) /
+           median * WHOLE_PERCENT;
+}
+
+int compareDoubles(const void *first, const void *second) {
+    double firstValue;  /* The first double. */
+    double secondValue; /* The second double. */
+
+    firstValue = *(const double *)first;
+    secondValue = *(const double *)second;
+
+    /* Avoid subtracting, which could round a small difference to 0. */
+    if (firstValue < secondValue) {
+        return -1;
+    }
+    return firstValue > secondValue;
+}
+
+double getWallTime() {
+    struct timespec now; /* The current time of the clock. */
+
+    /* Read the clock, which never goes back. */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    /* Combine the seconds and the nanoseconds. */
+    return (double)now.tv_sec + (double)now.tv_nsec / NANOSECONDS_PER_SECOND;
+}
+
+Boolean convertNumber(char value[], unsigned long *number) {
+    /* Check for an empty value. */
+    if (*value == '\0') {
+        return FALSE;
+    }
+
+    /* Convert the digits one by one. */
+    *number = INITIAL_VALUE;
+    while (*value != '\0') {
+        /* Check for a character that is not a digit. */
+        if (!isdigit(*value)) {
+            return FALSE;
+        }
+
+        /* Add the digit to the number. */
+        *number = *number * DECIMAL_BASE + (unsigned long)(*value - '0');
+        value++;
+    }
+
+    return TRUE;
+}
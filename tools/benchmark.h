@@ -0,0 +1,318 @@
+/*
+ * benchmark.h
+ *
+ * Contains the constants, typedefs and function prototypes for the functions in
+ * benchmark.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h> /* FILE. */
+
+#include "../globals.h" /* Constants and typedefs. */
+
+/* --- Default options. --- */
+
+/* The default number of times each scenario is assembled. */
+#define DEFAULT_RUN_COUNT 15
+/* The default number of jobs the assembler is run with. */
+#define DEFAULT_BENCH_JOB_COUNT 1
+/* The default percent that a number may grow by before it is a regression. */
+#define DEFAULT_THRESHOLD 10
+/* The default path of the assembler. */
+#define DEFAULT_ASSEMBLER_PATH "./assembler"
+/* The default path of the workload generator. */
+#define DEFAULT_GENERATOR_PATH "./tools/workloadGenerator"
+/* The default directory of the generated corpora. */
+#define DEFAULT_CORPUS_DIRECTORY "bench_corpus"
+
+/* --- Benchmark. --- */
+
+/* The minimum percent that a wall time must grow by to be a regression, since
+ * the speed of a machine drifts between runs of the benchmark. */
+#define MIN_WALL_CHANGE_PERCENT 25
+/* The maximum number of times each scenario can be assembled. */
+#define MAX_RUN_COUNT 100
+/* The number of scenarios. */
+#define SCENARIO_COUNT 5
+/* The number of files in the scenario with the most files. */
+#define MAX_SCENARIO_FILES 200
+/* The size of the buffer of a path or a command line argument. */
+#define PATH_BUFFER_SIZE 256
+/* The size of the buffer of a line of the time report or the baseline. */
+#define REPORT_LINE_SIZE 512
+/* The number of arguments of the generator (including the NULL at the end). */
+#define GENERATOR_ARGUMENT_COUNT 16
+/* The number of arguments of the assembler before the files (including its
+ * path). */
+#define ASSEMBLER_OPTION_COUNT 3
+/* The exit code of a child process that could not run the program. */
+#define EXEC_FAILED 127
+/* The permissions of the directory of the generated corpora. */
+#define CORPUS_PERMISSIONS 0755
+/* The number of percents in a whole. */
+#define WHOLE_PERCENT 100
+/* The number that splits the sorted runs in half, to find the median. */
+#define MIDDLE_DIVISOR 2
+/* Divides the number of values to find the quarter from each end. */
+#define QUARTER_DIVISOR 4
+/* The result of comparing to a baseline that cannot be read. */
+#define ERROR_RESULT (-1)
+/* The number of digits after the point of each number in the results. */
+#define RESULT_PRECISION 3
+
+/* The shape of a generated corpus. */
+typedef struct {
+    /* The name of the scenario, which also prefixes its files. */
+    char *name;
+    /* The number of files in the corpus. */
+    int fileCount;
+    /* The knobs of the generator (as command line arguments). */
+    char *lineCount;
+    char *macroCount;
+    char *macroSize;
+    char *callPercent;
+    char *commentPercent;
+    /* The number of jobs the assembler is run with ("-j1", "-j4"), or NULL for
+     * the number in the options. */
+    char *jobs;
+} Scenario;
+
+/* The options of the benchmark, given as command line arguments. */
+typedef struct {
+    /* The number of times each scenario is assembled. */
+    unsigned long runCount;
+    /* The number of jobs the assembler is run with. */
+    unsigned long jobCount;
+    /* The percent that a number may grow by before it is a regression. */
+    unsigned long threshold;
+    /* The name of the file to write the results to (NULL for stdout). */
+    char *outputName;
+    /* The name of the baseline to compare to (NULL for no comparison). */
+    char *baselineName;
+    /* The path of the assembler. */
+    char *assemblerPath;
+    /* The path of the workload generator. */
+    char *generatorPath;
+    /* The directory of the generated corpora. */
+    char *corpusDirectory;
+} BenchmarkOptions;
+
+/* The measurements of a single scenario. */
+typedef struct {
+    /* The number of macro-expanded lines in all the files. */
+    unsigned long lineCount;
+    /* The number of words in all the files. */
+    unsigned long wordCount;
+    /* The time each run took from start to end, in seconds. */
+    double wallTimes[MAX_RUN_COUNT];
+    /* The time each phase took in each run, summed over the files. */
+    double phaseTimes[PHASE_COUNT][MAX_RUN_COUNT];
+    /* The largest peak memory of all the runs, in kilobytes. */
+    long peakMemory;
+} ScenarioResult;
+
+/**
+ * Generates the corpora, assembles each of them several times and writes the
+ * results as JSON.
+ * Compares the results to a stored baseline if one is given.
+ *
+ * Assumes that the assembler and the generator have been built.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return 0 on success, 1 on a failure or a regression.
+ */
+int main(int argc, char *argv[]);
+
+/**
+ * Reads the given command line arguments into the given options.
+ * Options that are not given keep their defaults.
+ *
+ * Assumes that the given arguments array contains argumentCount strings.
+ *
+ * @param arguments The command line arguments (without the program's name).
+ * @param argumentCount The number of arguments.
+ * @param options The options to fill.
+ * @return Whether the arguments are valid.
+ */
+Boolean readBenchmarkOptions(char *arguments[], int argumentCount,
+                             BenchmarkOptions *options);
+
+/**
+ * Prints how to use the benchmark to stderr.
+ */
+void printBenchmarkUsage();
+
+/**
+ * Generates the files of the given scenario into the corpus directory, each
+ * with a different seed.
+ * Writes the name of each file (without the .as extension) into the given
+ * array.
+ *
+ * Assumes that the given file names array has room for the scenario's files,
+ * each PATH_BUFFER_SIZE characters long.
+ *
+ * @param options The options of the benchmark.
+ * @param scenario The scenario to generate.
+ * @param fileNames The array to write the names of the files to.
+ * @return Whether every file has been generated.
+ */
+Boolean generateCorpus(BenchmarkOptions *options, Scenario *scenario,
+                       char *fileNames[]);
+
+/**
+ * Assembles the files of the given scenario as many times as the options say,
+ * and measures every run.
+ *
+ * Assumes that the files of the scenario have been generated.
+ *
+ * @param options The options of the benchmark.
+ * @param scenario The scenario to assemble.
+ * @param fileNames The names of the files (without the .as extension).
+ * @param result The result to fill.
+ * @return Whether every run succeeded.
+ */
+Boolean runScenario(BenchmarkOptions *options, Scenario *scenario,
+                    char *fileNames[], ScenarioResult *result);
+
+/**
+ * Reads the totals, the peak memory and the time of each phase from the time
+ * report of a single run.
+ *
+ * Assumes that the given run index is smaller than MAX_RUN_COUNT.
+ *
+ * @param reportName The name of the file that holds the time report.
+ * @param result The result to fill.
+ * @param run The index of the run.
+ * @return Whether the report has been read.
+ */
+Boolean readTimeReport(char reportName[], ScenarioResult *result, int run);
+
+/**
+ * Runs the given program and waits for it to end.
+ * Its standard output is thrown away, and its standard error is written to the
+ * given file (or thrown away as well).
+ *
+ * Assumes that the given arguments array ends with NULL, and that its first
+ * argument is the path of the program.
+ *
+ * @param arguments The command line arguments of the program.
+ * @param errorName The name of the file to write the standard error to, or
+ * NULL to throw it away.
+ * @return Whether the program ran and exited with 0.
+ */
+Boolean runProgram(char *arguments[], char errorName[]);
+
+/**
+ * Writes the results of all the scenarios as JSON to the given file.
+ * Every scenario is written on a single line, so that the file can be read back
+ * as a baseline.
+ *
+ * Assumes that the given results array contains SCENARIO_COUNT results.
+ *
+ * @param output The file to write to.
+ * @param options The options of the benchmark.
+ * @param results The results of the scenarios.
+ */
+void writeResults(FILE *output, BenchmarkOptions *options,
+                  ScenarioResult results[]);
+
+/**
+ * Compares the results of all the scenarios to the given baseline, and prints
+ * the changes to stderr.
+ * A scenario regresses if its peak memory grew by more than the threshold, or
+ * if its median wall time grew by more than the threshold (and at least
+ * MIN_WALL_CHANGE_PERCENT) plus the spreads of the wall times in the baseline
+ * and in the current results, so that a difference within the noise of the
+ * runs is ignored.
+ *
+ * Assumes that the given results array contains SCENARIO_COUNT results.
+ *
+ * @param options The options of the benchmark.
+ * @param results The results of the scenarios.
+ * @return The number of regressions, or -1 if the baseline cannot be read.
+ */
+int compareResults(BenchmarkOptions *options, ScenarioResult results[]);
+
+/**
+ * Prints a single compared number to stderr and checks whether it regressed.
+ *
+ * @param scenarioName The name of the scenario.
+ * @param numberName The name of the number.
+ * @param baseline The number in the baseline.
+ * @param current The number in the current results.
+ * @param limit The percent that the number may grow by.
+ * @return Whether the number grew by more than the limit.
+ */
+Boolean compareNumber(char scenarioName[], char numberName[], double baseline,
+                      double current, double limit);
+
+/**
+ * Reads the number that follows the given key in a line of JSON.
+ *
+ * @param line The line to search.
+ * @param key The key, without its quotes.
+ * @param number The number to fill.
+ * @return Whether the key has been found.
+ */
+Boolean findJsonNumber(char line[], char key[], double *number);
+
+/**
+ * Returns the median of the given values.
+ * Reorders the values.
+ *
+ * Assumes that the given count is not zero.
+ *
+ * @param values The values.
+ * @param count The number of values.
+ * @return The median of the values.
+ */
+double getMedian(double values[], int count);
+
+/**
+ * Returns the spread of the given values: the distance between the values a
+ * quarter from each end, in percents of the median.
+ * Reorders the values.
+ *
+ * Assumes that the given count is not zero.
+ *
+ * @param values The values.
+ * @param count The number of values.
+ * @return The spread of the values, in percents.
+ */
+double getSpread(double values[], int count);
+
+/**
+ * Compares two doubles, for sorting them in an increasing order.
+ *
+ * @param first A pointer to the first double.
+ * @param second A pointer to the second double.
+ * @return A negative number, zero or a positive number if the first double is
+ * smaller, equal or larger.
+ */
+int compareDoubles(const void *first, const void *second);
+
+/**
+ * Returns the current time of a monotonic clock, in seconds.
+ *
+ * @return The current time.
+ */
+double getWallTime();
+
+/**
+ * Converts the given string of digits to a number.
+ *
+ * @param value The string to convert.
+ * @param number The number to fill.
+ * @return Whether the string contains only digits (at least one).
+ */
+Boolean convertNumber(char value[], unsigned long *number);
+
+#endif
@@ -0,0 +1,698 @@
+/*
+ * differentialTest.c
+ *
+ * A tool that checks that a candidate build of the assembler behaves exactly
+ * like a reference build, so that a faster path can be trusted.
+ * Every source (generated ones of several shapes, including invalid ones, and
+ * hand-written ones) is assembled by both builds, each in its own directory,
+ * and the .am, .ob, .ent and .ext files, the diagnostics and the exit codes are
+ * compared byte for byte.
+ * A source that the builds differ on is minimized: lines are removed for as
+ * long as the builds still differ, so that only the offending lines are left.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "differentialTest.h"
+
+#include <ctype.h>     /* isdigit. */
+#include <errno.h>     /* errno, EEXIST. */
+#include <fcntl.h>     /* open, O_WRONLY, O_CREAT, O_TRUNC. */
+#include <stdio.h>     /* FILE, fopen, fread, fwrite, printf, snprintf. */
+#include <stdlib.h>    /* malloc, realloc, free. */
+#include <string.h>    /* strcmp, strcpy, strcat, strlen, strrchr, memcmp. */
+#include <sys/stat.h>  /* mkdir. */
+#include <sys/types.h> /* pid_t. */
+#include <sys/wait.h>  /* waitpid, WIFEXITED, WEXITSTATUS, WTERMSIG. */
+#include <unistd.h>    /* fork, execv, chdir, getcwd, dup2, close, _exit. */
+
+#include "../globals.h" /* Constants and typedefs. */
+
+/* The shapes of the generated sources, which are used in turn. */
+static SourceShape SHAPES[SHAPE_COUNT] = {
+    /* A plain program. */
+    {"200", "0", "0", "0", "0", "0"},
+    /* A program that calls many macros. */
+    {"600", "12", "0", "0", "0", "0"},
+    /* A program with many extern and entry labels. */
+    {"400", "0", "6", "40", "0", "0"},
+    /* A program with a few invalid lines. */
+    {"300", "4", "3", "20", "10", "0"},
+    /* A program that is mostly invalid. */
+    {"150", "2", "2", "20", "60", "0"},
+    /* A program that fills the whole memory. */
+    {"5000", "0", "2", "10", "0", "0"},
+    /* A program that fills the whole memory, with a few invalid lines. */
+    {"5000", "8", "2", "10", "5", "0"},
+    /* A program with a single line that is too long (which stops the macro
+     * expansion, so it has no other invalid lines). */
+    {"200", "4", "2", "20", "0", "1"}};
+
+/* The extensions of the files each build writes for a source. */
+static char *OUTPUT_EXTENSIONS[OUTPUT_KIND_COUNT] = {"am",  "ob",     "ent",
+                                                     "ext", "stdout", "stderr"};
+
+int main(int argc, char *argv[]) {
+    DifferentialOptions options;       /* The command line options. */
+    char sourceName[PATH_BUFFER_SIZE]; /* The name of the current source. */
+    unsigned long total;               /* The number of sources. */
+    unsigned long failures;            /* The number of failing sources. */
+    unsigned long index;               /* The index of the current source. */
+
+    /* Read the options. */
+    if (!readDifferentialOptions(argv + ARGS_DIFF, argc - ARGS_DIFF,
+                                 &options)) {
+        printDifferentialUsage();
+        return ERROR;
+    }
+
+    /* Create the directories of the sources and the outputs. */
+    if (!createDirectories(&options)) {
+        fprintf(stderr, "Failed to create the directories in %s.\n",
+                options.directory);
+        return ERROR;
+    }
+
+    /* Go over the generated sources, then the hand-written ones. */
+    total = options.generatedCount + (unsigned long)options.sourceCount;
+    failures = EMPTY;
+    for (index = INITIAL_VALUE; index < total; index++) {
+        /* Generate the source, or take the next hand-written one. */
+        if (index < options.generatedCount) {
+            if (!generateSource(&options, index, sourceName)) {
+                fprintf(stderr, "Failed to generate source %lu.\n", index);
+                return ERROR;
+            }
+        } else {
+            strcpy(sourceName,
+                   options.sources[index - options.generatedCount]);
+        }
+
+        /* Check if the builds behave the same. */
+        if (compareSource(&options, sourceName, TRUE)) {
+            continue;
+        }
+        failures++;
+
+        /* Minimize the failing source. */
+        if (options.shouldMinimize && !minimizeSource(&options, sourceName)) {
+            fprintf(stderr, "Failed to minimize %s.as.\n", sourceName);
+        }
+    }
+
+    /* Print the summary. */
+    printf("%lu of %lu sources match.\n", total - failures, total);
+    return failures == EMPTY ? SUCCESS : ERROR;
+}
+
+Boolean readDifferentialOptions(char *arguments[], int argumentCount,
+                                DifferentialOptions *options) {
+    char *referencePath; /* The path of the reference build, as given. */
+    char *candidatePath; /* The path of the candidate build, as given. */
+    int index;           /* The index of the current argument. */
+
+    /* Start with the default options. */
+    referencePath = NULL;
+    candidatePath = NULL;
+    options->generatorPath = DEFAULT_DIFF_GENERATOR_PATH;
+    options->directory = DEFAULT_DIFF_DIRECTORY;
+    options->generatedCount = DEFAULT_GENERATED_COUNT;
+    options->shouldMinimize = TRUE;
+    options->candidateOptionCount = EMPTY;
+    options->sourceCount = EMPTY;
+
+    /* The hand-written sources are kept in the arguments array. */
+    options->sources = arguments;
+
+    for (index = INITIAL_VALUE; index < argumentCount; index++) {
+        /* The only option without a value. */
+        if (strcmp(arguments[index], "--no-minimize") == EQUAL_STRINGS) {
+            options->shouldMinimize = FALSE;
+            continue;
+        }
+
+        /* Collect the arguments that are not options as sources. */
+        if (arguments[index][INITIAL_VALUE] != '-') {
+            options->sources[options->sourceCount] = arguments[index];
+            options->sourceCount++;
+            continue;
+        }
+
+        /* Every other option comes with a value right after it. */
+        if (index + ARGS_DIFF == argumentCount) {
+            return FALSE;
+        }
+        index++;
+
+        /* Check for each option. */
+        if (strcmp(arguments[index - ARGS_DIFF], "--reference") ==
+            EQUAL_STRINGS) {
+            referencePath = arguments[index];
+        } else if (strcmp(arguments[index - ARGS_DIFF], "--candidate") ==
+                   EQUAL_STRINGS) {
+            candidatePath = arguments[index];
+        } else if (strcmp(arguments[index - ARGS_DIFF], "--candidate-option") ==
+                   EQUAL_STRINGS) {
+            if (options->candidateOptionCount == MAX_CANDIDATE_OPTIONS) {
+                return FALSE;
+            }
+            options->candidateOptions[options->candidateOptionCount] =
+                arguments[index];
+            options->candidateOptionCount++;
+        } else if (strcmp(arguments[index - ARGS_DIFF], "--generated") ==
+                   EQUAL_STRINGS) {
+            if (!convertCount(arguments[index], &options->generatedCount)) {
+                return FALSE;
+            }
+        } else if (strcmp(arguments[index - ARGS_DIFF], "--generator") ==
+                   EQUAL_STRINGS) {
+            options->generatorPath = arguments[index];
+        } else if (strcmp(arguments[index - ARGS_DIFF], "--dir") ==
+                   EQUAL_STRINGS) {
+            options->directory = arguments[index];
+        } else {
+            return FALSE;
+        }
+    }
+
+    /* Every path is built from the directory and a source's name, so they
+     * must leave room for the rest of it. */
+    if (strlen(options->directory) > MAX_PATH_NAME_LENGTH) {
+        return FALSE;
+    }
+    for (index = INITIAL_VALUE; index < options->sourceCount; index++) {
+        if (strlen(options->sources[index]) > MAX_PATH_NAME_LENGTH) {
+            return FALSE;
+        }
+    }
+
+    /* Both builds are run from their own directories, so their paths must be
+     * absolute. */
+    return referencePath != NULL && candidatePath != NULL &&
+           makeAbsolute(referencePath, options->referencePath) &&
+           makeAbsolute(candidatePath, options->candidatePath);
+}
+
+void printDifferentialUsage() {
+    fprintf(stderr,
+            "Usage: differentialTest --reference PATH --candidate PATH "
+            "[options] [source ...]\n"
+            "  --candidate-option OPT  Pass OPT to the candidate only.\n"
+            "  --generated N           Number of generated sources.\n");
+    fprintf(stderr, "  --generator PATH        The workload generator.\n"
+                    "  --dir DIR               The directory of the sources.\n"
+                    "  --no-minimize           Do not minimize failures.\n"
+                    "The directory and each source can be up to %d "
+                    "characters long.\n",
+            MAX_PATH_NAME_LENGTH);
+}
+
+Boolean makeAbsolute(char path[], char absolutePath[]) {
+    /* Check if the path is already absolute. */
+    if (path[INITIAL_VALUE] == '/') {
+        if (strlen(path) >= PATH_BUFFER_SIZE) {
+            return FALSE;
+        }
+        strcpy(absolutePath, path);
+        return TRUE;
+    }
+
+    /* Put the current directory before the path. */
+    if (getcwd(absolutePath, PATH_BUFFER_SIZE) == NULL ||
+        strlen(absolutePath) + strlen("/") + strlen(path) >= PATH_BUFFER_SIZE) {
+        return FALSE;
+    }
+    strcat(absolutePath, "/");
+    strcat(absolutePath, path);
+    return TRUE;
+}
+
+Boolean createDirectories(DifferentialOptions *options) {
+    /* The directories in the directory of the sources and the outputs. */
+    static char *DIRECTORIES[] = {"sources", "reference", "candidate",
+                                  "minimized"};
+
+    char path[PATH_BUFFER_SIZE]; /* The path of the current directory. */
+    Index index;                 /* The index of the current directory. */
+
+    /* Create the directory itself. */
+    if (mkdir(options->directory, DIFF_PERMISSIONS) != SUCCESS &&
+        errno != EEXIST) {
+        return FALSE;
+    }
+
+    /* Create each directory in it. */
+    for (index = INITIAL_VALUE;
+         index < sizeof(DIRECTORIES) / sizeof(DIRECTORIES[0]); index++) {
+        if (snprintf(path, PATH_BUFFER_SIZE, "%s/%s", options->directory,
+                     DIRECTORIES[index]) >= PATH_BUFFER_SIZE) {
+            return FALSE;
+        }
+        if (mkdir(path, DIFF_PERMISSIONS) != SUCCESS && errno != EEXIST) {
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+Boolean generateSource(DifferentialOptions *options, unsigned long index,
+                       char sourceName[]) {
+    char *arguments[DIFF_GENERATOR_ARGUMENT_COUNT]; /* The arguments. */
+    char outputName[PATH_BUFFER_SIZE]; /* The name of the .as file. */
+    char seed[PATH_BUFFER_SIZE];       /* The seed of the source. */
+    SourceShape *shape;                /* The shape of the source. */
+
+    /* The shapes are used in turn, and every source has its own seed. */
+    shape = &SHAPES[index % SHAPE_COUNT];
+    if (snprintf(sourceName, PATH_BUFFER_SIZE, "%s/sources/generated%lu",
+                 options->directory, index) >= PATH_BUFFER_SIZE ||
+        snprintf(outputName, PATH_BUFFER_SIZE, "%s.as", sourceName) >=
+            PATH_BUFFER_SIZE) {
+        return FALSE;
+    }
+    sprintf(seed, "%lu", index + SINGLE_ENTRY);
+
+    arguments[0] = options->generatorPath;
+    arguments[1] = "--seed";
+    arguments[2] = seed;
+    arguments[3] = "--lines";
+    arguments[4] = shape->lineCount;
+    arguments[5] = "--macros";
+    arguments[6] = shape->macroCount;
+    arguments[7] = "--externs";
+    arguments[8] = shape->externCount;
+    arguments[9] = "--entry-percent";
+    arguments[10] = shape->entryPercent;
+    arguments[11] = "--invalid-percent";
+    arguments[12] = shape->invalidPercent;
+    arguments[13] = "--too-long-line";
+    arguments[14] = shape->tooLongLine;
+    arguments[15] = "-o";
+    arguments[16] = outputName;
+    arguments[17] = NULL;
+
+    return runInDirectory(".", arguments, NULL, NULL) == SUCCESS;
+}
+
+Boolean compareSource(DifferentialOptions *options, char sourceName[],
+                      Boolean shouldReport) {
+    char referenceName[FULL_PATH_SIZE]; /* A file of the reference. */
+    char candidateName[FULL_PATH_SIZE]; /* The same file of the candidate. */
+    char *baseName;                       /* The source's name, without its
+                                           * directory. */
+    int referenceExit;                    /* The exit code of the reference. */
+    int candidateExit;                    /* The exit code of the candidate. */
+    Boolean isSame;                       /* Whether the builds match so far. */
+    Index kind;                           /* The index of the current file. */
+
+    /* Assemble the source with both builds. */
+    referenceExit = runBuild(options, "reference", options->referencePath,
+                             sourceName, FALSE);
+    candidateExit = runBuild(options, "candidate", options->candidatePath,
+                             sourceName, TRUE);
+
+    /* Compare the exit codes. */
+    isSame = referenceExit == candidateExit;
+    if (!isSame && shouldReport) {
+        printf("MISMATCH %s.as: exit code %d (reference) vs %d (candidate)\n",
+               sourceName, referenceExit, candidateExit);
+    }
+
+    /* Compare every file that the builds write, byte for byte. */
+    baseName = strrchr(sourceName, '/');
+    baseName = baseName == NULL ? sourceName : baseName + SINGLE_ENTRY;
+    for (kind = INITIAL_VALUE; kind < OUTPUT_KIND_COUNT; kind++) {
+        if (snprintf(referenceName, FULL_PATH_SIZE, "%s/reference/%s.%s",
+                     options->directory, baseName,
+                     OUTPUT_EXTENSIONS[kind]) >= FULL_PATH_SIZE ||
+            snprintf(candidateName, FULL_PATH_SIZE, "%s/candidate/%s.%s",
+                     options->directory, baseName,
+                     OUTPUT_EXTENSIONS[kind]) >= FULL_PATH_SIZE) {
+            return FALSE;
+        }
+
+        if (!compareFiles(referenceName, candidateName)) {
+            isSame = FALSE;
+            if (shouldReport) {
+                printf("MISMATCH %s.as: %s differs (%s vs %s)\n", sourceName,
+                       OUTPUT_EXTENSIONS[kind], referenceName, candidateName);
+            }
+        }
+    }
+
+    return isSame;
+}
+
+int runBuild(DifferentialOptions *options, char buildName[], char buildPath[],
+             char sourceName[], Boolean isCandidate) {
+    char *arguments[BUILD_ARGUMENT_COUNT + MAX_CANDIDATE_OPTIONS];
+    char directory[PATH_BUFFER_SIZE];  /* The build's directory. */
+    char fileName[FULL_PATH_SIZE];     /* The current file in the directory. */
+    char outputName[FULL_PATH_SIZE];   /* The file of the standard output. */
+    char errorName[FULL_PATH_SIZE];    /* The file of the standard error. */
+    char *baseName;                    /* The source's name, without its
+                                        * directory. */
+    int count;                         /* The number of arguments so far. */
+    int index;                         /* The index of the current option. */
+    Index kind;                        /* The index of the current output. */
+
+    baseName = strrchr(sourceName, '/');
+    baseName = baseName == NULL ? sourceName : baseName + SINGLE_ENTRY;
+    if (snprintf(directory, PATH_BUFFER_SIZE, "%s/%s", options->directory,
+                 buildName) >= PATH_BUFFER_SIZE) {
+        return ERROR_RESULT;
+    }
+
+    /* Remove the outputs of the previous source, so that a file that is not
+     * written again is not compared. */
+    for (kind = INITIAL_VALUE; kind < OUTPUT_KIND_COUNT; kind++) {
+        if (snprintf(fileName, FULL_PATH_SIZE, "%s/%s.%s", directory, baseName,
+                     OUTPUT_EXTENSIONS[kind]) >= FULL_PATH_SIZE) {
+            return ERROR_RESULT;
+        }
+        remove(fileName);
+    }
+
+    /* Copy the source into the directory, so that both builds print the same
+     * file names in their diagnostics. */
+    if (snprintf(fileName, FULL_PATH_SIZE, "%s.as", sourceName) >=
+            FULL_PATH_SIZE ||
+        snprintf(outputName, FULL_PATH_SIZE, "%s/%s.as", directory,
+                 baseName) >= FULL_PATH_SIZE ||
+        !copyFile(fileName, outputName)) {
+        return ERROR_RESULT;
+    }
+
+    /* Pass the candidate's options before the source. */
+    count = INITIAL_VALUE;
+    arguments[count++] = buildPath;
+    if (isCandidate) {
+        for (index = INITIAL_VALUE; index < options->candidateOptionCount;
+             index++) {
+            arguments[count++] = options->candidateOptions[index];
+        }
+    }
+    arguments[count++] = baseName;
+    arguments[count] = NULL;
+
+    /* Assemble the source in the build's directory. */
+    if (snprintf(outputName, FULL_PATH_SIZE, "%s.stdout", baseName) >=
+            FULL_PATH_SIZE ||
+        snprintf(errorName, FULL_PATH_SIZE, "%s.stderr", baseName) >=
+            FULL_PATH_SIZE) {
+        return ERROR_RESULT;
+    }
+    return runInDirectory(directory, arguments, outputName, errorName);
+}
+
+int runInDirectory(char directory[], char *arguments[], char outputName[],
+                   char errorName[]) {
+    pid_t child; /* The process that runs the program. */
+    int status;  /* The status of the program when it ended. */
+    int output;  /* The file that the standard output goes to. */
+    int error;   /* The file that the standard error goes to. */
+
+    /* Run the program in a new process. */
+    child = fork();
+    if (child < EMPTY) {
+        return ERROR_RESULT;
+    }
+
+    if (child == EMPTY) {
+        /* Move to the directory, and open the files relative to it. */
+        if (chdir(directory) != SUCCESS) {
+            _exit(EXEC_FAILED);
+        }
+        output = outputName == NULL
+                     ? open("/dev/null", O_WRONLY)
+                     : open(outputName, O_WRONLY | O_CREAT | O_TRUNC,
+                            DIFF_PERMISSIONS);
+        error = errorName == NULL
+                    ? open("/dev/null", O_WRONLY)
+                    : open(errorName, O_WRONLY | O_CREAT | O_TRUNC,
+                           DIFF_PERMISSIONS);
+        if (output < EMPTY || error < EMPTY) {
+            _exit(EXEC_FAILED);
+        }
+        dup2(output, STDOUT_FILENO);
+        dup2(error, STDERR_FILENO);
+        close(output);
+        close(error);
+
+        /* Replace the process with the program (returns only on failure). */
+        execv(arguments[0], arguments);
+        _exit(EXEC_FAILED);
+    }
+
+    /* Wait for the program to end. */
+    if (waitpid(child, &status, EMPTY) != child) {
+        return ERROR_RESULT;
+    }
+
+    /* A crash must not look like any exit code. */
+    return WIFEXITED(status) ? WEXITSTATUS(status)
+                             : SIGNAL_EXIT_BASE + WTERMSIG(status);
+}
+
+Boolean compareFiles(char firstName[], char secondName[]) {
+    char firstBuffer[COPY_BUFFER_SIZE];  /* The current part of the first. */
+    char secondBuffer[COPY_BUFFER_SIZE]; /* The same part of the second. */
+    FILE *first;                         /* The first file. */
+    FILE *second;                        /* The second file. */
+    size_t firstCount;                   /* The bytes read from the first. */
+    size_t secondCount;                  /* The bytes read from the second. */
+    Boolean isSame;                      /* Whether the files match so far. */
+
+    /* Files that are both missing are the same, and a single one is not. */
+    first = fopen(firstName, "rb");
+    second = fopen(secondName, "rb");
+    if (first == NULL || second == NULL) {
+        isSame = first == second;
+        if (first != NULL) {
+            fclose(first);
+        }
+        if (second != NULL) {
+            fclose(second);
+        }
+        return isSame;
+    }
+
+    /* Compare the files part by part, until one of them ends. */
+    do {
+        firstCount = fread(firstBuffer, sizeof(char), COPY_BUFFER_SIZE, first);
+        secondCount =
+            fread(secondBuffer, sizeof(char), COPY_BUFFER_SIZE, second);
+        isSame = firstCount == secondCount &&
+                 memcmp(firstBuffer, secondBuffer, firstCount) ==
+                     EQUAL_STRINGS;
+    } while (isSame && firstCount == COPY_BUFFER_SIZE);
+
+    fclose(first);
+    fclose(second);
+    return isSame;
+}
+
+Boolean copyFile(char fromName[], char toName[]) {
+    char buffer[COPY_BUFFER_SIZE]; /* The current part of the file. */
+    FILE *from;                    /* The file to copy. */
+    FILE *to;                      /* The copy. */
+    size_t count;                  /* The bytes in the current part. */
+
+    /* Open both files. */
+    from = fopen(fromName, "rb");
+    if (from == NULL) {
+        return FALSE;
+    }
+    to = fopen(toName, "wb");
+    if (to == NULL) {
+        fclose(from);
+        return FALSE;
+    }
+
+    /* Copy the file part by part. */
+    while ((count = fread(buffer, sizeof(char), COPY_BUFFER_SIZE, from)) >
+           EMPTY) {
+        fwrite(buffer, sizeof(char), count, to);
+    }
+
+    fclose(from);
+    fclose(to);
+    return TRUE;
+}
+
+Boolean minimizeSource(DifferentialOptions *options, char sourceName[]) {
+    char line[SOURCE_LINE_SIZE];        /* The current line. */
+    char minimizedName[FULL_PATH_SIZE]; /* The minimized source. */
+    char fileName[FULL_PATH_SIZE + EXTENSION_ROOM]; /* Its .as file. */
+    char *baseName;         /* The source's name, without its directory. */
+    char **lines;           /* The lines of the source. */
+    Boolean *isKept;        /* Whether each line is kept. */
+    Boolean *isRemoving;    /* Whether each line is being removed. */
+    FILE *source;           /* The source. */
+    unsigned long count;    /* The number of lines. */
+    unsigned long capacity; /* The number of lines there is room for. */
+    unsigned long chunk;    /* The number of lines removed at a time. */
+    unsigned long start;    /* The first line of the current chunk. */
+    unsigned long index;    /* The index of the current line. */
+    unsigned long removed;  /* The number of kept lines in the chunk. */
+    unsigned long kept;     /* The number of kept lines. */
+    Boolean hasProgressed;  /* Whether a chunk has been removed. */
+
+    /* Read the lines of the source. */
+    if (snprintf(fileName, sizeof(fileName), "%s.as", sourceName) >=
+        (int)sizeof(fileName)) {
+        return FALSE;
+    }
+    source = fopen(fileName, "r");
+    if (source == NULL) {
+        return FALSE;
+    }
+    count = EMPTY;
+    capacity = EMPTY;
+    lines = NULL;
+    while (fgets(line, SOURCE_LINE_SIZE, source) != NULL) {
+        /* Make room for another line. */
+        if (count == capacity) {
+            capacity = capacity == EMPTY ? INITIAL_LINE_CAPACITY
+                                         : capacity * LINE_GROWTH_FACTOR;
+            lines = realloc(lines, sizeof(char *) * capacity);
+            if (lines == NULL) {
+                fclose(source);
+                return FALSE;
+            }
+        }
+
+        lines[count] = malloc(strlen(line) + NULL_BYTE);
+        if (lines[count] == NULL) {
+            fclose(source);
+            return FALSE;
+        }
+        strcpy(lines[count], line);
+        count++;
+    }
+    fclose(source);
+
+    /* Start with every line kept. */
+    isKept = malloc(sizeof(Boolean) * (count + SINGLE_ENTRY));
+    isRemoving = malloc(sizeof(Boolean) * (count + SINGLE_ENTRY));
+    if (isKept == NULL || isRemoving == NULL) {
+        return FALSE;
+    }
+    for (index = INITIAL_VALUE; index < count; index++) {
+        isKept[index] = TRUE;
+        isRemoving[index] = FALSE;
+    }
+
+    /* The minimized source keeps the source's name in its own directory. */
+    baseName = strrchr(sourceName, '/');
+    baseName = baseName == NULL ? sourceName : baseName + SINGLE_ENTRY;
+    if (snprintf(minimizedName, FULL_PATH_SIZE, "%s/minimized/%s",
+                 options->directory, baseName) >= FULL_PATH_SIZE ||
+        snprintf(fileName, sizeof(fileName), "%s.as", minimizedName) >=
+            (int)sizeof(fileName)) {
+        return FALSE;
+    }
+
+    /* Remove chunks of lines, halving the chunks when none can be removed. */
+    chunk = count / CHUNK_DIVISOR;
+    while (chunk > EMPTY) {
+        hasProgressed = FALSE;
+        for (start = INITIAL_VALUE; start < count; start += chunk) {
+            /* Remove the kept lines of the chunk. */
+            removed = EMPTY;
+            for (index = start; index < start + chunk && index < count;
+                 index++) {
+                isRemoving[index] = isKept[index];
+                if (isKept[index]) {
+                    isKept[index] = FALSE;
+                    removed++;
+                }
+            }
+            if (removed == EMPTY) {
+                continue;
+            }
+
+            /* Keep the removal only if the builds still differ. */
+            if (writeKeptLines(fileName, lines, isKept, count) &&
+                !compareSource(options, minimizedName, FALSE)) {
+                hasProgressed = TRUE;
+                continue;
+            }
+            /* Put the lines of the chunk back. */
+            for (index = start; index < start + chunk && index < count;
+                 index++) {
+                isKept[index] = isKept[index] || isRemoving[index];
+            }
+        }
+
+        /* Try smaller chunks only when the current ones cannot be removed. */
+        if (!hasProgressed) {
+            chunk /= CHUNK_DIVISOR;
+        }
+    }
+
+    /* Write the smallest failing source, and report it. */
+    writeKeptLines(fileName, lines, isKept, count);
+    kept = EMPTY;
+    for (index = INITIAL_VALUE; index < count; index++) {
+        kept += isKept[index];
+    }
+    printf("MINIMIZED %s.as: %lu of %lu lines left in %s\n", sourceName, kept,
+           count, fileName);
+
+    /* Free the lines. */
+    for (index = INITIAL_VALUE; index < count; index++) {
+        free(lines[index]);
+    }
+    free(lines);
+    free(isKept);
+    free(isRemoving);
+    return TRUE;
+}
+
+Boolean writeKeptLines(char fileName[], char *lines[], Boolean isKept[],
+                       unsigned long lineCount) {
+    FILE *file;          /* The file to write. */
+    unsigned long index; /* The index of the current line. */
+
+    file = fopen(fileName, "w");
+    if (file == NULL) {
+        return FALSE;
+    }
+
+    /* Write only the kept lines, in order. */
+    for (index = INITIAL_VALUE; index < lineCount; index++) {
+        if (isKept[index]) {
+            fputs(lines[index], file);
+        }
+    }
+
+    fclose(file);
+    return TRUE;
+}
+
+Boolean convertCount(char value[], unsigned long *number) {
+    /* Check for an empty value. */
+    if (*value == '\0') {
+        return FALSE;
+    }
+
+    /* Convert the digits one by one. */
+    *number = INITIAL_VALUE;
+    while (*value != '\0') {
+        /* Check for a character that is not a digit. */
+        if (!isdigit(*value)) {
+            return FALSE;
+        }
+
+        /* Add the digit to the number. */
+        *number = *number * DECIMAL_BASE + (unsigned long)(*value - '0');
+        value++;
+    }
+
+    return TRUE;
+}
@@ -0,0 +1,271 @@
+/*
+ * differentialTest.h
+ *
+ * Contains the constants, typedefs and function prototypes for the functions in
+ * differentialTest.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef DIFFERENTIAL_TEST_H
+#define DIFFERENTIAL_TEST_H
+
+#include "../globals.h" /* Constants and typedefs. */
+
+/* --- Default options. --- */
+
+/* The default number of generated sources. */
+#define DEFAULT_GENERATED_COUNT 70
+/* The default path of the workload generator. */
+#define DEFAULT_DIFF_GENERATOR_PATH "./tools/workloadGenerator"
+/* The default directory of the sources and the outputs. */
+#define DEFAULT_DIFF_DIRECTORY "difftest_corpus"
+
+/* --- Differential test. --- */
+
+/* The number of shapes of generated sources. */
+#define SHAPE_COUNT 8
+/* The maximum number of options that are passed to the candidate only. */
+#define MAX_CANDIDATE_OPTIONS 8
+/* The number of files each build writes for a source (the 4 generated files,
+ * the standard output with the diagnostics and the standard error). */
+#define OUTPUT_KIND_COUNT 6
+/* The size of the buffer of a path. */
+#define PATH_BUFFER_SIZE 512
+/* The maximum length of the directory and of a hand-written source, so that
+ * every path that joins them with a file name fits in a path buffer. */
+#define MAX_PATH_NAME_LENGTH 240
+/* The size of the buffer of a path that joins 2 paths and an extension. */
+#define FULL_PATH_SIZE 1100
+/* The room for an extension that is added to a path. */
+#define EXTENSION_ROOM 8
+/* The size of the buffer of a single line of a source (longer lines are split,
+ * which still keeps the source the same). */
+#define SOURCE_LINE_SIZE 1024
+/* The size of the buffer that files are compared and copied with. */
+#define COPY_BUFFER_SIZE 4096
+/* The number of arguments of the generator (including the NULL at the end). */
+#define DIFF_GENERATOR_ARGUMENT_COUNT 18
+/* The number of arguments of a build besides its options (its path, the name
+ * of the source and the NULL at the end). */
+#define BUILD_ARGUMENT_COUNT 3
+/* The exit code of a child process that could not run the program. */
+#define EXEC_FAILED 127
+/* The number that is added to a signal that ended a build, so that it does not
+ * look like an exit code. */
+#define SIGNAL_EXIT_BASE 128
+/* The permissions of the created directories and files. */
+#define DIFF_PERMISSIONS 0755
+/* The number that divides the size of the removed chunks each time. */
+#define CHUNK_DIVISOR 2
+/* The number of lines of a source there is room for at first. */
+#define INITIAL_LINE_CAPACITY 256
+/* The factor that the room for lines grows by when it is full. */
+#define LINE_GROWTH_FACTOR 2
+/* The result of a build that could not be run. */
+#define ERROR_RESULT (-1)
+
+/* The shape of a generated source, as knobs of the generator. */
+typedef struct {
+    char *lineCount;
+    char *macroCount;
+    char *externCount;
+    char *entryPercent;
+    char *invalidPercent;
+    char *tooLongLine;
+} SourceShape;
+
+/* The options of the differential test, given as command line arguments. */
+typedef struct {
+    /* The absolute path of the reference build. */
+    char referencePath[PATH_BUFFER_SIZE];
+    /* The absolute path of the candidate build. */
+    char candidatePath[PATH_BUFFER_SIZE];
+    /* The path of the workload generator. */
+    char *generatorPath;
+    /* The directory of the sources and the outputs. */
+    char *directory;
+    /* The number of generated sources. */
+    unsigned long generatedCount;
+    /* Whether failing sources are minimized. */
+    Boolean shouldMinimize;
+    /* The options that are passed to the candidate only. */
+    char *candidateOptions[MAX_CANDIDATE_OPTIONS];
+    /* The number of options that are passed to the candidate only. */
+    int candidateOptionCount;
+    /* The hand-written sources (without the .as extension). */
+    char **sources;
+    /* The number of hand-written sources. */
+    int sourceCount;
+} DifferentialOptions;
+
+/**
+ * Generates the sources, assembles every source (generated and hand-written)
+ * with the reference build and the candidate build, and compares the outputs.
+ * Minimizes every source whose outputs differ.
+ *
+ * Assumes that the generator has been built.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return 0 if every source matches, 1 otherwise.
+ */
+int main(int argc, char *argv[]);
+
+/**
+ * Reads the given command line arguments into the given options.
+ * Options that are not given keep their defaults, and the arguments that are
+ * not options are the hand-written sources.
+ *
+ * Assumes that the given arguments array contains argumentCount strings.
+ *
+ * @param arguments The command line arguments (without the program's name).
+ * @param argumentCount The number of arguments.
+ * @param options The options to fill.
+ * @return Whether the arguments are valid.
+ */
+Boolean readDifferentialOptions(char *arguments[], int argumentCount,
+                                DifferentialOptions *options);
+
+/**
+ * Prints how to use the differential test to stderr.
+ */
+void printDifferentialUsage();
+
+/**
+ * Writes the absolute form of the given path into the given buffer.
+ *
+ * Assumes that the given buffer is PATH_BUFFER_SIZE characters long.
+ *
+ * @param path The path.
+ * @param absolutePath The buffer to write the absolute path to.
+ * @return Whether the absolute path fits in the buffer.
+ */
+Boolean makeAbsolute(char path[], char absolutePath[]);
+
+/**
+ * Creates the directory of the sources and the outputs and the directories in
+ * it (some may already exist).
+ *
+ * @param options The options of the differential test.
+ * @return Whether every directory exists.
+ */
+Boolean createDirectories(DifferentialOptions *options);
+
+/**
+ * Generates a single source with the given index, whose shape and seed depend
+ * on the index.
+ *
+ * @param options The options of the differential test.
+ * @param index The index of the source.
+ * @param sourceName The name of the source to write (without the .as
+ * extension).
+ * @return Whether the source has been generated.
+ */
+Boolean generateSource(DifferentialOptions *options, unsigned long index,
+                       char sourceName[]);
+
+/**
+ * Assembles the given source with both builds, each in its own directory, and
+ * compares every output file, the diagnostics and the exit codes.
+ * Prints every difference to stdout if asked to.
+ *
+ * @param options The options of the differential test.
+ * @param sourceName The name of the source (without the .as extension).
+ * @param shouldReport Whether to print the differences.
+ * @return Whether the builds behaved the same.
+ */
+Boolean compareSource(DifferentialOptions *options, char sourceName[],
+                      Boolean shouldReport);
+
+/**
+ * Copies the given source into the given build's directory, removes the
+ * outputs of the previous source and assembles it there.
+ *
+ * @param options The options of the differential test.
+ * @param buildName The name of the build's directory.
+ * @param buildPath The absolute path of the build.
+ * @param sourceName The name of the source (without the .as extension).
+ * @param isCandidate Whether to pass the candidate's options.
+ * @return The exit code of the build, or -1 if it could not be run.
+ */
+int runBuild(DifferentialOptions *options, char buildName[], char buildPath[],
+             char sourceName[], Boolean isCandidate);
+
+/**
+ * Runs the given program in the given directory and waits for it to end.
+ * Its standard output and standard error are written to the given files (or
+ * thrown away).
+ *
+ * Assumes that the given arguments array ends with NULL, and that its first
+ * argument is the path of the program.
+ *
+ * @param directory The directory to run the program in.
+ * @param arguments The command line arguments of the program.
+ * @param outputName The file for the standard output (in the directory), or
+ * NULL to throw it away.
+ * @param errorName The file for the standard error (in the directory), or
+ * NULL to throw it away.
+ * @return The exit code of the program, 128 plus the signal that ended it, or
+ * -1 if it could not be run.
+ */
+int runInDirectory(char directory[], char *arguments[], char outputName[],
+                   char errorName[]);
+
+/**
+ * Compares the given files byte for byte.
+ * Two files that are both missing are the same.
+ *
+ * @param firstName The name of the first file.
+ * @param secondName The name of the second file.
+ * @return Whether the files are the same.
+ */
+Boolean compareFiles(char firstName[], char secondName[]);
+
+/**
+ * Copies the given file.
+ *
+ * @param fromName The name of the file to copy.
+ * @param toName The name of the copy.
+ * @return Whether the file has been copied.
+ */
+Boolean copyFile(char fromName[], char toName[]);
+
+/**
+ * Removes lines from the given failing source for as long as the builds still
+ * differ on it, first in large chunks and then in smaller ones, and writes the
+ * smallest source that still fails next to the sources.
+ *
+ * Assumes that the builds differ on the given source.
+ *
+ * @param options The options of the differential test.
+ * @param sourceName The name of the source (without the .as extension).
+ * @return Whether the source could be read and minimized.
+ */
+Boolean minimizeSource(DifferentialOptions *options, char sourceName[]);
+
+/**
+ * Writes the lines of a source that are kept.
+ *
+ * @param fileName The name of the file to write.
+ * @param lines The lines of the source.
+ * @param isKept Whether each line is kept.
+ * @param lineCount The number of lines.
+ * @return Whether the file has been written.
+ */
+Boolean writeKeptLines(char fileName[], char *lines[], Boolean isKept[],
+                       unsigned long lineCount);
+
+/**
+ * Converts the given string of digits to a number.
+ *
+ * @param value The string to convert.
+ * @param number The number to fill.
+ * @return Whether the string contains only digits (at least one).
+ */
+Boolean convertCount(char value[], unsigned long *number);
+
+#endif
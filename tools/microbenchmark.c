@@ -0,0 +1,450 @@
+/*
+ * microbenchmark.c
+ *
+ * A tool that measures the assembler's kernels in isolation: the tokenizer, the
+ * lookups of operations, operands, macros and labels, the encoder and the
+ * formatter of the .ob file.
+ * Every kernel runs over fixed inputs in memory, so that no file is touched
+ * while it is measured.
+ * Each kernel is warmed up, its calls are repeated until a sample is long
+ * enough for the clock, and the nanoseconds per operation of several samples
+ * are printed.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "microbenchmark.h"
+
+#include <stdio.h>  /* printf, fprintf, sprintf. */
+#include <stdlib.h> /* qsort. */
+#include <string.h> /* strcmp, strstr. */
+
+#include "../globals.h"                /* Constants and typedefs. */
+#include "../arena.h"                  /* Freeing the fixtures. */
+#include "../encoder.h"                /* The encoder kernels. */
+#include "../fileGeneration.h"         /* The formatter kernel. */
+#include "../foundLabelList.h"         /* The labels of the symbol table. */
+#include "../freeingLogic.h"           /* The main thread's arena. */
+#include "../instructionInformation.h" /* The operation and operand kernels. */
+#include "../lexer.h"                  /* The lexer kernel. */
+#include "../macroTable.h"             /* The macro table kernel. */
+#include "../symbolTable.h"            /* The symbol table kernel. */
+#include "../textBuffer.h"             /* The output of the formatter. */
+#include "../timeReport.h"             /* Reading the monotonic clock. */
+#include "../utils.h"                  /* The tokenizer kernels. */
+#include "../wordImage.h"              /* The words of the formatter. */
+
+/* Strings that start with whitespace, as the tokenizer meets them. */
+static char *SPACED[] = {"mov r1, r2",  " add #5, r3",    "\tjmp LOOP",
+                         "   prn *r4",  "\t\t.data 7, -3", "  , LENGTH",
+                         "    stop",    " \t , r7",       "inc COUNT",
+                         "\t  red r0"};
+
+/* Strings that start with a word, as the tokenizer meets them. */
+static char *WORDS[] = {"mov r1, r2", "#-512, r3",     "LOOP",
+                        "*r4",        ".data 7, -3",   "LENGTH",
+                        "stop",       "VERYLONGLABEL", "COUNT: inc r1",
+                        "r0"};
+
+/* Complete lines of a program. */
+static char *LINES[] = {
+    "MAIN: mov r3, LENGTH\n",   "LOOP: jmp L1\n",
+    "prn #-5\n",                "bne LOOP\n",
+    "sub *r1, r4\n",            "L1: inc K\n",
+    "cmp K, #-6\n",             "END: stop\n",
+    "STR: .string \"abcd\"\n",  "LENGTH: .data 6, -9, 15\n",
+    "K: .data 22\n",            "    lea STR, *r6\n",
+    "\t.entry MAIN\n",          ".extern W\n",
+    "    add r7 , *r6\n",       "jsr W\n"};
+
+/* Keywords, followed by words that are not keywords. */
+static char *KEYWORD_NAMES[] = {
+    "mov", "cmp", "add", "sub", "lea", "clr", "not", "inc",
+    "dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop",
+    ".data", ".string", ".entry", ".extern", "macr", "endmacr",
+    "MAIN", ".date", "move", "r3"};
+
+/* Operands of every addressing mode. */
+static char *OPERANDS[] = {"#5",  "#-1024", "#+12", "LENGTH", "LOOP",
+                           "*r0", "*r7",    "r1",   "r6",     "K"};
+
+/* Pairs of source and destination types (the sources come first). */
+static OperandType OPERAND_PAIRS[][2] = {
+    {IMMEDIATE, DIRECT},
+    {DIRECT, DIRECT_REGISTER},
+    {INDIRECT_REGISTER, INDIRECT_REGISTER},
+    {DIRECT_REGISTER, DIRECT},
+    {ABSENT_OPERAND, DIRECT_REGISTER},
+    {ABSENT_OPERAND, ABSENT_OPERAND}};
+
+/* Immediate values of the whole range. */
+static short IMMEDIATES[] = {0,   1,    -1,   5,    -5,    255,
+                             -256, 1023, -1024, 2047, -2048, 42};
+
+/* Names of macros, of which the last ones are not in the table. */
+static char *MACRO_NAMES[] = {"m0",  "m7",  "m15", "m23", "m31",
+                              "m39", "m47", "m55", "m63", "m1",
+                              "m64", "mcr", "x",   "m100"};
+
+/* The fixtures that are built once. */
+static FoundLabel *foundLabels;                 /* The label list. */
+static SymbolTable symbols;                     /* The symbol table. */
+static MacroTable macros;                       /* The macro table. */
+static WordImage image;                         /* The formatted words. */
+static TextBuffer output;                       /* The formatted text. */
+static char *lookupNames[FIXTURE_LOOKUP_COUNT]; /* The searched labels. */
+
+/* The kernels, with the number of inputs each one goes over. */
+static Kernel KERNELS[] = {
+    {"skipWhitespace", runSkipWhitespace, sizeof(SPACED) / sizeof(char *)},
+    {"skipCharacters", runSkipCharacters, sizeof(WORDS) / sizeof(char *)},
+    {"getTokenSlice", runGetTokenSlice, sizeof(LINES) / sizeof(char *)},
+    {"lexLine", runLexLine, sizeof(LINES) / sizeof(char *)},
+    {"getKeywordIndex", runGetKeywordIndex,
+     sizeof(KEYWORD_NAMES) / sizeof(char *)},
+    {"getOperandType", runGetOperandType, sizeof(OPERANDS) / sizeof(char *)},
+    {"encodeFirstWord", runEncodeFirstWord,
+     OPERATION_COUNT * sizeof(OPERAND_PAIRS) / sizeof(OPERAND_PAIRS[0])},
+    {"encodeImmediate", runEncodeImmediate, sizeof(IMMEDIATES) / sizeof(short)},
+    {"encodeRegister", runEncodeRegister, REGISTER_COUNT * REGISTER_ROLES},
+    {"getMacroContent", runGetMacroContent,
+     sizeof(MACRO_NAMES) / sizeof(char *)},
+    {"getSymbol", runGetSymbol, FIXTURE_LOOKUP_COUNT},
+    {"insertWords", runInsertWords, FIXTURE_WORD_COUNT}};
+
+int main(int argc, char *argv[]) {
+    unsigned long sampleCount; /* The number of timed samples. */
+    char *filter;              /* Only kernels with this in their names. */
+    Index kernel;              /* The index of the current kernel. */
+    int index;                 /* The index of the current argument. */
+
+    sampleCount = DEFAULT_SAMPLE_COUNT;
+    filter = NULL;
+
+    /* Read the options, each with a value right after it. */
+    for (index = ARGS_DIFF; index < argc; index += ARGS_DIFF + ARGS_DIFF) {
+        if (index + ARGS_DIFF < argc &&
+            strcmp(argv[index], "--samples") == EQUAL_STRINGS) {
+            sampleCount = strtoul(argv[index + ARGS_DIFF], NULL, DECIMAL_BASE);
+        } else if (index + ARGS_DIFF < argc &&
+                   strcmp(argv[index], "--filter") == EQUAL_STRINGS) {
+            filter = argv[index + ARGS_DIFF];
+        } else {
+            sampleCount = EMPTY;
+            break;
+        }
+    }
+
+    /* Check for invalid options. */
+    if (sampleCount == EMPTY || sampleCount > MAX_SAMPLE_COUNT) {
+        fprintf(stderr, "Usage: microbenchmark [--samples N] "
+                        "[--filter TEXT]\n");
+        return ERROR;
+    }
+
+    buildFixtures();
+
+    /* Print the header, with the times in nanoseconds per operation. */
+    printf("%-*s%*s%*s%*s%*s%*s%*s\n", KERNEL_COLUMN_WIDTH, "Kernel",
+           NUMBER_COLUMN_WIDTH, "Ops/call", NUMBER_COLUMN_WIDTH, "Calls",
+           NUMBER_COLUMN_WIDTH, "Min ns/op", NUMBER_COLUMN_WIDTH, "Median",
+           NUMBER_COLUMN_WIDTH, "Mean", NUMBER_COLUMN_WIDTH, "Max");
+
+    /* Measure each kernel that passes the filter. */
+    for (kernel = INITIAL_VALUE; kernel < sizeof(KERNELS) / sizeof(Kernel);
+         kernel++) {
+        if (filter == NULL || strstr(KERNELS[kernel].name, filter) != NULL) {
+            measureKernel(&KERNELS[kernel], (int)sampleCount);
+        }
+    }
+
+    /* Free the fixtures. */
+    freeArena(getFileArena());
+    return SUCCESS;
+}
+
+void buildFixtures() {
+    char name[FIXTURE_NAME_SIZE]; /* The current generated name. */
+    unsigned int index;           /* The index of the current fixture. */
+
+    /* Build the found labels and the symbol table that points to them. */
+    foundLabels = NULL;
+    initSymbolTable(&symbols);
+    for (index = INITIAL_VALUE; index < FIXTURE_LABEL_COUNT; index++) {
+        sprintf(name, "LABEL%u", index);
+        addFoundLabel(&foundLabels, copyStringForFile(name));
+        setAddress(foundLabels, (Address)(STARTING_MEMORY_ADDRESS + index));
+        addSymbol(&symbols, foundLabels->name)->definition = foundLabels;
+    }
+
+    /* Search for labels that are spread over the whole table. */
+    for (index = INITIAL_VALUE; index < FIXTURE_LOOKUP_COUNT; index++) {
+        sprintf(name, "LABEL%u", index * LOOKUP_STRIDE % FIXTURE_LABEL_COUNT);
+        lookupNames[index] = copyStringForFile(name);
+    }
+
+    /* Build the macro table, with a short body for each macro. */
+    initMacroTable(&macros);
+    for (index = INITIAL_VALUE; index < FIXTURE_MACRO_COUNT; index++) {
+        sprintf(name, "m%u", index);
+        addMacro(&macros, copyStringForFile(name));
+        addMacroContent(macros.latest, "inc r1\n");
+        addMacroContent(macros.latest, "mov r1, r2\n");
+    }
+
+    /* Fill the word image with words of varying digits. */
+    initWordImage(&image);
+    for (index = INITIAL_VALUE; index < FIXTURE_WORD_COUNT; index++) {
+        *addWord(&image) = (Word)((index * WORD_STRIDE) & MEMORY_CELL_MASK);
+    }
+    initTextBuffer(&output);
+}
+
+void measureKernel(Kernel *kernel, int sampleCount) {
+    double samples[MAX_SAMPLE_COUNT]; /* The ns/op of each sample. */
+    double startTime;                 /* The time the warm-up started. */
+    double total;                     /* The sum of the samples. */
+    unsigned long calls;              /* The number of calls in a sample. */
+    int sample;                       /* The index of the current sample. */
+
+    /* Warm the caches and the branch predictors up. */
+    startTime = getMonotonicTime();
+    while (getMonotonicTime() - startTime < WARMUP_TIME) {
+        timeKernel(kernel, SINGLE_ENTRY);
+    }
+
+    /* Double the calls until a sample is long enough for the clock. */
+    calls = SINGLE_ENTRY;
+    while (timeKernel(kernel, calls) < MIN_SAMPLE_TIME) {
+        calls *= 2;
+    }
+
+    /* Time the samples, in nanoseconds per operation. */
+    total = EMPTY;
+    for (sample = INITIAL_VALUE; sample < sampleCount; sample++) {
+        samples[sample] = timeKernel(kernel, calls) * NANOSECONDS_PER_SECOND /
+                          ((double)calls * kernel->operations);
+        total += samples[sample];
+    }
+    qsort(samples, (size_t)sampleCount, sizeof(double), compareSamples);
+
+    /* Print the minimum, the median, the mean and the maximum. */
+    printf("%-*s%*lu%*lu%*.*f%*.*f%*.*f%*.*f\n", KERNEL_COLUMN_WIDTH,
+           kernel->name, NUMBER_COLUMN_WIDTH, kernel->operations,
+           NUMBER_COLUMN_WIDTH, calls, NUMBER_COLUMN_WIDTH,
+           NANOSECOND_PRECISION, samples[INITIAL_VALUE], NUMBER_COLUMN_WIDTH,
+           NANOSECOND_PRECISION, samples[sampleCount / MIDDLE_DIVISOR],
+           NUMBER_COLUMN_WIDTH, NANOSECOND_PRECISION, total / sampleCount,
+           NUMBER_COLUMN_WIDTH, NANOSECOND_PRECISION,
+           samples[sampleCount - LAST_INDEX_DIFF]);
+}
+
+double timeKernel(Kernel *kernel, unsigned long calls) {
+    /* The checksums of all the calls, which the compiler must keep. */
+    static volatile unsigned long sink;
+
+    double startTime; /* The time the calls started. */
+
+    startTime = getMonotonicTime();
+    while (calls > EMPTY) {
+        sink += kernel->run();
+        calls--;
+    }
+
+    return getMonotonicTime() - startTime;
+}
+
+int compareSamples(const void *first, const void *second) {
+    double firstValue;  /* The first sample. */
+    double secondValue; /* The second sample. */
+
+    firstValue = *(const double *)first;
+    secondValue = *(const double *)second;
+
+    /* Avoid subtracting, which could round a small difference to 0. */
+    if (firstValue < secondValue) {
+        return -1;
+    }
+    return firstValue > secondValue;
+}
+
+unsigned long runSkipWhitespace() {
+    unsigned long checksum; /* The checksum of the results. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(SPACED) / sizeof(char *);
+         index++) {
+        checksum += (unsigned long)(skipWhitespace(SPACED[index]) -
+                                    SPACED[index]);
+    }
+
+    return checksum;
+}
+
+unsigned long runSkipCharacters() {
+    unsigned long checksum; /* The checksum of the results. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(WORDS) / sizeof(char *);
+         index++) {
+        checksum += (unsigned long)(skipCharacters(WORDS[index]) -
+                                    WORDS[index]);
+    }
+
+    return checksum;
+}
+
+unsigned long runGetTokenSlice() {
+    unsigned long checksum; /* The checksum of the results. */
+    TokenSlice token;       /* The current token. */
+    char *position;         /* The position of the next token. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(LINES) / sizeof(char *);
+         index++) {
+        /* Get every token of the line, skipping the whitespace between. */
+        position = skipWhitespace(LINES[index]);
+        while (*position != '\0') {
+            token = getTokenSlice(position);
+            checksum += token.length;
+            position = skipWhitespace(token.start + token.length);
+        }
+    }
+
+    return checksum;
+}
+
+unsigned long runLexLine() {
+    unsigned long checksum; /* The checksum of the results. */
+    TokenLine tokens;       /* The tokens of the current line. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(LINES) / sizeof(char *);
+         index++) {
+        lexLine(LINES[index], &tokens);
+        checksum += tokens.count;
+    }
+
+    return checksum;
+}
+
+unsigned long runGetKeywordIndex() {
+    unsigned long checksum; /* The checksum of the results. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE;
+         index < sizeof(KEYWORD_NAMES) / sizeof(char *); index++) {
+        checksum += getKeywordIndex(KEYWORD_NAMES[index]);
+    }
+
+    return checksum;
+}
+
+unsigned long runGetOperandType() {
+    unsigned long checksum; /* The checksum of the results. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(OPERANDS) / sizeof(char *);
+         index++) {
+        checksum += getOperandType(OPERANDS[index]);
+    }
+
+    return checksum;
+}
+
+unsigned long runEncodeFirstWord() {
+    unsigned long checksum; /* The checksum of the results. */
+    Word word;              /* The encoded word. */
+    Index operation;        /* The index of the current operation. */
+    Index pair;             /* The index of the current pair of types. */
+
+    checksum = EMPTY;
+    for (operation = INITIAL_VALUE; operation < OPERATION_COUNT; operation++) {
+        for (pair = INITIAL_VALUE;
+             pair < sizeof(OPERAND_PAIRS) / sizeof(OPERAND_PAIRS[0]); pair++) {
+            encodeFirstWord(&word, operation, OPERAND_PAIRS[pair][0],
+                            OPERAND_PAIRS[pair][1]);
+            checksum += word;
+        }
+    }
+
+    return checksum;
+}
+
+unsigned long runEncodeImmediate() {
+    unsigned long checksum; /* The checksum of the results. */
+    Word word;              /* The encoded word. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(IMMEDIATES) / sizeof(short);
+         index++) {
+        word = EMPTY;
+        encodeImmediate(&word, IMMEDIATES[index]);
+        checksum += word;
+    }
+
+    return checksum;
+}
+
+unsigned long runEncodeRegister() {
+    unsigned long checksum; /* The checksum of the results. */
+    Word word;              /* The encoded word. */
+    unsigned char number;   /* The number of the current register. */
+
+    checksum = EMPTY;
+    for (number = INITIAL_VALUE; number < REGISTER_COUNT; number++) {
+        /* Encode the register as a source, then as a destination. */
+        word = EMPTY;
+        encodeRegister(&word, number, TRUE);
+        checksum += word;
+        word = EMPTY;
+        encodeRegister(&word, number, FALSE);
+        checksum += word;
+    }
+
+    return checksum;
+}
+
+unsigned long runGetMacroContent() {
+    unsigned long checksum; /* The checksum of the results. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < sizeof(MACRO_NAMES) / sizeof(char *);
+         index++) {
+        checksum += getMacroContent(&macros, MACRO_NAMES[index]) != NULL;
+    }
+
+    return checksum;
+}
+
+unsigned long runGetSymbol() {
+    unsigned long checksum; /* The checksum of the results. */
+    Index index;            /* The index of the current input. */
+
+    checksum = EMPTY;
+    for (index = INITIAL_VALUE; index < FIXTURE_LOOKUP_COUNT; index++) {
+        checksum +=
+            getSymbol(&symbols, lookupNames[index])->definition->address;
+    }
+
+    return checksum;
+}
+
+unsigned long runInsertWords() {
+    /* Reuse the output's buffer, so that the arena does not grow. */
+    output.length = EMPTY;
+    insertWords(&output, &image, STARTING_MEMORY_ADDRESS);
+
+    return output.length;
+}
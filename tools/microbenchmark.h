@@ -0,0 +1,206 @@
+/*
+ * microbenchmark.h
+ *
+ * Contains the constants, typedefs and function prototypes for the functions in
+ * microbenchmark.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef MICROBENCHMARK_H
+#define MICROBENCHMARK_H
+
+#include "../globals.h" /* Constants and typedefs. */
+
+/* --- Measurement. --- */
+
+/* The default number of timed samples of each kernel. */
+#define DEFAULT_SAMPLE_COUNT 20
+/* The maximum number of timed samples of each kernel. */
+#define MAX_SAMPLE_COUNT 1000
+/* The time each sample should take at least, in seconds (the calls of each
+ * sample are doubled until it does, which also warms the kernel up). */
+#define MIN_SAMPLE_TIME 0.002
+/* The time spent warming each kernel up before it is timed, in seconds. */
+#define WARMUP_TIME 0.05
+/* The width of the name column. */
+#define KERNEL_COLUMN_WIDTH 18
+/* The width of each number column. */
+#define NUMBER_COLUMN_WIDTH 12
+/* The number of digits after the point of each time (in nanoseconds). */
+#define NANOSECOND_PRECISION 2
+/* The number that splits the sorted samples in half, to find the median. */
+#define MIDDLE_DIVISOR 2
+
+/* --- Fixtures. --- */
+
+/* The number of labels in the found label list and the symbol table. */
+#define FIXTURE_LABEL_COUNT 256
+/* The number of labels that are searched for. */
+#define FIXTURE_LOOKUP_COUNT 64
+/* The number of macros in the macro table. */
+#define FIXTURE_MACRO_COUNT 64
+/* The number of words in the inserted image. */
+#define FIXTURE_WORD_COUNT 1000
+/* The number of registers (r0-r7). */
+#define REGISTER_COUNT 8
+/* The number of ways a register is encoded (as a source or a destination). */
+#define REGISTER_ROLES 2
+/* The size of the buffer of a generated name. */
+#define FIXTURE_NAME_SIZE 16
+/* The number of the label that every lookup's index is multiplied by, so that
+ * the lookups are spread over the whole list (it is odd, so that they are all
+ * different). */
+#define LOOKUP_STRIDE 37
+/* The number that the words of the inserted image are multiplied by, so that
+ * their digits vary. */
+#define WORD_STRIDE 2654435761UL
+
+/* A kernel to measure. */
+typedef struct {
+    /* The name of the kernel (the function it measures). */
+    char *name;
+    /* Runs the kernel once over all of its inputs, and returns a checksum of
+     * the results, so that the compiler cannot drop the work. */
+    unsigned long (*run)();
+    /* The number of operations in a single run (the number of inputs). */
+    unsigned long operations;
+} Kernel;
+
+/**
+ * Builds the fixtures, then measures each kernel (or only the kernels whose
+ * names contain the given filter) and prints a table of nanoseconds per
+ * operation to stdout.
+ *
+ * @param argc The number of command line arguments.
+ * @param argv The command line arguments.
+ * @return 0 on success, 1 on invalid arguments.
+ */
+int main(int argc, char *argv[]);
+
+/**
+ * Builds the label list, the symbol table, the macro table and the word image
+ * that the lookup and formatting kernels use.
+ * Everything comes from the main thread's arena, which is freed at the end.
+ */
+void buildFixtures();
+
+/**
+ * Measures the given kernel: warms it up, finds the number of calls that makes
+ * a sample long enough, then times the given number of samples and prints the
+ * minimum, median, mean and maximum nanoseconds per operation.
+ *
+ * Assumes that the given sample count is between 1 and MAX_SAMPLE_COUNT.
+ *
+ * @param kernel The kernel to measure.
+ * @param sampleCount The number of timed samples.
+ */
+void measureKernel(Kernel *kernel, int sampleCount);
+
+/**
+ * Calls the given kernel the given number of times.
+ *
+ * @param kernel The kernel to call.
+ * @param calls The number of calls.
+ * @return The time all the calls took, in seconds.
+ */
+double timeKernel(Kernel *kernel, unsigned long calls);
+
+/**
+ * Compares two doubles, for sorting them in an increasing order.
+ *
+ * @param first A pointer to the first double.
+ * @param second A pointer to the second double.
+ * @return A negative number, zero or a positive number if the first double is
+ * smaller, equal or larger.
+ */
+int compareSamples(const void *first, const void *second);
+
+/**
+ * Skips the whitespace at the start of each sample string.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runSkipWhitespace();
+
+/**
+ * Skips the characters of the first word of each sample string.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runSkipCharacters();
+
+/**
+ * Gets every token of each sample line, one after another.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runGetTokenSlice();
+
+/**
+ * Splits each sample line into tokens.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runLexLine();
+
+/**
+ * Finds the index of each sample keyword (some are not keywords).
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runGetKeywordIndex();
+
+/**
+ * Finds the addressing mode of each sample operand.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runGetOperandType();
+
+/**
+ * Encodes the first word of every operation with each pair of operand types.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runEncodeFirstWord();
+
+/**
+ * Encodes each sample immediate value.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runEncodeImmediate();
+
+/**
+ * Encodes every register, both as a source and as a destination.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runEncodeRegister();
+
+/**
+ * Searches for the content of each sample macro name (some are missing).
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runGetMacroContent();
+
+/**
+ * Searches the symbol table for each sample label name.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runGetSymbol();
+
+/**
+ * Formats the whole word image as the lines of an .ob file.
+ *
+ * @return A checksum of the results.
+ */
+unsigned long runInsertWords();
+
+#endif
@@ -0,0 +1,687 @@
+/*
+ * workloadGenerator.c
+ *
+ * A tool that generates synthetic .as files for scaling benchmarks.
+ * The shape of the file is controlled by knobs: the number of statements, the
+ * macros and their size, the density of the labels, the extern and entry
+ * labels, the mix of data directives and the distribution of the addressing
+ * modes. Comment lines and invalid lines can optionally be mixed in, and a line
+ * that is too long can be written on its own.
+ * The generated program always fits in memory, and the same knobs and seed
+ * always generate the same file, so that benchmark numbers are comparable
+ * across builds.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "workloadGenerator.h"
+
+#include <ctype.h>  /* isdigit. */
+#include <stdio.h>  /* FILE, fopen, fclose, fprintf, sprintf. */
+#include <stdlib.h> /* malloc, free. */
+#include <string.h> /* strcmp, strcpy, strlen. */
+
+#include "../globals.h" /* Constants and typedefs. */
+#include "../instructionInformation.h" /* Checking which addressing modes each operation accepts. */
+
+int main(int argc, char *argv[]) {
+    GeneratorOptions options; /* The knobs given as command line arguments. */
+    Generator generator;      /* The state of the generator. */
+
+    /* Read the knobs. */
+    if (!readKnobs(argv + ARGS_DIFF, argc - ARGS_DIFF, &options)) {
+        printUsage();
+        return ERROR;
+    }
+
+    /* Open the file to write to. */
+    generator.output = options.outputName == NULL
+                           ? stdout
+                           : fopen(options.outputName, "w");
+    if (generator.output == NULL) {
+        fprintf(stderr, "Failed to open %s.\n", options.outputName);
+        return ERROR;
+    }
+
+    /* Allocate the word counts of the macros (nothing if there are none). */
+    generator.macroWords = NULL;
+    if (options.macroCount != EMPTY) {
+        generator.macroWords =
+            malloc(sizeof(unsigned long) * options.macroCount);
+        if (generator.macroWords == NULL) {
+            fprintf(stderr, "Failed to allocate enough memory.\n");
+            return ERROR;
+        }
+    }
+
+    /* Start the random numbers from the seed (which must not be 0). */
+    generator.options = &options;
+    generator.random =
+        (options.seed & RANDOM_MASK) == EMPTY ? NONZERO_SEED
+                                              : options.seed & RANDOM_MASK;
+    generator.wordCount = EMPTY;
+    generator.definedCount = EMPTY;
+    generator.dueCount = EMPTY;
+    generator.labelCredit = EMPTY;
+    generator.commentCredit = EMPTY;
+    generator.referencedCount = EMPTY;
+
+    /* Write the whole file. */
+    generateFile(&generator);
+
+    /* Close the file and free the word counts. */
+    if (generator.output != stdout) {
+        fclose(generator.output);
+    }
+    free(generator.macroWords);
+
+    return SUCCESS;
+}
+
+Boolean readKnobs(char *arguments[], int argumentCount,
+                  GeneratorOptions *options) {
+    unsigned long *knob; /* The current knob that takes a whole number. */
+    Index mode;          /* The index of the current addressing mode. */
+    int index;           /* The index of the current argument. */
+
+    /* Start with the default knobs. */
+    options->seed = DEFAULT_SEED;
+    options->lineCount = DEFAULT_LINE_COUNT;
+    options->macroCount = DEFAULT_MACRO_COUNT;
+    options->macroSize = DEFAULT_MACRO_SIZE;
+    options->callPercent = DEFAULT_CALL_PERCENT;
+    options->labelPercent = DEFAULT_LABEL_PERCENT;
+    options->externCount = DEFAULT_EXTERN_COUNT;
+    options->entryPercent = DEFAULT_ENTRY_PERCENT;
+    options->dataPercent = DEFAULT_DATA_PERCENT;
+    options->stringPercent = DEFAULT_STRING_PERCENT;
+    options->invalidPercent = DEFAULT_INVALID_PERCENT;
+    options->tooLongLine = DEFAULT_TOO_LONG_LINE;
+    options->commentPercent = DEFAULT_COMMENT_PERCENT;
+    options->outputName = NULL;
+    for (mode = INITIAL_VALUE; mode < MODE_COUNT; mode++) {
+        options->modeWeights[mode] = DEFAULT_MODE_WEIGHT;
+    }
+
+    /* Every knob comes with a value right after it. */
+    for (index = INITIAL_VALUE; index < argumentCount;
+         index += ARGS_DIFF + ARGS_DIFF) {
+        if (index + ARGS_DIFF == argumentCount) {
+            return FALSE;
+        }
+
+        /* Check for the name of the output file. */
+        if (strcmp(arguments[index], "-o") == EQUAL_STRINGS) {
+            options->outputName = arguments[index + ARGS_DIFF];
+            continue;
+        }
+
+        /* Check for the weights of the addressing modes. */
+        if (strcmp(arguments[index], "--modes") == EQUAL_STRINGS) {
+            if (!readModeWeights(arguments[index + ARGS_DIFF],
+                                 options->modeWeights)) {
+                return FALSE;
+            }
+            continue;
+        }
+
+        /* Check if the knob is unknown or its value is invalid. */
+        knob = findKnob(options, arguments[index]);
+        if (knob == NULL || !convertKnob(arguments[index + ARGS_DIFF], knob)) {
+            return FALSE;
+        }
+    }
+
+    /* The percents cannot be more than a whole. */
+    return options->callPercent <= WHOLE_PERCENT &&
+           options->labelPercent <= WHOLE_PERCENT &&
+           options->entryPercent <= WHOLE_PERCENT &&
+           options->dataPercent <= WHOLE_PERCENT &&
+           options->stringPercent <= WHOLE_PERCENT &&
+           options->invalidPercent <= WHOLE_PERCENT &&
+           options->commentPercent <= WHOLE_PERCENT &&
+           options->tooLongLine <= SINGLE_ENTRY;
+}
+
+unsigned long *findKnob(GeneratorOptions *options, char name[]) {
+    /* Compare the name with the name of each knob. */
+    if (strcmp(name, "--seed") == EQUAL_STRINGS) {
+        return &options->seed;
+    }
+    if (strcmp(name, "--lines") == EQUAL_STRINGS) {
+        return &options->lineCount;
+    }
+    if (strcmp(name, "--macros") == EQUAL_STRINGS) {
+        return &options->macroCount;
+    }
+    if (strcmp(name, "--macro-size") == EQUAL_STRINGS) {
+        return &options->macroSize;
+    }
+    if (strcmp(name, "--call-percent") == EQUAL_STRINGS) {
+        return &options->callPercent;
+    }
+    if (strcmp(name, "--label-percent") == EQUAL_STRINGS) {
+        return &options->labelPercent;
+    }
+    if (strcmp(name, "--externs") == EQUAL_STRINGS) {
+        return &options->externCount;
+    }
+    if (strcmp(name, "--entry-percent") == EQUAL_STRINGS) {
+        return &options->entryPercent;
+    }
+    if (strcmp(name, "--data-percent") == EQUAL_STRINGS) {
+        return &options->dataPercent;
+    }
+    if (strcmp(name, "--string-percent") == EQUAL_STRINGS) {
+        return &options->stringPercent;
+    }
+    if (strcmp(name, "--invalid-percent") == EQUAL_STRINGS) {
+        return &options->invalidPercent;
+    }
+    if (strcmp(name, "--too-long-line") == EQUAL_STRINGS) {
+        return &options->tooLongLine;
+    }
+    if (strcmp(name, "--comment-percent") == EQUAL_STRINGS) {
+        return &options->commentPercent;
+    }
+
+    /* There is no such knob. */
+    return NULL;
+}
+
+Boolean readModeWeights(char value[], unsigned long weights[]) {
+    char weight[LINE_BUFFER_SIZE]; /* The current weight. */
+    unsigned long total;           /* The sum of the weights so far. */
+    Index mode;                    /* The index of the current mode. */
+    Length length;                 /* The length of the current weight. */
+
+    total = EMPTY;
+
+    /* Read the weights one by one. */
+    for (mode = INITIAL_VALUE; mode < MODE_COUNT; mode++) {
+        /* Copy the weight until the next comma. */
+        for (length = INITIAL_VALUE;
+             *value != '\0' && *value != ',' &&
+             length < LINE_BUFFER_SIZE - NULL_BYTE;
+             length++) {
+            weight[length] = *value;
+            value++;
+        }
+        weight[length] = '\0';
+
+        /* Convert the weight. */
+        if (!convertKnob(weight, &weights[mode])) {
+            return FALSE;
+        }
+        total += weights[mode];
+
+        /* Every weight but the last one is followed by a comma. */
+        if (mode < MODE_COUNT - LAST_INDEX_DIFF) {
+            if (*value != ',') {
+                return FALSE;
+            }
+            value++;
+        }
+    }
+
+    /* There must be nothing after the last weight, and not all can be 0. */
+    return *value == '\0' && total != EMPTY;
+}
+
+void printUsage() {
+    /* Print the knobs along with their default values. */
+    fprintf(stderr, "Usage: workloadGenerator [knob value]...\n");
+    fprintf(stderr, "Writes a reproducible .as file to stdout (or to -o).\n");
+    fprintf(stderr, "  --seed N             The seed of the random numbers "
+                    "(%d).\n",
+            DEFAULT_SEED);
+    fprintf(stderr, "  --lines N            The number of statements (%d).\n",
+            DEFAULT_LINE_COUNT);
+    fprintf(stderr, "  --macros N           The number of macros (%d).\n",
+            DEFAULT_MACRO_COUNT);
+    fprintf(stderr, "  --macro-size N       The number of lines in each macro "
+                    "(%d).\n",
+            DEFAULT_MACRO_SIZE);
+    fprintf(stderr, "  --call-percent P     The percent of statements that "
+                    "call a macro (%d).\n",
+            DEFAULT_CALL_PERCENT);
+    fprintf(stderr, "  --label-percent P    The percent of statements that "
+                    "define a label (%d).\n",
+            DEFAULT_LABEL_PERCENT);
+    fprintf(stderr, "  --externs N          The number of extern labels "
+                    "(%d).\n",
+            DEFAULT_EXTERN_COUNT);
+    fprintf(stderr, "  --entry-percent P    The percent of labels declared "
+                    "entry (%d).\n",
+            DEFAULT_ENTRY_PERCENT);
+    fprintf(stderr, "  --data-percent P     The percent of statements that "
+                    "are data (%d).\n",
+            DEFAULT_DATA_PERCENT);
+    fprintf(stderr, "  --string-percent P   The percent of data that is "
+                    ".string (%d).\n",
+            DEFAULT_STRING_PERCENT);
+    fprintf(stderr, "  --modes I,D,X,R      The weights of the immediate, "
+                    "direct, indirect register\n"
+                    "                       and direct register addressing "
+                    "modes (%d each).\n",
+            DEFAULT_MODE_WEIGHT);
+    fprintf(stderr, "  --invalid-percent P  The percent of statements that "
+                    "are invalid (%d).\n",
+            DEFAULT_INVALID_PERCENT);
+    fprintf(stderr, "  --too-long-line B    Whether the middle statement is a "
+                    "line that is too long\n"
+                    "                       (%d).\n",
+            DEFAULT_TOO_LONG_LINE);
+    fprintf(stderr, "  --comment-percent P  The percent of statements that "
+                    "come after a comment\n"
+                    "                       line (%d).\n",
+            DEFAULT_COMMENT_PERCENT);
+    fprintf(stderr, "  -o FILE              The file to write to (stdout).\n");
+}
+
+void generateFile(Generator *generator) {
+    GeneratorOptions *options; /* The knobs of the generator. */
+    unsigned long index;       /* The index of the current statement. */
+
+    options = generator->options;
+
+    /* Note the seed, so that the file can be generated again. */
+    fprintf(generator->output, "; Generated by workloadGenerator (seed %lu).\n",
+            options->seed);
+
+    /* Declare the extern labels. */
+    for (index = INITIAL_VALUE; index < options->externCount; index++) {
+        fprintf(generator->output, ".extern X%lu\n", index);
+    }
+
+    /* Define the macros before they are called. */
+    generateMacros(generator);
+
+    /* Write the statements until the memory is full. */
+    for (index = INITIAL_VALUE; index < options->lineCount; index++) {
+        if (!generateStatement(generator, index)) {
+            fprintf(stderr,
+                    "Stopped after %lu statements, as the memory is full.\n",
+                    index);
+            break;
+        }
+    }
+
+    /* Define the used labels that are left (room has been kept for them). */
+    while (generator->definedCount < generator->referencedCount) {
+        fprintf(generator->output, "L%lu: stop\n", generator->definedCount);
+        generator->definedCount++;
+        generator->wordCount++;
+    }
+
+    /* Declare some of the labels as entry. */
+    for (index = INITIAL_VALUE; index < generator->definedCount; index++) {
+        if (randomChance(generator, options->entryPercent)) {
+            fprintf(generator->output, ".entry L%lu\n", index);
+        }
+    }
+}
+
+void generateMacros(Generator *generator) {
+    char line[LINE_BUFFER_SIZE]; /* The current line of the macro. */
+    unsigned long macro;         /* The index of the current macro. */
+    unsigned long index;         /* The index of the current line. */
+
+    /* Write each macro with instructions only (labels would be defined twice
+     * if the macro is called twice). */
+    for (macro = INITIAL_VALUE; macro < generator->options->macroCount;
+         macro++) {
+        fprintf(generator->output, "macr m%lu\n", macro);
+        generator->macroWords[macro] = EMPTY;
+
+        for (index = INITIAL_VALUE; index < generator->options->macroSize;
+             index++) {
+            generator->macroWords[macro] +=
+                generateInstruction(generator, line);
+            fprintf(generator->output, "  %s\n", line);
+        }
+
+        fprintf(generator->output, "endmacr\n");
+    }
+}
+
+Boolean generateStatement(Generator *generator, unsigned long index) {
+    GeneratorOptions *options;   /* The knobs of the generator. */
+    char line[LINE_BUFFER_SIZE]; /* The statement, without a label. */
+    unsigned long words;         /* The number of words of the statement. */
+    unsigned long reserved;      /* The words kept for the labels left. */
+    unsigned long referenced;    /* The used labels before the statement. */
+    Boolean shouldDefine;        /* Whether to define a label before it. */
+    unsigned long macro;         /* The index of the called macro. */
+
+    options = generator->options;
+    referenced = generator->referencedCount;
+
+    /* Spread the labels evenly over the statements. */
+    generator->labelCredit += options->labelPercent;
+    while (generator->labelCredit >= WHOLE_PERCENT) {
+        generator->labelCredit -= WHOLE_PERCENT;
+        generator->dueCount++;
+    }
+    shouldDefine = generator->definedCount < generator->dueCount;
+
+    /* Choose the kind of the statement. */
+    if (options->tooLongLine && index == options->lineCount / 2) {
+        /* The line stops the macro expansion, so it is written only here. */
+        generateTooLong(line);
+        words = EMPTY;
+        shouldDefine = FALSE;
+    } else if (randomChance(generator, options->invalidPercent)) {
+        /* Invalid lines are not encoded, and do not define labels. */
+        generateInvalid(generator, line);
+        words = EMPTY;
+        shouldDefine = FALSE;
+    } else if (options->macroCount != EMPTY &&
+               randomChance(generator, options->callPercent)) {
+        /* Macro calls cannot define labels. */
+        macro = randomBelow(generator, options->macroCount);
+        sprintf(line, "m%lu", macro);
+        words = generator->macroWords[macro];
+        shouldDefine = FALSE;
+    } else if (randomChance(generator, options->dataPercent)) {
+        words = generateData(generator, line);
+    } else {
+        words = generateInstruction(generator, line);
+    }
+
+    /* Keep a word for each used label that will not have been defined. */
+    reserved = generator->definedCount + (shouldDefine ? SINGLE_ENTRY : EMPTY);
+    reserved = generator->referencedCount > reserved
+                   ? generator->referencedCount - reserved
+                   : EMPTY;
+
+    /* Check if the statement does not fit in memory. */
+    if (generator->wordCount + words + reserved > WORD_LIMIT) {
+        /* The labels of the statement will not be used after all. */
+        generator->referencedCount = referenced;
+        return FALSE;
+    }
+    generator->wordCount += words;
+
+    /* Spread the comment lines evenly over the statements (without drawing
+     * random numbers, so that the statements stay the same). */
+    generator->commentCredit += options->commentPercent;
+    if (generator->commentCredit >= WHOLE_PERCENT) {
+        generator->commentCredit -= WHOLE_PERCENT;
+        fprintf(generator->output, "%s\n", COMMENT_LINE);
+    }
+
+    /* Write the statement, with a label if needed. */
+    if (shouldDefine) {
+        fprintf(generator->output, "L%lu: %s\n", generator->definedCount,
+                line);
+        generator->definedCount++;
+    } else {
+        fprintf(generator->output, "%s\n", line);
+    }
+
+    return TRUE;
+}
+
+unsigned long generateInstruction(Generator *generator, char line[]) {
+    /* The names of the operations, by their indices. */
+    static char *OPERATIONS[OPERATION_COUNT] = {
+        "mov", "cmp", "add", "sub", "lea", "clr", "not", "inc",
+        "dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop"};
+
+    char source[LINE_BUFFER_SIZE];      /* The source operand. */
+    char destination[LINE_BUFFER_SIZE]; /* The destination operand. */
+    OperandType sourceType;             /* The mode of the source operand. */
+    OperandType destinationType; /* The mode of the destination operand. */
+    OperandCount operandCount;   /* The number of operands. */
+    Index operation;             /* The index of the operation. */
+
+    /* Choose an operation (lea needs a label, so skip it if there are none). */
+    do {
+        operation = (Index)randomBelow(generator, OPERATION_COUNT);
+    } while (operation == LEA && countLabelNames(generator) == EMPTY);
+
+    sourceType = ABSENT_OPERAND;
+    destinationType = ABSENT_OPERAND;
+    operandCount = getOperandCount(operation);
+
+    /* Write the operation with its operands. */
+    switch (operandCount) {
+        case TWO_OPERANDS:
+            sourceType = generateOperand(generator, operation, TRUE, source);
+            destinationType =
+                generateOperand(generator, operation, FALSE, destination);
+            sprintf(line, "%s %s, %s", OPERATIONS[operation], source,
+                    destination);
+            break;
+        case ONE_OPERAND:
+            destinationType =
+                generateOperand(generator, operation, FALSE, destination);
+            sprintf(line, "%s %s", OPERATIONS[operation], destination);
+            break;
+        default:
+            strcpy(line, OPERATIONS[operation]);
+            break;
+    }
+
+    return countInstructionWords(operandCount, sourceType, destinationType);
+}
+
+OperandType generateOperand(Generator *generator, Index operation,
+                            Boolean isSource, char operand[]) {
+    unsigned long weights[MODE_COUNT]; /* The weight of each allowed mode. */
+    Boolean isAllowed[MODE_COUNT];     /* Whether each mode is allowed. */
+    unsigned long total;               /* The sum of the weights. */
+    unsigned long pick;                /* The picked part of the total. */
+    Index mode;                        /* The index of the current mode. */
+
+    /* Find the modes that the operation accepts (direct needs a label). */
+    total = EMPTY;
+    for (mode = INITIAL_VALUE; mode < MODE_COUNT; mode++) {
+        isAllowed[mode] =
+            doesOperationAcceptOperand(operation, (OperandType)mode,
+                                       isSource) &&
+            (mode != DIRECT || countLabelNames(generator) != EMPTY);
+        weights[mode] =
+            isAllowed[mode] ? generator->options->modeWeights[mode] : EMPTY;
+        total += weights[mode];
+    }
+
+    /* If all the allowed modes weigh 0, give them the same weight. */
+    if (total == EMPTY) {
+        for (mode = INITIAL_VALUE; mode < MODE_COUNT; mode++) {
+            weights[mode] = isAllowed[mode] ? SINGLE_ENTRY : EMPTY;
+            total += weights[mode];
+        }
+    }
+
+    /* Pick a mode by its weight. */
+    pick = randomBelow(generator, total);
+    for (mode = INITIAL_VALUE; pick >= weights[mode]; mode++) {
+        pick -= weights[mode];
+    }
+
+    /* Write an operand of the picked mode. */
+    switch (mode) {
+        case IMMEDIATE:
+            sprintf(operand, "#%ld",
+                    (long)randomBelow(generator,
+                                      MAX_IMMEDIATE - MIN_IMMEDIATE + 1) +
+                        MIN_IMMEDIATE);
+            break;
+        case DIRECT:
+            generateLabelName(generator, operand);
+            break;
+        case INDIRECT_REGISTER:
+            sprintf(operand, "*r%lu", randomBelow(generator, REGISTER_COUNT));
+            break;
+        default:
+            sprintf(operand, "r%lu", randomBelow(generator, REGISTER_COUNT));
+            break;
+    }
+
+    return (OperandType)mode;
+}
+
+void generateLabelName(Generator *generator, char name[]) {
+    unsigned long index; /* The index of the label among all the labels. */
+
+    /* The extern labels come before the labels that will be defined. */
+    index = randomBelow(generator, countLabelNames(generator));
+    if (index < generator->options->externCount) {
+        sprintf(name, "X%lu", index);
+        return;
+    }
+
+    /* Remember that the label must be defined. */
+    index -= generator->options->externCount;
+    if (index >= generator->referencedCount) {
+        generator->referencedCount = index + SINGLE_ENTRY;
+    }
+    sprintf(name, "L%lu", index);
+}
+
+unsigned long countLabelNames(Generator *generator) {
+    /* There are no labels to use if no statement defines a label. */
+    if (generator->options->labelPercent == EMPTY) {
+        return generator->options->externCount;
+    }
+
+    /* The labels defined so far, and a few that will be defined soon. */
+    return generator->options->externCount + generator->dueCount +
+           LABEL_LOOKAHEAD;
+}
+
+unsigned long generateData(Generator *generator, char line[]) {
+    /* The characters of the generated strings. */
+    static char LETTERS[] = "abcdefghijklmnopqrstuvwxyz";
+
+    unsigned long count; /* The number of characters or numbers. */
+    unsigned long index; /* The index of the current character or number. */
+    Length length;       /* The length of the line so far. */
+
+    /* Check if a .string directive should be written. */
+    if (randomChance(generator, generator->options->stringPercent)) {
+        count = randomBelow(generator, MAX_STRING_CHARACTERS) + SINGLE_ENTRY;
+        length = sprintf(line, ".string \"");
+        for (index = INITIAL_VALUE; index < count; index++) {
+            line[length] = LETTERS[randomBelow(generator, strlen(LETTERS))];
+            length++;
+        }
+        strcpy(&line[length], "\"");
+
+        /* Every character takes a word, and so does the null character. */
+        return count + NULL_BYTE;
+    }
+
+    /* Write a .data directive. */
+    count = randomBelow(generator, MAX_DATA_NUMBERS) + SINGLE_ENTRY;
+    length = sprintf(line, ".data");
+    for (index = INITIAL_VALUE; index < count; index++) {
+        length += sprintf(&line[length],
+                          index == INITIAL_VALUE ? " %ld" : ", %ld",
+                          (long)randomBelow(generator,
+                                            MAX_NUMBER - MIN_NUMBER + 1) +
+                              MIN_NUMBER);
+    }
+
+    /* Every number takes a word. */
+    return count;
+}
+
+void generateInvalid(Generator *generator, char line[]) {
+    /* Write one of the kinds of invalid lines. */
+    switch ((InvalidKind)randomBelow(generator, INVALID_KIND_COUNT)) {
+        case UNKNOWN_OPERATION:
+            strcpy(line, "xyz r1, r2");
+            break;
+        case IMMEDIATE_OUT_OF_RANGE:
+            sprintf(line, "prn #%d", OUT_OF_RANGE_NUMBER);
+            break;
+        case MISSING_COMMA:
+            strcpy(line, "mov r1 r2");
+            break;
+        case INVALID_DESTINATION:
+            strcpy(line, "mov r1, #5");
+            break;
+        default:
+            /* Consecutive commas. */
+            strcpy(line, ".data 1,,2");
+            break;
+    }
+}
+
+void generateTooLong(char line[]) {
+    Length length; /* The length of the line so far. */
+
+    /* Fill a string until the line is longer than the maximum length. */
+    length = sprintf(line, ".string \"");
+    while (length < TOO_LONG_LENGTH) {
+        line[length] = 'a';
+        length++;
+    }
+    strcpy(&line[length], "\"");
+}
+
+unsigned long countInstructionWords(OperandCount operandCount,
+                                    OperandType source,
+                                    OperandType destination) {
+    /* Check if both operands are registers, which share a single word. */
+    if (operandCount == TWO_OPERANDS &&
+        (source == DIRECT_REGISTER || source == INDIRECT_REGISTER) &&
+        (destination == DIRECT_REGISTER || destination == INDIRECT_REGISTER)) {
+        return SHARED_REGISTER_WORDS;
+    }
+
+    /* The first word, and another word for each operand. */
+    return SINGLE_ENTRY + operandCount;
+}
+
+unsigned long nextRandom(Generator *generator) {
+    unsigned long state; /* The state of the random number generator. */
+
+    /* Shift the state 3 times (xorshift), keeping 32 bits. */
+    state = generator->random;
+    state ^= (state << FIRST_SHIFT) & RANDOM_MASK;
+    state ^= state >> SECOND_SHIFT;
+    state ^= (state << THIRD_SHIFT) & RANDOM_MASK;
+    generator->random = state;
+
+    return state;
+}
+
+unsigned long randomBelow(Generator *generator, unsigned long bound) {
+    /* The remainder is close enough to uniform for small bounds. */
+    return nextRandom(generator) % bound;
+}
+
+Boolean randomChance(Generator *generator, unsigned long percent) {
+    /* Always draw a number, so that the sequence does not depend on knobs that
+     * are 0. */
+    return randomBelow(generator, WHOLE_PERCENT) < percent;
+}
+
+Boolean convertKnob(char value[], unsigned long *number) {
+    /* Check for an empty value. */
+    if (*value == '\0') {
+        return FALSE;
+    }
+
+    /* Convert the digits one by one. */
+    *number = INITIAL_VALUE;
+    while (*value != '\0') {
+        /* Check for a character that is not a digit. */
+        if (!isdigit(*value)) {
+            return FALSE;
+        }
+
+        /* Add the digit to the number. */
+        *number = *number * DECIMAL_BASE + (unsigned long)(*value - '0');
+        value++;
+    }
+
+    return TRUE;
+}
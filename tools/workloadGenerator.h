@@ -0,0 +1,404 @@
+/*
+ * workloadGenerator.h
+ *
+ * Contains the constants, typedefs and function prototypes for the functions in
+ * workloadGenerator.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef WORKLOAD_GENERATOR_H
+#define WORKLOAD_GENERATOR_H
+
+#include <stdio.h> /* FILE. */
+
+#include "../globals.h" /* The limits of the language and the memory. */
+
+/* --- Default knobs. --- */
+
+/* The default seed of the generator. */
+#define DEFAULT_SEED 1
+/* The default number of statements (instructions, data and macro calls). */
+#define DEFAULT_LINE_COUNT 1000
+/* The default number of macros. */
+#define DEFAULT_MACRO_COUNT 0
+/* The default number of lines in each macro. */
+#define DEFAULT_MACRO_SIZE 3
+/* The default percent of statements that call a macro (if there are any). */
+#define DEFAULT_CALL_PERCENT 10
+/* The default percent of statements that define a label. */
+#define DEFAULT_LABEL_PERCENT 30
+/* The default number of extern labels. */
+#define DEFAULT_EXTERN_COUNT 0
+/* The default percent of labels that are declared entry. */
+#define DEFAULT_ENTRY_PERCENT 0
+/* The default percent of statements that are data directives. */
+#define DEFAULT_DATA_PERCENT 20
+/* The default percent of data directives that are .string (not .data). */
+#define DEFAULT_STRING_PERCENT 50
+/* The default weight of each addressing mode (immediate, direct, indirect
+ * register and direct register). */
+#define DEFAULT_MODE_WEIGHT 1
+/* The default percent of statements that are invalid. */
+#define DEFAULT_INVALID_PERCENT 0
+/* By default, no statement is a line that is too long. */
+#define DEFAULT_TOO_LONG_LINE 0
+/* The default percent of statements that come after a comment line. */
+#define DEFAULT_COMMENT_PERCENT 0
+
+/* --- Generation. --- */
+
+/* The number of addressing modes. */
+#define MODE_COUNT 4
+/* The number of different kinds of invalid statements that are mixed in (a
+ * line that is too long is not one of them, as it stops the macro expansion
+ * and hides the errors of every other line). */
+#define INVALID_KIND_COUNT 5
+/* The number of labels that can be used before they are due to be defined. */
+#define LABEL_LOOKAHEAD 16
+/* The number of words of an instruction whose 2 operands are registers. */
+#define SHARED_REGISTER_WORDS 2
+/* The maximum number of numbers in a generated .data directive. */
+#define MAX_DATA_NUMBERS 5
+/* The maximum number of characters in a generated .string directive. */
+#define MAX_STRING_CHARACTERS 20
+/* The number of registers (r0-r7). */
+#define REGISTER_COUNT 8
+/* The number of words the generated program can take in memory. */
+#define WORD_LIMIT (TOTAL_MEMORY_CELLS - STARTING_MEMORY_ADDRESS)
+/* The seed used instead of 0, which the generator cannot start from. */
+#define NONZERO_SEED 2463534242UL
+/* The bits of a 32-bit number. */
+#define RANDOM_MASK 0xFFFFFFFFUL
+/* The shifts of the xorshift generator. */
+#define FIRST_SHIFT 13
+#define SECOND_SHIFT 17
+#define THIRD_SHIFT 5
+/* The number of percents in a whole. */
+#define WHOLE_PERCENT 100
+/* A number that is too large for an immediate value or a .data directive. */
+#define OUT_OF_RANGE_NUMBER 99999
+/* The number of characters in a generated line that is too long. */
+#define TOO_LONG_LENGTH 90
+/* The size of the buffer of a single generated line (or part of one). */
+#define LINE_BUFFER_SIZE 128
+/* The comment line written before a statement (as long as a line can be). */
+#define COMMENT_LINE \
+    "; Explains the statement below, the way a hand-written program would."
+
+/* The kinds of invalid statements that are mixed in. */
+typedef enum {
+    UNKNOWN_OPERATION,
+    IMMEDIATE_OUT_OF_RANGE,
+    MISSING_COMMA,
+    INVALID_DESTINATION,
+    CONSECUTIVE_COMMAS
+} InvalidKind;
+
+/* The knobs of the generator, given as command line arguments. */
+typedef struct {
+    /* The seed, so that the same knobs always generate the same file. */
+    unsigned long seed;
+    /* The number of statements (instructions, data and macro calls). */
+    unsigned long lineCount;
+    /* The number of macros. */
+    unsigned long macroCount;
+    /* The number of lines in each macro. */
+    unsigned long macroSize;
+    /* The percent of statements that call a macro (if there are any). */
+    unsigned long callPercent;
+    /* The percent of statements that define a label. */
+    unsigned long labelPercent;
+    /* The number of extern labels. */
+    unsigned long externCount;
+    /* The percent of labels that are declared entry. */
+    unsigned long entryPercent;
+    /* The percent of statements that are data directives. */
+    unsigned long dataPercent;
+    /* The percent of data directives that are .string (not .data). */
+    unsigned long stringPercent;
+    /* The weight of each addressing mode, in the order of OperandType. */
+    unsigned long modeWeights[MODE_COUNT];
+    /* The percent of statements that are invalid. */
+    unsigned long invalidPercent;
+    /* Whether the middle statement is a line that is too long (0 or 1). */
+    unsigned long tooLongLine;
+    /* The percent of statements that come after a comment line. */
+    unsigned long commentPercent;
+    /* The name of the file to write to (NULL for stdout). */
+    char *outputName;
+} GeneratorOptions;
+
+/* The state of the generator while it writes a file. */
+typedef struct {
+    /* The knobs of the generator. */
+    GeneratorOptions *options;
+    /* The current state of the random number generator (never 0). */
+    unsigned long random;
+    /* The file to write to. */
+    FILE *output;
+    /* The number of words the statements so far take in memory. */
+    unsigned long wordCount;
+    /* The number of labels that must be defined, as they are used. */
+    unsigned long referencedCount;
+    /* The number of labels that have been defined so far. */
+    unsigned long definedCount;
+    /* The number of labels that should have been defined by now. */
+    unsigned long dueCount;
+    /* The percents of a label gathered since the last label was due. */
+    unsigned long labelCredit;
+    /* The percents of a comment gathered since the last comment line. */
+    unsigned long commentCredit;
+    /* The number of words in each macro. */
+    unsigned long *macroWords;
+} Generator;
+
+/**
+ * The main function of the workload generator.
+ * Writes a reproducible .as file, shaped by the knobs given as command line
+ * arguments, to stdout (or to the file given with -o).
+ * The same knobs and seed always generate the same file, on every platform.
+ *
+ * @param argc The number of command line arguments (including the program's
+ * name).
+ * @param argv The command line arguments (including the program's name).
+ * @return The exit status of the program (0 - successful, 1 - failed).
+ */
+int main(int argc, char *argv[]);
+
+/**
+ * Reads the knobs from the given command line arguments into the given options.
+ * Knobs that are not given get their default values.
+ * Returns FALSE if a knob is unknown or is missing a valid value.
+ *
+ * Assumes that the given arguments array contains argumentCount non-NULL and
+ * null-terminated arguments (not including the program's name).
+ * Assumes that the given options pointer is not NULL.
+ *
+ * @param arguments The command line arguments (not including the program's
+ * name).
+ * @param argumentCount The number of command line arguments.
+ * @param options The options struct to fill.
+ * @return TRUE if all the knobs are valid, FALSE otherwise.
+ */
+Boolean readKnobs(char *arguments[], int argumentCount,
+                  GeneratorOptions *options);
+
+/**
+ * Returns the knob with the given name that takes a whole number.
+ * Returns NULL if there is no such knob.
+ *
+ * Assumes that the given options pointer is not NULL.
+ * Assumes that the given name is not NULL and is null-terminated.
+ *
+ * @param options The options that hold the knobs.
+ * @param name The name of the knob (e.g. "--lines").
+ * @return A pointer to the knob, or NULL if there is no such knob.
+ */
+unsigned long *findKnob(GeneratorOptions *options, char name[]);
+
+/**
+ * Reads the given comma-separated weights of the 4 addressing modes.
+ * Returns FALSE if there are not exactly 4 whole numbers, or if they are all 0.
+ *
+ * Assumes that the given value is not NULL and is null-terminated.
+ * Assumes that the given weights array has room for 4 weights.
+ *
+ * @param value The weights, separated by commas.
+ * @param weights The array to fill.
+ * @return TRUE if the weights are valid, FALSE otherwise.
+ */
+Boolean readModeWeights(char value[], unsigned long weights[]);
+
+/**
+ * Prints how to use the generator and its knobs to stderr.
+ */
+void printUsage();
+
+/**
+ * Writes a whole .as file with the given generator: the extern declarations,
+ * the macros, the statements, and finally the entry declarations.
+ * Stops adding statements early if the next one would not fit in memory.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ */
+void generateFile(Generator *generator);
+
+/**
+ * Writes the definition of every macro, and remembers how many words each one
+ * takes in memory.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ */
+void generateMacros(Generator *generator);
+
+/**
+ * Writes a single statement: a macro call, a data directive, an instruction or
+ * an invalid line, optionally defining a label first.
+ * Returns FALSE, without writing anything, if the statement would not fit in
+ * memory.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ * @param index The index of the statement.
+ * @return TRUE if the statement has been written, FALSE otherwise.
+ */
+Boolean generateStatement(Generator *generator, unsigned long index);
+
+/**
+ * Writes a valid instruction with random operands, without a newline.
+ * Returns the number of words the instruction takes in memory.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ * @param line The buffer to write the instruction to.
+ * @return The number of words the instruction takes.
+ */
+unsigned long generateInstruction(Generator *generator, char line[]);
+
+/**
+ * Writes a random operand of an addressing mode that the given operation
+ * accepts, weighted by the mode weights.
+ * Returns the chosen addressing mode.
+ *
+ * Assumes that the given generator has been initialized.
+ * Assumes that the given operation accepts at least one addressing mode in the
+ * given position.
+ *
+ * @param generator The generator.
+ * @param operation The index of the operation.
+ * @param isSource Whether the operand is the source operand.
+ * @param operand The buffer to write the operand to.
+ * @return The addressing mode of the operand.
+ */
+OperandType generateOperand(Generator *generator, Index operation,
+                            Boolean isSource, char operand[]);
+
+/**
+ * Writes the name of a random label that is used as a direct operand: either
+ * an extern label or one that will be defined.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ * @param name The buffer to write the name to.
+ */
+void generateLabelName(Generator *generator, char name[]);
+
+/**
+ * Returns the number of label names that can be used as a direct operand: the
+ * extern labels, the labels defined so far and a few that will be defined
+ * soon (so that labels are also used before their definitions).
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ * @return The number of label names that can be used.
+ */
+unsigned long countLabelNames(Generator *generator);
+
+/**
+ * Writes a random .data or .string directive, without a newline.
+ * Returns the number of words the directive takes in memory.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ * @param line The buffer to write the directive to.
+ * @return The number of words the directive takes.
+ */
+unsigned long generateData(Generator *generator, char line[]);
+
+/**
+ * Writes a random invalid line, without a newline.
+ * The line is never too long, so that the errors of the other lines are still
+ * found.
+ *
+ * Assumes that the given generator has been initialized.
+ *
+ * @param generator The generator.
+ * @param line The buffer to write the line to.
+ */
+void generateInvalid(Generator *generator, char line[]);
+
+/**
+ * Writes a .string directive that is longer than the maximum line length,
+ * without a newline.
+ *
+ * Assumes that the given buffer has room for the line.
+ *
+ * @param line The buffer to write the line to.
+ */
+void generateTooLong(char line[]);
+
+/**
+ * Returns the number of words an instruction with the given operands takes in
+ * memory.
+ * If both operands are registers, they share a single word.
+ *
+ * @param operandCount The number of operands.
+ * @param source The addressing mode of the source operand.
+ * @param destination The addressing mode of the destination operand.
+ * @return The number of words the instruction takes.
+ */
+unsigned long countInstructionWords(OperandCount operandCount,
+                                    OperandType source,
+                                    OperandType destination);
+
+/**
+ * Returns the next random number (32 bits) of the given generator, using
+ * xorshift, so that the numbers are the same on every platform.
+ *
+ * Assumes that the given generator pointer is not NULL.
+ *
+ * @param generator The generator.
+ * @return The next random number.
+ */
+unsigned long nextRandom(Generator *generator);
+
+/**
+ * Returns a random number that is smaller than the given bound.
+ *
+ * Assumes that the given generator pointer is not NULL.
+ * Assumes that the given bound is not zero.
+ *
+ * @param generator The generator.
+ * @param bound The bound (exclusive).
+ * @return A random number between 0 and bound - 1.
+ */
+unsigned long randomBelow(Generator *generator, unsigned long bound);
+
+/**
+ * Returns TRUE with the given chance, in percent.
+ *
+ * Assumes that the given generator pointer is not NULL.
+ *
+ * @param generator The generator.
+ * @param percent The chance of returning TRUE.
+ * @return TRUE or FALSE, at random.
+ */
+Boolean randomChance(Generator *generator, unsigned long percent);
+
+/**
+ * Converts the given value of a knob to a whole number.
+ * Returns FALSE if the value is empty or is not a whole number.
+ *
+ * Assumes that the given value is not NULL and is null-terminated.
+ * Assumes that the given number pointer is not NULL.
+ *
+ * @param value The value to convert.
+ * @param number The converted number.
+ * @return TRUE if the value is a whole number, FALSE otherwise.
+ */
+Boolean convertKnob(char value[], unsigned long *number);
+
+#endif
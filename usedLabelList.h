@@ -16,50 +16,21 @@
 
 /**
  * Adds a new used label to the given list of used labels with the given name,
- * address, line number and word pointer.
- * IMPORTANT: The caller must free the new used label.
+ * address, line number and word index.
+ * IMPORTANT: The new used label comes from the current file's arena, so it
+ * must not be freed.
  *
  * Assumes that the given pointer to the labels is not NULL.
  * Assumes that the given label name is not NULL and is null-terminated.
- * Assumes that the given word pointer is not NULL, and points to a word in the
- * code part or in the data part.
+ * Assumes that the given word index is the index of a word in the code image.
  *
  * @param labels The list of used labels.
  * @param labelName The new used label's name.
  * @param address The new used label's word address.
  * @param lineNumber The new used label's line number.
- * @param wordPointer The new used label's word pointer.
+ * @param wordIndex The new used label's word index.
  */
 void addUsedLabel(UsedLabel **labels, char labelName[], Address address,
-                  LineNumber lineNumber, Word *wordPointer);
-
-/**
- * Checks if the given list of used labels contains the given label name.
- *
- * Assumes that the given label name is not NULL and is null-terminated.
- *
- * @param labels The list of used labels.
- * @param labelName The label name to search for.
- * @return TRUE if the label is in the list, FALSE otherwise.
- */
-Boolean containsUsedLabel(UsedLabel *labels, char labelName[]);
-
-/**
- * Frees a used label list.
- *
- * Assumes that the given labels have not been freed yet.
- *
- * @param labels The used label list to free.
- */
-void freeUsedLabelList(UsedLabel *labels);
-
-/**
- * Frees a single used label.
- *
- * Assumes that the given label is not NULL and has not been freed yet.
- *
- * @param label The used label to free.
- */
-void freeUsedLabel(UsedLabel *label);
+                  LineNumber lineNumber, WordCount wordIndex);
 
 #endif
@@ -16,13 +16,41 @@
 
 #include <ctype.h>  /* isdigit and isspace. */
 #include <stdio.h>  /* fopen, sprintf. */
-#include <stdlib.h> /* malloc, free, exit. */
-#include <string.h> /* strlen, strcpy, strncpy. */
+#include <stdlib.h> /* malloc, exit. */
+#include <string.h> /* strlen, strcpy, strncmp, memcpy. */
 
+#include "arena.h"         /* Allocating memory from an arena. */
 #include "errorHandling.h" /* Printing errors. */
-#include "freeingLogic.h"  /* Freeing memory. */
+#include "freeingLogic.h"  /* Freeing memory and getting the file's arena. */
 #include "globals.h"       /* Constants and typedefs. */
 
+/*
+ * The class of every character, so that a single lookup tells whitespace,
+ * commas and the end of the line apart. The whitespace characters are the ones
+ * isspace accepts in the C locale, and characters after the comma are all
+ * others (the rest of the table is filled with zeros).
+ */
+static Mask CHARACTER_CLASSES[CHARACTER_COUNT] = {
+    /* The null character to the backspace character. */
+    TERMINATOR_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    /* '\t', '\n', '\v', '\f' and '\r'. */
+    WHITESPACE_CLASS, WHITESPACE_CLASS, WHITESPACE_CLASS, WHITESPACE_CLASS,
+    WHITESPACE_CLASS,
+    /* The control characters after them. */
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    /* ' '. */
+    WHITESPACE_CLASS,
+    /* '!' to '+'. */
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS, OTHER_CLASS,
+    OTHER_CLASS,
+    /* ','. */
+    COMMA_CLASS};
+
 void *allocate(size_t size) {
     void *allocatedPointer; /* The pointer to the allocated memory. */
 
@@ -43,6 +71,11 @@ void *allocate(size_t size) {
     return allocatedPointer;
 }
 
+void *allocateForFile(size_t size) {
+    /* Allocate from the arena of the file that the current thread compiles. */
+    return allocateFromArena(getFileArena(), size);
+}
+
 FILE *openFile(char fileName[], char extension[], char mode[]) {
     char *fileNameWithExtension; /* The full file name with the extension. */
     FILE *file;                  /* The pointer to the opened file. */
@@ -58,15 +91,18 @@ FILE *openFile(char fileName[], char extension[], char mode[]) {
         printFileError(fileNameWithExtension);
     }
 
-    /* Free the no longer needed full file name. */
-    free(fileNameWithExtension);
     /* Return the pointer to the opened file. */
     return file;
 }
 
+Mask getCharacterClass(char character) {
+    /* Look the character up (as unsigned, like isspace does). */
+    return CHARACTER_CLASSES[(unsigned char)character];
+}
+
 char *skipWhitespace(char line[]) {
     /* Skip all whitespace characters and commas. */
-    while (isspace(*line) || *line == ',') {
+    while (CHARACTER_CLASSES[(unsigned char)*line] & SEPARATOR_CLASSES) {
         line++;
     }
 
@@ -76,7 +112,7 @@ char *skipWhitespace(char line[]) {
 
 char *skipCharacters(char line[]) {
     /* Skip all non-whitespace characters that are also not commas. */
-    while (*line != '\0' && !isspace(*line) && *line != ',') {
+    while (!(CHARACTER_CLASSES[(unsigned char)*line] & TOKEN_END_CLASSES)) {
         line++;
     }
 
@@ -84,39 +120,28 @@ char *skipCharacters(char line[]) {
     return line;
 }
 
-char *getNextToken(char line[]) {
-    size_t size; /* The size of the token. */
-    char *token; /* The token to extract. */
+TokenSlice getTokenSlice(char line[]) {
+    TokenSlice token; /* The token at the start of the line. */
 
-    /* Compute the size of the token. */
-    size = skipCharacters(line) - line;
-
-    /* Check for an empty token. */
-    if (size == EMPTY) {
-        return NULL;
-    }
+    /* The token spans the characters up to the next whitespace or comma. */
+    token.start = line;
+    token.length = (Length)(skipCharacters(line) - line);
 
-    /* Allocate enough memory for the token. */
-    token = allocate(sizeof(char) * (size + NULL_BYTE));
-    /* Copy the token from the line. */
-    strncpy(token, line, size);
-    /* Terminate the token with a null character. */
-    token[size] = '\0';
-    /* Return the desired token. */
+    /* Return the token, which still points into the line. */
     return token;
 }
 
-void removeEnding(char string[], char ending) {
-    Length length; /* The length of the given string. */
-
-    /* Compute the given string's length. */
-    length = (Length)strlen(string);
+Boolean compareTokenSlice(TokenSlice token, char string[]) {
+    /* The string must match the token and end right where the token ends. */
+    return strncmp(token.start, string, token.length) == EQUAL_STRINGS &&
+           string[token.length] == '\0';
+}
 
-    /* Check if the last character is the ending to remove. */
-    if (string[length - LAST_INDEX_DIFF] == ending) {
-        /* Remove the ending by replacing it with a null character. */
-        string[length - LAST_INDEX_DIFF] = '\0';
-    }
+void copyTokenSlice(char destination[], TokenSlice token) {
+    /* Copy the token's characters. */
+    memcpy(destination, token.start, token.length);
+    /* Terminate the copy with a null character. */
+    destination[token.length] = '\0';
 }
 
 Length getStringLength(char string[]) {
@@ -159,14 +184,9 @@ Boolean checkStringEnding(char string[]) {
     return FALSE;
 }
 
-Boolean checkIfLabel(char token[]) {
-    /* Check the last character of the token for a colon character. */
-    return token[strlen(token) - LAST_INDEX_DIFF] == ':';
-}
-
 Boolean checkIfFollowedByComma(char line[]) {
     /* Skip all whitespace characters. */
-    while (isspace(*line)) {
+    while (CHARACTER_CLASSES[(unsigned char)*line] & WHITESPACE_CLASS) {
         line++;
     }
 
@@ -174,16 +194,6 @@ Boolean checkIfFollowedByComma(char line[]) {
     return *line == ',';
 }
 
-Boolean checkForConsecutiveCommas(char line[]) {
-    /* Skip all whitespace characters. */
-    while (isspace(*line)) {
-        line++;
-    }
-
-    /* Check for a comma and then for another one. */
-    return *line == ',' && checkIfFollowedByComma(&line[SECOND_INDEX]);
-}
-
 char *addExtension(char fileName[], char extension[]) {
     size_t fileNameLength;  /* The length of the given file name. */
     size_t extensionLength; /* The length of the given extension. */
@@ -194,8 +204,8 @@ char *addExtension(char fileName[], char extension[]) {
     extensionLength = strlen(extension);
 
     /* Allocate enough memory for the combined name (with a dot). */
-    name = allocate(sizeof(char) *
-                    (fileNameLength + DOT_BYTE + extensionLength + NULL_BYTE));
+    name = allocateForFile(sizeof(char) * (fileNameLength + DOT_BYTE +
+                                           extensionLength + NULL_BYTE));
 
     /* Copy the file name to the combined name. */
     strcpy(name, fileName);
@@ -210,6 +220,45 @@ char *addExtension(char fileName[], char extension[]) {
     return name;
 }
 
+char *copyString(char string[]) {
+    char *copy; /* The copy of the string. */
+
+    /* Allocate enough memory for the copy. */
+    copy = allocate(sizeof(char) * (strlen(string) + NULL_BYTE));
+    /* Copy the string, including the null character. */
+    strcpy(copy, string);
+
+    /* Return the copy. */
+    return copy;
+}
+
+char *copyStringForFile(char string[]) {
+    char *copy; /* The copy of the string. */
+
+    /* Allocate enough memory for the copy, from the file's arena. */
+    copy = allocateForFile(sizeof(char) * (strlen(string) + NULL_BYTE));
+    /* Copy the string, including the null character. */
+    strcpy(copy, string);
+
+    /* Return the copy. */
+    return copy;
+}
+
+unsigned long hashString(char string[]) {
+    unsigned long hash; /* The hash so far. */
+
+    hash = HASH_OFFSET_BASIS;
+
+    /* Mix each character into the hash. */
+    while (*string != '\0') {
+        hash = (hash ^ (unsigned char)*string) * HASH_PRIME;
+        string++;
+    }
+
+    /* Return the final hash. */
+    return hash;
+}
+
 unsigned char convertDigitToNumber(char digit) {
     /* Check if the character is a digit. */
     if (isdigit(digit)) {
@@ -19,8 +19,8 @@
 /**
  * Tries to allocate memory of the given size on the heap.
  * If succeeds, returns the pointer to the allocated memory.
- * If fails, prints an error message, frees all memory used by the linked lists
- * and exits.
+ * If fails, prints an error message, frees all memory used by the current
+ * file and exits.
  * NOTE: Does not initialize the allocated memory.
  * IMPORTANT: The caller must free the returned memory.
  *
@@ -31,6 +31,19 @@
  */
 void *allocate(size_t size);
 
+/**
+ * Allocates memory of the given size from the arena of the file that the
+ * calling thread compiles.
+ * The memory lives until the file is done, and is then taken back together with
+ * the rest of the file's memory.
+ * NOTE: Does not initialize the allocated memory.
+ * IMPORTANT: The returned memory must not be freed.
+ *
+ * @param size The size of the memory to allocate in bytes.
+ * @return A pointer to the allocated memory.
+ */
+void *allocateForFile(size_t size);
+
 /**
  * Tries to open a file with the given name and extension in the given mode.
  * If succeeds, returns the pointer to the opened file.
@@ -51,6 +64,15 @@ void *allocate(size_t size);
  */
 FILE *openFile(char fileName[], char extension[], char mode[]);
 
+/**
+ * Returns the class of the given character: whitespace (the characters isspace
+ * accepts), a comma, the null character or any other character.
+ *
+ * @param character The character to classify.
+ * @return The class of the character.
+ */
+Mask getCharacterClass(char character);
+
 /**
  * Skips all whitespace characters and commas in the given line.
  * Returns a pointer to the first non-whitespace character that is also not a
@@ -85,35 +107,47 @@ char *skipWhitespace(char line[]);
 char *skipCharacters(char line[]);
 
 /**
- * Returns a pointer to a newly allocated string containing the next token in
- * the given line.
- * Stops the token at the first whitespace character or comma.
- * If the first character in the given line is whitespace or a comma, returns
- * NULL.
- * Allocates a new string and copies the token into it.
- * IMPORTANT: The caller must free the returned string.
+ * Returns the token at the start of the given line, without copying it.
+ * The token stops at the first whitespace character or comma.
+ * If the first character in the given line is whitespace, a comma or a null
+ * character, the returned token is empty (its length is 0).
+ * IMPORTANT: The token points into the given line, which must outlive it.
  *
  * Assumes that the given line is not NULL and is null-terminated.
  *
- * @param line The line to get the next token from.
- * @return A pointer to a newly allocated string containing the next token in
- * the given line.
+ * @param line The line to get the token from.
+ * @return The token at the start of the given line.
  */
-char *getNextToken(char line[]);
+TokenSlice getTokenSlice(char line[]);
 
 /**
- * Removes the given ending from the given string.
- * Checks the last character in the string and determines if it is the desired
- * ending.
- * If so, removes it by replacing it with a null character.
- * If not, does not modify the string at all.
+ * Checks and returns if the given token consists of exactly the characters of
+ * the given string.
  *
+ * Assumes that the given token points to at least as many characters as its
+ * length.
  * Assumes that the given string is not NULL and is null-terminated.
  *
- * @param string The string to remove the ending from.
- * @param ending The ending to remove.
+ * @param token The token to compare.
+ * @param string The string to compare the token to.
+ * @return TRUE if the token and the string are equal, FALSE otherwise.
  */
-void removeEnding(char string[], char ending);
+Boolean compareTokenSlice(TokenSlice token, char string[]);
+
+/**
+ * Copies the given token into the given destination and terminates it with a
+ * null character.
+ * Does not allocate any memory.
+ *
+ * Assumes that the given destination has room for the token's length plus a
+ * null character.
+ * Assumes that the given token points to at least as many characters as its
+ * length.
+ *
+ * @param destination The buffer to copy the token into.
+ * @param token The token to copy.
+ */
+void copyTokenSlice(char destination[], TokenSlice token);
 
 /**
  * Returns the length of the given string operand that was set in a .string
@@ -143,18 +177,6 @@ Length getStringLength(char string[]);
  */
 Boolean checkStringEnding(char string[]);
 
-/**
- * Checks and returns if the given token is a potential label.
- * A token is a potential label if its last character is a colon.
- * Does not modify the given token.
- *
- * Assumes that the given token is not NULL and is null-terminated.
- *
- * @param token The token to check.
- * @return TRUE if the token is a potential label, FALSE otherwise.
- */
-Boolean checkIfLabel(char token[]);
-
 /**
  * Checks and returns if there is a comma before any non-whitespace character in
  * the given line.
@@ -168,24 +190,11 @@ Boolean checkIfLabel(char token[]);
  */
 Boolean checkIfFollowedByComma(char line[]);
 
-/**
- * Checks and returns if there are multiple consecutive commas before any other
- * non-whitespace character in the given line.
- * Does not modify the given line.
- *
- * Assumes that the given line is not NULL and is null-terminated.
- *
- * @param line The line to check.
- * @return TRUE if there are multiple consecutive commas before any other
- * non-whitespace character in the given line, FALSE otherwise.
- */
-Boolean checkForConsecutiveCommas(char line[]);
-
 /**
  * Adds the given extension to the given file name.
- * Returns a pointer to a newly-allocated string that is
- * "<fileName>.<extension>".
- * IMPORTANT: The caller must free the returned string.
+ * Returns a pointer to a string that is "<fileName>.<extension>", allocated
+ * from the current file's arena.
+ * IMPORTANT: The returned string must not be freed.
  *
  * Assumes that the given file name is not NULL and is null-terminated.
  * Assumes that the given extension is not NULL and is null-terminated.
@@ -196,6 +205,40 @@ Boolean checkForConsecutiveCommas(char line[]);
  */
 char *addExtension(char fileName[], char extension[]);
 
+/**
+ * Returns a pointer to a newly allocated copy of the given string.
+ * IMPORTANT: The caller must free the returned string.
+ *
+ * Assumes that the given string is not NULL and is null-terminated.
+ *
+ * @param string The string to copy.
+ * @return A pointer to a copy of the given string.
+ */
+char *copyString(char string[]);
+
+/**
+ * Returns a pointer to a copy of the given string, allocated from the current
+ * file's arena.
+ * IMPORTANT: The returned string must not be freed.
+ *
+ * Assumes that the given string is not NULL and is null-terminated.
+ *
+ * @param string The string to copy.
+ * @return A pointer to a copy of the given string.
+ */
+char *copyStringForFile(char string[]);
+
+/**
+ * Computes and returns the FNV-1a hash of the given string.
+ * Used to find names in hash tables.
+ *
+ * Assumes that the given string is not NULL and is null-terminated.
+ *
+ * @param string The string to hash.
+ * @return The hash of the given string.
+ */
+unsigned long hashString(char string[]);
+
 /**
  * Converts the given digit character to its corresponding number and returns
  * it.
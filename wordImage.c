@@ -0,0 +1,46 @@
+/*
+ * wordImage.c
+ *
+ * Contains functions to interface with a word image.
+ * The 2 word images contain all the words in the code part and in the data
+ * part of the .am file, one after another in memory.
+ * They will eventually be used to generate the .ob file.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "wordImage.h"
+
+#include "globals.h" /* Constants and typedefs. */
+
+void initWordImage(WordImage *image) {
+    /* The image starts with no words. */
+    image->count = EMPTY;
+}
+
+Word *addWord(WordImage *image) {
+    Word *newWord; /* The new word. */
+
+    /* Check if there is still room in the image. */
+    if (image->count < TOTAL_MEMORY_CELLS) {
+        /* Take the next word. */
+        newWord = &image->words[image->count];
+        image->count++;
+    } else {
+        /* The memory has overflowed, so reuse the scratch word. */
+        newWord = &image->words[TOTAL_MEMORY_CELLS];
+    }
+
+    /* Initialize the new word to zeros. */
+    *newWord = INITIAL_VALUE;
+
+    return newWord;
+}
+
+WordCount getWordIndex(WordImage *image, Word *word) {
+    /* The index is the word's distance from the first word. */
+    return (WordCount)(word - image->words);
+}
@@ -0,0 +1,52 @@
+/*
+ * wordImage.h
+ *
+ * Contains the function prototypes for the functions in wordImage.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef WORD_IMAGE_H
+#define WORD_IMAGE_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Initializes the given word image to contain no words.
+ *
+ * Assumes that the given word image pointer is not NULL.
+ *
+ * @param image The word image to initialize.
+ */
+void initWordImage(WordImage *image);
+
+/**
+ * Adds a new word, initialized to zeros, to the end of the given word image.
+ * Returns a pointer to the new word.
+ * If the image is full, returns the image's scratch word instead, which is not
+ * counted and is never written to the .ob file.
+ *
+ * Assumes that the given word image pointer is not NULL.
+ *
+ * @param image The word image to add the new word to.
+ * @return A pointer to the new word.
+ */
+Word *addWord(WordImage *image);
+
+/**
+ * Returns the index of the given word in the given word image.
+ *
+ * Assumes that the given word image pointer is not NULL.
+ * Assumes that the given word is one of the image's words (or its scratch
+ * word).
+ *
+ * @param image The word image that contains the word.
+ * @param word The word to get the index of.
+ * @return The index of the word in the image.
+ */
+WordCount getWordIndex(WordImage *image, Word *word);
+
+#endif
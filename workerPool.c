@@ -0,0 +1,151 @@
+/*
+ * workerPool.c
+ *
+ * Contains functions to compile the provided files on a pool of worker
+ * threads, for when more than one job is requested with the -j option.
+ * Every file is still compiled separately, so the generated files and the exit
+ * status are the same as when the files are compiled one after another.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#include "workerPool.h"
+
+#include <pthread.h> /* pthread_create, pthread_join, mutexes and conditions. */
+#include <stdlib.h>  /* free. */
+
+#include "arena.h"         /* Keeping a separate arena for each worker. */
+#include "errorHandling.h" /* Storing and printing the messages of each file. */
+#include "fileHandling.h"  /* Compiling a single file. */
+#include "freeingLogic.h"  /* Keeping separate memory to free for each worker. */
+#include "globals.h"       /* Constants and typedefs. */
+#include "utils.h"         /* Allocating memory. */
+
+void compileFilesInParallel(char *fileNames[], int fileCount,
+                            Options *options, FileReport reports[]) {
+    WorkQueue workQueue;      /* The work queue shared by all the workers. */
+    pthread_t *workers;       /* The worker threads. */
+    unsigned int workerCount; /* The number of workers that were started. */
+    unsigned int index;       /* The index of the current worker. */
+    int fileIndex;            /* The index of the current file. */
+
+    /* Initialize the work queue. */
+    workQueue.fileNames = fileNames;
+    workQueue.fileCount = fileCount;
+    workQueue.nextFile = INITIAL_VALUE;
+    workQueue.options = options;
+    workQueue.reports = reports;
+    workQueue.messages = allocate(sizeof(MessageQueue) * fileCount);
+    workQueue.isDone = allocate(sizeof(Boolean) * fileCount);
+    pthread_mutex_init(&workQueue.lock, NULL);
+    pthread_cond_init(&workQueue.fileDone, NULL);
+
+    /* Every file starts with no messages and is not done. */
+    for (fileIndex = INITIAL_VALUE; fileIndex < fileCount; fileIndex++) {
+        workQueue.messages[fileIndex].first = NULL;
+        workQueue.messages[fileIndex].last = NULL;
+        workQueue.isDone[fileIndex] = FALSE;
+    }
+
+    /* There is no need for more workers than files. */
+    workerCount = options->jobCount < (unsigned int)fileCount
+                      ? options->jobCount
+                      : (unsigned int)fileCount;
+    workers = allocate(sizeof(pthread_t) * workerCount);
+
+    /* Start the workers. */
+    for (index = INITIAL_VALUE; index < workerCount; index++) {
+        /* Stop starting workers if the system does not allow more. */
+        if (pthread_create(&workers[index], NULL, runWorker, &workQueue) !=
+            SUCCESS) {
+            break;
+        }
+    }
+    workerCount = index;
+
+    /* Check if no worker could be started. */
+    if (workerCount == EMPTY) {
+        /* Compile the files one after another instead. */
+        compileFiles(fileNames, fileCount, options, reports);
+    } else {
+        /* Print the messages of each file in order, once it is done. */
+        for (fileIndex = INITIAL_VALUE; fileIndex < fileCount; fileIndex++) {
+            waitForFile(&workQueue, fileIndex);
+        }
+
+        /* Wait for all the workers to finish. */
+        for (index = INITIAL_VALUE; index < workerCount; index++) {
+            pthread_join(workers[index], NULL);
+        }
+    }
+
+    /* The work queue is no longer needed. */
+    pthread_cond_destroy(&workQueue.fileDone);
+    pthread_mutex_destroy(&workQueue.lock);
+    free(workers);
+    free(workQueue.isDone);
+    free(workQueue.messages);
+}
+
+void *runWorker(void *workQueue) {
+    WorkQueue *queue; /* The work queue shared by all the workers. */
+    ToFree toFree;    /* The memory to free of this worker. */
+    int index;        /* The index of the current file. */
+
+    queue = workQueue;
+
+    /* Keep a separate arena, as the lists belong to this worker. */
+    initArena(&toFree.arena);
+    registerToFree(&toFree);
+
+    /* Compile files until there are no more files. */
+    for (index = takeNextFile(queue); index < queue->fileCount;
+         index = takeNextFile(queue)) {
+        /* Store the messages, as earlier files might still be compiling. */
+        queueMessages(&queue->messages[index]);
+        /* Compile the file with the lists of this worker. */
+        compileFiles(&queue->fileNames[index], SINGLE_FILE, queue->options,
+                     queue->reports == NULL ? NULL : &queue->reports[index]);
+        queueMessages(NULL);
+
+        /* Mark the file as done. */
+        pthread_mutex_lock(&queue->lock);
+        queue->isDone[index] = TRUE;
+        pthread_cond_broadcast(&queue->fileDone);
+        pthread_mutex_unlock(&queue->lock);
+    }
+
+    /* The blocks kept for the next files are no longer needed. */
+    freeArena(&toFree.arena);
+
+    return NULL;
+}
+
+int takeNextFile(WorkQueue *workQueue) {
+    int index; /* The index of the next file. */
+
+    /* Take the next file, so that no other worker will take it. */
+    pthread_mutex_lock(&workQueue->lock);
+    index = workQueue->nextFile;
+    if (index < workQueue->fileCount) {
+        workQueue->nextFile++;
+    }
+    pthread_mutex_unlock(&workQueue->lock);
+
+    return index;
+}
+
+void waitForFile(WorkQueue *workQueue, int index) {
+    /* Wait until the file is done. */
+    pthread_mutex_lock(&workQueue->lock);
+    while (!workQueue->isDone[index]) {
+        pthread_cond_wait(&workQueue->fileDone, &workQueue->lock);
+    }
+    pthread_mutex_unlock(&workQueue->lock);
+
+    /* Print the file's messages, after the messages of the earlier files. */
+    flushMessages(&workQueue->messages[index]);
+}
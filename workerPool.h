@@ -0,0 +1,79 @@
+/*
+ * workerPool.h
+ *
+ * Contains the function prototypes for the functions in workerPool.c.
+ *
+ * Name: Ariel Keren
+ * Course: C Lab, 20465
+ * Semester: 2024B
+ * Date: 30/07/2024
+ */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include "globals.h" /* Typedefs. */
+
+/**
+ * Compiles the provided files on a pool of worker threads, at most the given
+ * number of jobs at the same time.
+ * Each worker takes the next file that has not been taken yet and compiles it
+ * with its own lists.
+ * The messages of each file are printed in the order of the files, exactly as
+ * if the files were compiled one after another.
+ * If no worker could be started, compiles the files one after another.
+ *
+ * Assumes that the given file names array is not NULL and contains only
+ * non-NULL and null-terminated file names.
+ * Assumes that the given file count is the number of file names to try to
+ * compile from the given file names array.
+ * Assumes that the given options pointer is not NULL.
+ *
+ * @param fileNames The names of the files to compile.
+ * @param fileCount The number of files to compile.
+ * @param options The options given as command line arguments.
+ * @param reports The time report of each file, in the same order (NULL if the
+ * time is not reported).
+ */
+void compileFilesInParallel(char *fileNames[], int fileCount,
+                            Options *options, FileReport reports[]);
+
+/**
+ * The function that each worker thread runs.
+ * Keeps taking the next file from the given work queue and compiling it, until
+ * there are no more files.
+ * Stores the messages of each file in the file's queue and marks the file as
+ * done once it has been compiled.
+ *
+ * Assumes that the given argument points to a valid work queue.
+ *
+ * @param workQueue The work queue (WorkQueue *) shared by all the workers.
+ * @return NULL.
+ */
+void *runWorker(void *workQueue);
+
+/**
+ * Takes the index of the next file to compile from the given work queue.
+ * Returns the index, or the file count if there are no more files.
+ *
+ * Assumes that the given work queue is not NULL.
+ *
+ * @param workQueue The work queue to take the file from.
+ * @return The index of the next file to compile, or the file count if there are
+ * no more files.
+ */
+int takeNextFile(WorkQueue *workQueue);
+
+/**
+ * Waits until the file at the given index has been compiled, and then prints
+ * its messages.
+ *
+ * Assumes that the given work queue is not NULL.
+ * Assumes that the given index is a valid index of a file in the work queue.
+ *
+ * @param workQueue The work queue that the file is in.
+ * @param index The index of the file.
+ */
+void waitForFile(WorkQueue *workQueue, int index);
+
+#endif